@@ -0,0 +1,110 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.Config;
+import com.tidesdb.LogLevel;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import com.tidesdb.Transaction;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Comparator;
+import java.util.stream.Stream;
+
+/**
+ * Shared setup for the benchmarks: a fresh database in a temporary directory and
+ * fixed-width keys.
+ */
+final class BenchmarkSupport {
+
+    private BenchmarkSupport() {
+    }
+
+    static Path newDbDir(String name) {
+        try {
+            return Files.createTempDirectory("tidesdb-bench-" + name);
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+
+    static TidesDB open(Path dir) throws TidesDBException {
+        Config config = Config.builder(dir.resolve("db").toString())
+            .numFlushThreads(2)
+            .numCompactionThreads(2)
+            .logLevel(LogLevel.ERROR)
+            .blockCacheSize(256L * 1024 * 1024)
+            .maxOpenSSTables(256)
+            .build();
+        return TidesDB.open(config);
+    }
+
+    static ColumnFamily createColumnFamily(TidesDB db, String name, ColumnFamilyConfig config)
+            throws TidesDBException {
+        db.createColumnFamily(name, config);
+        return db.getColumnFamily(name);
+    }
+
+    /**
+     * Returns a 16-byte big-endian key, so numeric order matches the default comparator.
+     */
+    static byte[] key(long i) {
+        return ByteBuffer.allocate(16).putLong(0L).putLong(i).array();
+    }
+
+    static byte[] value(int size) {
+        byte[] value = new byte[size];
+        for (int i = 0; i < size; i++) {
+            value[i] = (byte) (i * 31);
+        }
+        return value;
+    }
+
+    /**
+     * Loads {@code count} keys in batches of 1000 per transaction.
+     */
+    static void load(TidesDB db, ColumnFamily cf, int count, byte[] value) throws TidesDBException {
+        for (int start = 0; start < count; start += 1000) {
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = start; i < Math.min(count, start + 1000); i++) {
+                    txn.put(cf, key(i), value);
+                }
+                txn.commit();
+            }
+        }
+    }
+
+    static void deleteRecursively(Path dir) {
+        if (dir == null || !Files.exists(dir)) {
+            return;
+        }
+        try (Stream<Path> paths = Files.walk(dir)) {
+            paths.sorted(Comparator.reverseOrder()).forEach(p -> p.toFile().delete());
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import com.tidesdb.Transaction;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Commit cost with no hook and with a no-op Java commit hook, isolating the upcall
+ * overhead: thread attach, CommitOp array construction and the callback itself.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class CommitHookBenchmark {
+
+    @Param({"none", "noop"})
+    public String hook;
+
+    @Param({"1", "16"})
+    public int opsPerTxn;
+
+    private Path dir;
+    private TidesDB db;
+    private ColumnFamily cf;
+    private byte[] value;
+    private long next;
+
+    @Setup(Level.Trial)
+    public void setup() throws TidesDBException {
+        dir = BenchmarkSupport.newDbDir("hook");
+        db = BenchmarkSupport.open(dir);
+        cf = BenchmarkSupport.createColumnFamily(db, "bench", ColumnFamilyConfig.defaultConfig());
+        if ("noop".equals(hook)) {
+            cf.setCommitHook((ops, commitSeq) -> 0);
+        }
+        value = BenchmarkSupport.value(100);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() throws TidesDBException {
+        if ("noop".equals(hook)) {
+            cf.clearCommitHook();
+        }
+        db.close();
+        BenchmarkSupport.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public void commit() throws TidesDBException {
+        try (Transaction txn = db.beginTransaction()) {
+            for (int i = 0; i < opsPerTxn; i++) {
+                txn.put(cf, BenchmarkSupport.key(next++), value);
+            }
+            txn.commit();
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.IsolationLevel;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import com.tidesdb.Transaction;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Read-modify-write transactions from several threads over a small hot key set. Conflicts
+ * are counted rather than retried, and reported as the {@code conflicts} and
+ * {@code committed} secondary results.
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@Threads(8)
+public class ContentionBenchmark {
+
+    @Param({"READ_COMMITTED", "REPEATABLE_READ", "SNAPSHOT", "SERIALIZABLE"})
+    public IsolationLevel isolation;
+
+    @Param({"1024"})
+    public int hotKeys;
+
+    private Path dir;
+    private TidesDB db;
+    private ColumnFamily cf;
+
+    @AuxCounters(AuxCounters.Type.EVENTS)
+    @State(Scope.Thread)
+    public static class Outcomes {
+        public long committed;
+        public long conflicts;
+
+        @Setup(Level.Iteration)
+        public void reset() {
+            committed = 0;
+            conflicts = 0;
+        }
+    }
+
+    @Setup(Level.Trial)
+    public void setup() throws TidesDBException {
+        dir = BenchmarkSupport.newDbDir("contention");
+        db = BenchmarkSupport.open(dir);
+        cf = BenchmarkSupport.createColumnFamily(db, "bench", ColumnFamilyConfig.defaultConfig());
+        BenchmarkSupport.load(db, cf, hotKeys, BenchmarkSupport.value(8));
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        db.close();
+        BenchmarkSupport.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public void readModifyWrite(Outcomes outcomes) throws TidesDBException {
+        byte[] key = BenchmarkSupport.key(ThreadLocalRandom.current().nextInt(hotKeys));
+        try (Transaction txn = db.beginTransaction(isolation)) {
+            byte[] current = txn.get(cf, key);
+            current[0]++;
+            txn.put(cf, key, current);
+            txn.commit();
+            outcomes.committed++;
+        } catch (TidesDBException e) {
+            if (e.getErrorCode() != TidesDBException.ERR_CONFLICT) {
+                throw e;
+            }
+            outcomes.conflicts++;
+        }
+    }
+}
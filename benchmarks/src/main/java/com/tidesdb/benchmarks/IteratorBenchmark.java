@@ -0,0 +1,112 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.KeyValue;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import com.tidesdb.TidesDBIterator;
+import com.tidesdb.Transaction;
+import org.openjdk.jmh.annotations.*;
+import org.openjdk.jmh.infra.Blackhole;
+
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Full column family scans. Each invocation visits every entry, so the score is the cost of
+ * one scan; divide by {@code entries} for the per-row cost of each access pattern.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class IteratorBenchmark {
+
+    @Param({"100000"})
+    public int entries;
+
+    @Param({"100"})
+    public int valueSize;
+
+    private Path dir;
+    private TidesDB db;
+    private ColumnFamily cf;
+    private Transaction txn;
+    private ByteBuffer batch;
+
+    @Setup(Level.Trial)
+    public void setup() throws TidesDBException {
+        dir = BenchmarkSupport.newDbDir("iter");
+        db = BenchmarkSupport.open(dir);
+        cf = BenchmarkSupport.createColumnFamily(db, "bench", ColumnFamilyConfig.defaultConfig());
+        BenchmarkSupport.load(db, cf, entries, BenchmarkSupport.value(valueSize));
+        cf.flushMemtable();
+        txn = db.beginTransaction();
+        batch = ByteBuffer.allocateDirect(1024 * 1024);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        txn.close();
+        db.close();
+        BenchmarkSupport.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public void nextKeyValueSeparate(Blackhole bh) throws TidesDBException {
+        try (TidesDBIterator iter = txn.newIterator(cf)) {
+            iter.seekToFirst();
+            while (iter.isValid()) {
+                bh.consume(iter.key());
+                bh.consume(iter.value());
+                iter.next();
+            }
+        }
+    }
+
+    @Benchmark
+    public void nextKeyValue(Blackhole bh) throws TidesDBException {
+        try (TidesDBIterator iter = txn.newIterator(cf)) {
+            iter.seekToFirst();
+            while (iter.isValid()) {
+                KeyValue kv = iter.keyValue();
+                bh.consume(kv);
+                iter.next();
+            }
+        }
+    }
+
+    @Benchmark
+    public void nextBatch(Blackhole bh) throws TidesDBException {
+        try (TidesDBIterator iter = txn.newIterator(cf)) {
+            iter.seekToFirst();
+            int n;
+            while ((n = iter.nextBatch(batch, Integer.MAX_VALUE, batch.capacity())) > 0) {
+                bh.consume(n);
+                bh.consume(batch.getInt(0));
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import com.tidesdb.Transaction;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Single-key put and get across value sizes. {@code get} allocates a fresh array per call;
+ * {@code getInto} copies into a reused buffer, which shows the allocation cost under
+ * {@code -prof gc}.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class PutGetBenchmark {
+
+    @Param({"16", "256", "4096", "65536", "1048576"})
+    public int valueSize;
+
+    private Path dir;
+    private TidesDB db;
+    private ColumnFamily cf;
+    private Transaction readTxn;
+    private byte[] value;
+    private byte[] dst;
+    private int keyCount;
+    private long next;
+
+    @Setup(Level.Trial)
+    public void setup() throws TidesDBException {
+        dir = BenchmarkSupport.newDbDir("putget");
+        db = BenchmarkSupport.open(dir);
+        cf = BenchmarkSupport.createColumnFamily(db, "bench", ColumnFamilyConfig.defaultConfig());
+        value = BenchmarkSupport.value(valueSize);
+        dst = new byte[valueSize];
+        // Keep the working set around 64 MB regardless of value size
+        keyCount = (int) Math.max(16, Math.min(10_000, (64L * 1024 * 1024) / valueSize));
+        BenchmarkSupport.load(db, cf, keyCount, value);
+        readTxn = db.beginTransaction();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        readTxn.close();
+        db.close();
+        BenchmarkSupport.deleteRecursively(dir);
+    }
+
+    private byte[] nextKey() {
+        return BenchmarkSupport.key(next++ % keyCount);
+    }
+
+    @Benchmark
+    public void put() throws TidesDBException {
+        try (Transaction txn = db.beginTransaction()) {
+            txn.put(cf, nextKey(), value);
+            txn.commit();
+        }
+    }
+
+    @Benchmark
+    public byte[] get() throws TidesDBException {
+        return readTxn.get(cf, nextKey());
+    }
+
+    @Benchmark
+    public int getInto() throws TidesDBException {
+        return readTxn.get(cf, nextKey(), dst, 0);
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb.benchmarks;
+
+import com.tidesdb.CacheStats;
+import com.tidesdb.ColumnFamily;
+import com.tidesdb.ColumnFamilyConfig;
+import com.tidesdb.DbStats;
+import com.tidesdb.Stats;
+import com.tidesdb.TidesDB;
+import com.tidesdb.TidesDBException;
+import org.openjdk.jmh.annotations.*;
+
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Cost of the statistics calls that monitoring code polls, each of which builds a Java
+ * object graph from native structs.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@State(Scope.Benchmark)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class StatsBenchmark {
+
+    private Path dir;
+    private TidesDB db;
+    private ColumnFamily cf;
+
+    @Setup(Level.Trial)
+    public void setup() throws TidesDBException {
+        dir = BenchmarkSupport.newDbDir("stats");
+        db = BenchmarkSupport.open(dir);
+        cf = BenchmarkSupport.createColumnFamily(db, "bench", ColumnFamilyConfig.defaultConfig());
+        BenchmarkSupport.load(db, cf, 50_000, BenchmarkSupport.value(100));
+        cf.flushMemtable();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        db.close();
+        BenchmarkSupport.deleteRecursively(dir);
+    }
+
+    @Benchmark
+    public Stats columnFamilyStats() throws TidesDBException {
+        return cf.getStats();
+    }
+
+    @Benchmark
+    public DbStats dbStats() throws TidesDBException {
+        return db.getDbStats();
+    }
+
+    @Benchmark
+    public CacheStats cacheStats() throws TidesDBException {
+        return db.getCacheStats();
+    }
+}
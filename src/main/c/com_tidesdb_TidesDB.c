@@ -17,29 +17,449 @@
  * limitations under the License.
  */
 #include <jni.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <tidesdb/db.h>
+#include <zdict.h>
+#include <zstd.h>
 
-static void throwTidesDBException(JNIEnv *env, int errorCode, const char *message)
+/*
+ * Classes and method IDs used on hot paths, resolved once in JNI_OnLoad. Class references are
+ * held as global refs so the IDs stay valid for the lifetime of the library.
+ */
+static JavaVM *g_jvm = NULL;
+
+static jclass g_exception_class = NULL;
+static jmethodID g_exception_ctor = NULL;
+
+static jclass g_string_class = NULL;
+static jclass g_byte_array_class = NULL;
+
+static jclass g_key_value_class = NULL;
+static jmethodID g_key_value_ctor = NULL;
+
+static jclass g_commit_op_class = NULL;
+static jmethodID g_commit_op_ctor = NULL;
+
+static jclass g_commit_hook_class = NULL;
+static jmethodID g_commit_hook_on_commit = NULL;
+
+static jclass g_async_commit_hooks_class = NULL;
+static jmethodID g_async_commit_hooks_deliver = NULL;
+
+static jclass g_event_listeners_class = NULL;
+static jmethodID g_event_listeners_deliver = NULL;
+
+static jclass g_cache_stats_class = NULL;
+static jmethodID g_cache_stats_ctor = NULL;
+
+static jclass g_stats_class = NULL;
+static jmethodID g_stats_ctor = NULL;
+
+static jclass g_db_stats_class = NULL;
+static jmethodID g_db_stats_ctor = NULL;
+
+static jclass g_cf_config_class = NULL;
+static jmethodID g_cf_config_from_native = NULL;
+
+static jclass g_future_class = NULL;
+static jmethodID g_future_complete = NULL;
+static jmethodID g_future_complete_exceptionally = NULL;
+
+/**
+ * Looks up a class by name and stores a global reference to it in *out.
+ * Returns 0 on success, -1 if the class could not be found.
+ */
+static int cache_class(JNIEnv *env, const char *name, jclass *out)
+{
+    jclass local = (*env)->FindClass(env, name);
+    if (local == NULL)
+    {
+        return -1;
+    }
+
+    *out = (jclass)(*env)->NewGlobalRef(env, local);
+    (*env)->DeleteLocalRef(env, local);
+    return *out != NULL ? 0 : -1;
+}
+
+/*
+ * Counters the binding keeps for itself, read through Metrics.fillBinding; slots are mirrored
+ * in Metrics.java. Updates are relaxed, so a reader sees each slot move forward but not a
+ * point-in-time snapshot across slots.
+ */
+#define METRIC_READS           0
+#define METRIC_WRITES          1
+#define METRIC_COMMITS         2
+#define METRIC_ITERATOR_STEPS  3
+#define METRIC_BYTES_IN        4
+#define METRIC_BYTES_OUT       5
+#define METRIC_EXCEPTIONS      6 /* slot METRIC_EXCEPTIONS - code per error code, +0 unknown */
+#define METRIC_EXCEPTION_CODES 14
+#define METRIC_SLOTS           (METRIC_EXCEPTIONS + METRIC_EXCEPTION_CODES)
+
+static _Atomic uint64_t g_metrics[METRIC_SLOTS];
+
+static inline void metric_add(int slot, uint64_t n)
+{
+    atomic_fetch_add_explicit(&g_metrics[slot], n, memory_order_relaxed);
+}
+
+/*
+ * Opt-in latency histograms (Config.latencyTracking). Each thread records into its own block of
+ * log-linear buckets: 8 linear buckets below 8ns, then 8 sub-buckets per power of two, which
+ * bounds the relative error to 12.5%. Blocks are pushed onto a lock-free list and never freed;
+ * a thread that exits releases its block for reuse so no counts are lost. Snapshots sum every
+ * block with relaxed loads. Bucket math is mirrored in LatencyHistogram.java.
+ *
+ * Gets are also counted per database: a database opened with tracking on claims one of
+ * LATENCY_DB_SLOTS slots and passes it with every read, so a consumer such as the compaction
+ * scheduler sees only its own database's gets. Databases beyond the last slot pass -1 and are
+ * only counted process-wide.
+ */
+#define LATENCY_PUT           0
+#define LATENCY_GET           1
+#define LATENCY_COMMIT        2
+#define LATENCY_ITERATOR_NEXT 3
+#define LATENCY_COMMIT_HOOK   4
+#define LATENCY_OPS           5
+
+#define LATENCY_SUB_BITS 3
+#define LATENCY_SUB      (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS  ((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB)
+#define LATENCY_DB_SLOTS 8
+
+typedef struct latency_block
+{
+    struct latency_block *next;
+    _Atomic int in_use;
+    _Atomic uint64_t counts[LATENCY_OPS][LATENCY_BUCKETS];
+    _Atomic uint64_t db_gets[LATENCY_DB_SLOTS][LATENCY_BUCKETS];
+} latency_block_t;
+
+static _Atomic int g_latency_enabled = 0;
+static _Atomic unsigned g_latency_db_slots = 0; /* bit per claimed slot */
+static _Atomic(latency_block_t *) g_latency_blocks = NULL;
+static pthread_key_t g_latency_key;
+static int g_latency_key_created = 0;
+static _Thread_local latency_block_t *t_latency_block = NULL;
+
+static void latency_release(void *block)
+{
+    atomic_store(&((latency_block_t *)block)->in_use, 0);
+}
+
+static latency_block_t *latency_block(void)
+{
+    latency_block_t *block = t_latency_block;
+    if (block != NULL)
+    {
+        return block;
+    }
+
+    for (block = atomic_load(&g_latency_blocks); block != NULL; block = block->next)
+    {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&block->in_use, &expected, 1))
+        {
+            break;
+        }
+    }
+
+    if (block == NULL)
+    {
+        block = (latency_block_t *)calloc(1, sizeof(latency_block_t));
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        atomic_store(&block->in_use, 1);
+        latency_block_t *head = atomic_load(&g_latency_blocks);
+        do
+        {
+            block->next = head;
+        } while (!atomic_compare_exchange_weak(&g_latency_blocks, &head, block));
+    }
+
+    pthread_setspecific(g_latency_key, block);
+    t_latency_block = block;
+    return block;
+}
+
+static inline uint64_t latency_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/** Returns a start timestamp, or 0 when tracking is off so the end call is a single branch. */
+static inline uint64_t latency_start(void)
+{
+    if (__builtin_expect(atomic_load_explicit(&g_latency_enabled, memory_order_relaxed), 0))
+    {
+        return latency_now();
+    }
+    return 0;
+}
+
+static inline int latency_bucket(uint64_t nanos)
+{
+    if (nanos < LATENCY_SUB)
+    {
+        return (int)nanos;
+    }
+    int msb = 63 - __builtin_clzll(nanos);
+    int sub = (int)(nanos >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB - 1);
+    return (msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB + sub;
+}
+
+static inline void latency_bump(_Atomic uint64_t *count)
 {
-    jclass exClass = (*env)->FindClass(env, "com/tidesdb/TidesDBException");
-    if (exClass == NULL)
+    /* only the owning thread writes a block, so no locked add is needed */
+    atomic_store_explicit(count, atomic_load_explicit(count, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+static void latency_record_slow(int op, int dbSlot, uint64_t start)
+{
+    uint64_t elapsed = latency_now() - start;
+    latency_block_t *block = latency_block();
+    if (block == NULL)
     {
         return;
     }
 
-    jmethodID constructor = (*env)->GetMethodID(env, exClass, "<init>", "(Ljava/lang/String;I)V");
-    if (constructor == NULL)
+    int bucket = latency_bucket(elapsed);
+    latency_bump(&block->counts[op][bucket]);
+    if ((unsigned)dbSlot < LATENCY_DB_SLOTS)
+    {
+        latency_bump(&block->db_gets[dbSlot][bucket]);
+    }
+}
+
+static inline void latency_end(int op, uint64_t start)
+{
+    if (__builtin_expect(start != 0, 0))
+    {
+        latency_record_slow(op, -1, start);
+    }
+}
+
+/** Records a get both process-wide and against the database's slot, if it has one. */
+static inline void latency_end_get(int dbSlot, uint64_t start)
+{
+    if (__builtin_expect(start != 0, 0))
+    {
+        latency_record_slow(LATENCY_GET, dbSlot, start);
+    }
+}
+
+static void release_cached_classes(JNIEnv *env)
+{
+    jclass *classes[] = {&g_exception_class,   &g_string_class,    &g_byte_array_class,
+                         &g_key_value_class,   &g_commit_op_class, &g_commit_hook_class,
+                         &g_cache_stats_class, &g_stats_class,     &g_db_stats_class,
+                         &g_cf_config_class,   &g_future_class,    &g_async_commit_hooks_class,
+                         &g_event_listeners_class};
+
+    for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++)
+    {
+        if (*classes[i] != NULL)
+        {
+            (*env)->DeleteGlobalRef(env, *classes[i]);
+            *classes[i] = NULL;
+        }
+    }
+}
+
+/*
+ * Native threads that call into Java (commit hook delivery, async workers, or engine threads
+ * firing a callback) are attached once as daemons and keep their JNIEnv in this key. The key
+ * destructor detaches them when the thread exits.
+ */
+static pthread_key_t g_env_key;
+static int g_env_key_created = 0;
+
+static void detach_thread_env(void *env)
+{
+    if (g_jvm != NULL)
+    {
+        (*g_jvm)->DetachCurrentThread(g_jvm);
+    }
+}
+
+/**
+ * Returns a JNIEnv for the calling thread, attaching it as a daemon on first use.
+ * Threads already owned by the JVM are returned as-is and never detached by us.
+ * name is only used when the thread has to be attached and may be NULL.
+ */
+static JNIEnv *attach_thread_env(const char *name)
+{
+    JNIEnv *env = (JNIEnv *)pthread_getspecific(g_env_key);
+    if (env != NULL)
+    {
+        return env;
+    }
+
+    jint rc = (*g_jvm)->GetEnv(g_jvm, (void **)&env, JNI_VERSION_1_6);
+    if (rc == JNI_OK)
+    {
+        return env;
+    }
+    if (rc != JNI_EDETACHED)
+    {
+        return NULL;
+    }
+
+    JavaVMAttachArgs attachArgs = {JNI_VERSION_1_6, (char *)name, NULL};
+    if ((*g_jvm)->AttachCurrentThreadAsDaemon(g_jvm, (void **)&env, &attachArgs) != JNI_OK)
+    {
+        return NULL;
+    }
+    if (pthread_setspecific(g_env_key, env) != 0)
+    {
+        /* without the key nothing would detach this thread, so do not keep it attached */
+        (*g_jvm)->DetachCurrentThread(g_jvm);
+        return NULL;
+    }
+    return env;
+}
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
+{
+    JNIEnv *env = NULL;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK)
+    {
+        return JNI_ERR;
+    }
+
+    g_jvm = vm;
+
+    if (pthread_key_create(&g_env_key, detach_thread_env) != 0)
+    {
+        return JNI_ERR;
+    }
+    g_env_key_created = 1;
+
+    if (pthread_key_create(&g_latency_key, latency_release) != 0)
+    {
+        return JNI_ERR;
+    }
+    g_latency_key_created = 1;
+
+    if (cache_class(env, "com/tidesdb/TidesDBException", &g_exception_class) != 0 ||
+        cache_class(env, "java/lang/String", &g_string_class) != 0 ||
+        cache_class(env, "[B", &g_byte_array_class) != 0 ||
+        cache_class(env, "com/tidesdb/KeyValue", &g_key_value_class) != 0 ||
+        cache_class(env, "com/tidesdb/CommitOp", &g_commit_op_class) != 0 ||
+        cache_class(env, "com/tidesdb/CommitHook", &g_commit_hook_class) != 0 ||
+        cache_class(env, "com/tidesdb/CacheStats", &g_cache_stats_class) != 0 ||
+        cache_class(env, "com/tidesdb/Stats", &g_stats_class) != 0 ||
+        cache_class(env, "com/tidesdb/DbStats", &g_db_stats_class) != 0 ||
+        cache_class(env, "com/tidesdb/ColumnFamilyConfig", &g_cf_config_class) != 0 ||
+        cache_class(env, "java/util/concurrent/CompletableFuture", &g_future_class) != 0 ||
+        cache_class(env, "com/tidesdb/AsyncCommitHooks", &g_async_commit_hooks_class) != 0 ||
+        cache_class(env, "com/tidesdb/EventListeners", &g_event_listeners_class) != 0)
+    {
+        release_cached_classes(env);
+        return JNI_ERR;
+    }
+
+    g_exception_ctor =
+        (*env)->GetMethodID(env, g_exception_class, "<init>", "(Ljava/lang/String;I)V");
+    g_key_value_ctor = (*env)->GetMethodID(env, g_key_value_class, "<init>", "([B[B)V");
+    /* CommitOp(byte[], byte[], long, boolean) */
+    g_commit_op_ctor = (*env)->GetMethodID(env, g_commit_op_class, "<init>", "([B[BJZ)V");
+    /* CommitHook.onCommit(CommitOp[], long) */
+    g_commit_hook_on_commit = (*env)->GetMethodID(env, g_commit_hook_class, "onCommit",
+                                                  "([Lcom/tidesdb/CommitOp;J)I");
+    g_cache_stats_ctor = (*env)->GetMethodID(env, g_cache_stats_class, "<init>", "(ZJJJJDJ)V");
+    g_stats_ctor =
+        (*env)->GetMethodID(env, g_stats_class, "<init>",
+                            "(IJ[J[ILcom/tidesdb/ColumnFamilyConfig;JJDD[JDDZJIDJD[JDI)V");
+    /* DbStats constructor signature:
+       int, long, long, long, int, int, long, int, int, long, int, long, long, long, long,
+       boolean, long, int, boolean, int, long,
+       boolean, String, long, long, int, long, long, long, long, boolean */
+    g_db_stats_ctor = (*env)->GetMethodID(env, g_db_stats_class, "<init>",
+                                          "(IJJJIIJIIJIJJJJZJIZIJZLjava/lang/String;JJIJJJJZ)V");
+    g_cf_config_from_native = (*env)->GetStaticMethodID(
+        env, g_cf_config_class, "fromNative",
+        "(JJIIJIZDZIIIJLjava/lang/String;IFIJIIDJZZZ)Lcom/tidesdb/ColumnFamilyConfig;");
+    /* AsyncCommitHooks.deliver(CommitHook, ByteBuffer, int, int) */
+    g_async_commit_hooks_deliver =
+        (*env)->GetStaticMethodID(env, g_async_commit_hooks_class, "deliver",
+                                  "(Lcom/tidesdb/CommitHook;Ljava/nio/ByteBuffer;II)V");
+    /* EventListeners.deliver(EventListener, int, String, long, long) */
+    g_event_listeners_deliver =
+        (*env)->GetStaticMethodID(env, g_event_listeners_class, "deliver",
+                                  "(Lcom/tidesdb/EventListener;ILjava/lang/String;JJ)V");
+    g_future_complete =
+        (*env)->GetMethodID(env, g_future_class, "complete", "(Ljava/lang/Object;)Z");
+    g_future_complete_exceptionally = (*env)->GetMethodID(
+        env, g_future_class, "completeExceptionally", "(Ljava/lang/Throwable;)Z");
+
+    if (g_exception_ctor == NULL || g_key_value_ctor == NULL || g_commit_op_ctor == NULL ||
+        g_commit_hook_on_commit == NULL || g_cache_stats_ctor == NULL || g_stats_ctor == NULL ||
+        g_db_stats_ctor == NULL || g_cf_config_from_native == NULL || g_future_complete == NULL ||
+        g_future_complete_exceptionally == NULL || g_async_commit_hooks_deliver == NULL ||
+        g_event_listeners_deliver == NULL)
+    {
+        release_cached_classes(env);
+        return JNI_ERR;
+    }
+
+    return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved)
+{
+    JNIEnv *env = NULL;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK)
     {
-        (*env)->ThrowNew(env, exClass, message);
         return;
     }
 
+    release_cached_classes(env);
+    if (g_env_key_created)
+    {
+        pthread_key_delete(g_env_key);
+        g_env_key_created = 0;
+    }
+    if (g_latency_key_created)
+    {
+        pthread_key_delete(g_latency_key);
+        g_latency_key_created = 0;
+    }
+    g_jvm = NULL;
+}
+
+static void throwTidesDBException(JNIEnv *env, int errorCode, const char *message)
+{
+    int codeSlot = (errorCode < 0 && -errorCode < METRIC_EXCEPTION_CODES) ? -errorCode : 0;
+    metric_add(METRIC_EXCEPTIONS + codeSlot, 1);
+
     jstring jMessage = (*env)->NewStringUTF(env, message);
-    jthrowable exception =
-        (jthrowable)(*env)->NewObject(env, exClass, constructor, jMessage, errorCode);
+    if (jMessage == NULL)
+    {
+        return; /* OutOfMemoryError already pending */
+    }
+
+    jthrowable exception = (jthrowable)(*env)->NewObject(env, g_exception_class,
+                                                         g_exception_ctor, jMessage, errorCode);
+    (*env)->DeleteLocalRef(env, jMessage);
+    if (exception == NULL)
+    {
+        return;
+    }
     (*env)->Throw(env, exception);
+    (*env)->DeleteLocalRef(env, exception);
 }
 
 static const char *getErrorMessage(int code)
@@ -75,107 +495,415 @@ static const char *getErrorMessage(int code)
     }
 }
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeOpen(
-    JNIEnv *env, jclass cls, jstring dbPath, jint numFlushThreads, jint numCompactionThreads,
-    jint logLevel, jlong blockCacheSize, jlong maxOpenSSTables, jboolean logToFile,
-    jlong logTruncationAt, jlong maxMemoryUsage, jboolean unifiedMemtable,
-    jlong unifiedMemtableWriteBufferSize, jint unifiedMemtableSkipListMaxLevel,
-    jfloat unifiedMemtableSkipListProbability, jint unifiedMemtableSyncMode,
-    jlong unifiedMemtableSyncIntervalUs, jstring objectStoreFsPath, jstring oscLocalCachePath,
-    jlong oscLocalCacheMaxBytes, jboolean oscCacheOnRead, jboolean oscCacheOnWrite,
-    jint oscMaxConcurrentUploads, jint oscMaxConcurrentDownloads, jlong oscMultipartThreshold,
-    jlong oscMultipartPartSize, jboolean oscSyncManifestToObject, jboolean oscReplicateWal,
-    jboolean oscWalUploadSync, jlong oscWalSyncThresholdBytes, jboolean oscWalSyncOnCommit,
-    jboolean oscReplicaMode, jlong oscReplicaSyncIntervalUs, jboolean oscReplicaReplayWal,
-    jint maxConcurrentFlushes)
+/**
+ * Resolves [offset, offset + length) of a direct ByteBuffer to a native pointer. Throws and
+ * returns NULL if the buffer is not direct or the region falls outside its capacity.
+ */
+static uint8_t *direct_buffer_region(JNIEnv *env, jobject buf, jint offset, jint length)
 {
-    const char *path = (*env)->GetStringUTFChars(env, dbPath, NULL);
-    if (path == NULL)
+    uint8_t *base = (uint8_t *)(*env)->GetDirectBufferAddress(env, buf);
+    if (base == NULL)
     {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get database path");
-        return 0;
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "buffer is not a direct ByteBuffer");
+        return NULL;
     }
 
-    /* object store connector (filesystem) */
-    tidesdb_objstore_t *obj_store = NULL;
-    const char *fs_path = NULL;
-    if (objectStoreFsPath != NULL)
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buf);
+    if (offset < 0 || length < 0 || (jlong)offset + (jlong)length > capacity)
     {
-        fs_path = (*env)->GetStringUTFChars(env, objectStoreFsPath, NULL);
-        if (fs_path != NULL)
-        {
-            obj_store = tidesdb_objstore_fs_create(fs_path);
-        }
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "buffer region out of bounds");
+        return NULL;
     }
 
-    /* object store behavior config */
-    const char *cache_path = NULL;
-    if (oscLocalCachePath != NULL)
-    {
-        cache_path = (*env)->GetStringUTFChars(env, oscLocalCachePath, NULL);
-    }
+    return base + offset;
+}
 
-    tidesdb_objstore_config_t os_cfg = {
-        .local_cache_path = cache_path,
-        .local_cache_max_bytes = (size_t)oscLocalCacheMaxBytes,
-        .cache_on_read = oscCacheOnRead ? 1 : 0,
-        .cache_on_write = oscCacheOnWrite ? 1 : 0,
-        .max_concurrent_uploads = oscMaxConcurrentUploads,
-        .max_concurrent_downloads = oscMaxConcurrentDownloads,
-        .multipart_threshold = (size_t)oscMultipartThreshold,
-        .multipart_part_size = (size_t)oscMultipartPartSize,
-        .sync_manifest_to_object = oscSyncManifestToObject ? 1 : 0,
-        .replicate_wal = oscReplicateWal ? 1 : 0,
-        .wal_upload_sync = oscWalUploadSync ? 1 : 0,
-        .wal_sync_threshold_bytes = (size_t)oscWalSyncThresholdBytes,
-        .wal_sync_on_commit = oscWalSyncOnCommit ? 1 : 0,
-        .replica_mode = oscReplicaMode ? 1 : 0,
-        .replica_sync_interval_us = (uint64_t)oscReplicaSyncIntervalUs,
-        .replica_replay_wal = oscReplicaReplayWal ? 1 : 0};
+/*
+ * Packed buffer formats exchanged with Java store lengths as 32-bit big-endian integers so
+ * callers can use ByteBuffer.putInt/getInt with the default byte order.
+ */
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
 
-    tidesdb_config_t config = {
-        .db_path = (char *)path,
-        .num_flush_threads = numFlushThreads,
-        .num_compaction_threads = numCompactionThreads,
-        .log_level = (tidesdb_log_level_t)logLevel,
-        .block_cache_size = (size_t)blockCacheSize,
-        .max_open_sstables = (size_t)maxOpenSSTables,
-        .max_memory_usage = (size_t)maxMemoryUsage,
-        .log_to_file = logToFile ? 1 : 0,
-        .log_truncation_at = (size_t)logTruncationAt,
-        .unified_memtable = unifiedMemtable ? 1 : 0,
-        .unified_memtable_write_buffer_size = (size_t)unifiedMemtableWriteBufferSize,
-        .unified_memtable_skip_list_max_level = unifiedMemtableSkipListMaxLevel,
-        .unified_memtable_skip_list_probability = unifiedMemtableSkipListProbability,
-        .unified_memtable_sync_mode = unifiedMemtableSyncMode,
-        .unified_memtable_sync_interval_us = (uint64_t)unifiedMemtableSyncIntervalUs,
-        .object_store = obj_store,
-        .object_store_config = obj_store != NULL ? &os_cfg : NULL,
-        .max_concurrent_flushes = maxConcurrentFlushes};
+static inline void write_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
 
-    tidesdb_t *db = NULL;
-    int result = tidesdb_open(&config, &db);
+static inline uint64_t read_be64(const uint8_t *p)
+{
+    return ((uint64_t)read_be32(p) << 32) | (uint64_t)read_be32(p + 4);
+}
 
-    (*env)->ReleaseStringUTFChars(env, dbPath, path);
-    if (fs_path != NULL)
+static inline void write_be64(uint8_t *p, uint64_t v)
+{
+    write_be32(p, (uint32_t)(v >> 32));
+    write_be32(p + 4, (uint32_t)v);
+}
+
+/*
+ * Comparators compiled into the binding. They are registered with every database right after
+ * open so column families can select them through ColumnFamilyConfig.comparatorName without a
+ * per-comparison call into Java. Fixed-width integer comparators order keys of other widths by
+ * length first, then bytewise, so mixed widths still form one strict weak order.
+ */
+static int bytewise_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len)
+{
+    size_t n = a_len < b_len ? a_len : b_len;
+    int cmp = n > 0 ? memcmp(a, b, n) : 0;
+    if (cmp != 0)
     {
-        (*env)->ReleaseStringUTFChars(env, objectStoreFsPath, fs_path);
+        return cmp;
     }
-    if (cache_path != NULL)
+    return (a_len > b_len) - (a_len < b_len);
+}
+
+/* Orders by length, then bytewise; used when a key is not the comparator's fixed width */
+static int width_first_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len)
+{
+    if (a_len != b_len)
     {
-        (*env)->ReleaseStringUTFChars(env, oscLocalCachePath, cache_path);
+        return (a_len > b_len) - (a_len < b_len);
     }
+    return bytewise_cmp(a, a_len, b, b_len);
+}
 
-    if (result != TDB_SUCCESS)
+static int uint64_be_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len,
+                         void *ctx)
+{
+    if (a_len != 8 || b_len != 8)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return 0;
+        return width_first_cmp(a, a_len, b, b_len);
     }
-
-    return (jlong)(uintptr_t)db;
+    uint64_t x = read_be64(a);
+    uint64_t y = read_be64(b);
+    return (x > y) - (x < y);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeClose(JNIEnv *env, jclass cls, jlong handle)
+static int int64_be_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len,
+                        void *ctx)
+{
+    if (a_len != 8 || b_len != 8)
+    {
+        return width_first_cmp(a, a_len, b, b_len);
+    }
+    int64_t x = (int64_t)read_be64(a);
+    int64_t y = (int64_t)read_be64(b);
+    return (x > y) - (x < y);
+}
+
+static int reverse_bytewise_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len,
+                                void *ctx)
+{
+    return bytewise_cmp(b, b_len, a, a_len);
+}
+
+/**
+ * Keys are [prefix][be64 timestamp]: prefixes sort bytewise, and within a prefix newer
+ * timestamps sort first. Keys shorter than the timestamp sort before all others, bytewise
+ * among themselves.
+ */
+static int prefix_ts_desc_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len,
+                              void *ctx)
+{
+    if (a_len < 8 || b_len < 8)
+    {
+        if (a_len >= 8 || b_len >= 8)
+        {
+            return a_len < 8 ? -1 : 1;
+        }
+        return bytewise_cmp(a, a_len, b, b_len);
+    }
+    int cmp = bytewise_cmp(a, a_len - 8, b, b_len - 8);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    uint64_t x = read_be64(a + a_len - 8);
+    uint64_t y = read_be64(b + b_len - 8);
+    return (y > x) - (y < x);
+}
+
+typedef struct
+{
+    const char *name;
+    tidesdb_comparator_fn fn;
+} builtin_comparator_t;
+
+/* Names must stay in sync with com.tidesdb.Comparators */
+static const builtin_comparator_t g_builtin_comparators[] = {
+    {"uint64_be", uint64_be_cmp},
+    {"int64_be", int64_be_cmp},
+    {"reverse_bytewise", reverse_bytewise_cmp},
+    {"prefix_ts_desc", prefix_ts_desc_cmp},
+};
+
+static tidesdb_comparator_fn find_builtin_comparator(const char *name)
+{
+    for (size_t i = 0; i < sizeof(g_builtin_comparators) / sizeof(g_builtin_comparators[0]); i++)
+    {
+        if (strcmp(g_builtin_comparators[i].name, name) == 0)
+        {
+            return g_builtin_comparators[i].fn;
+        }
+    }
+    return NULL;
+}
+
+/* bytewise_cmp in comparator form: the order of column families on the engine default */
+static int bytewise_order_cmp(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len,
+                              void *ctx)
+{
+    return bytewise_cmp(a, a_len, b, b_len);
+}
+
+/**
+ * Resolves the key order the binding compares range bounds in. Returns NULL for comparators
+ * only the engine knows, such as ones registered by name from Java, whose order the binding
+ * cannot reproduce.
+ */
+static tidesdb_comparator_fn key_order_for(const char *name)
+{
+    if (name == NULL || name[0] == '\0' || strcmp(name, "memcmp") == 0)
+    {
+        return bytewise_order_cmp;
+    }
+    return find_builtin_comparator(name);
+}
+
+static int register_builtin_comparators(tidesdb_t *db)
+{
+    for (size_t i = 0; i < sizeof(g_builtin_comparators) / sizeof(g_builtin_comparators[0]); i++)
+    {
+        int result = tidesdb_register_comparator(db, g_builtin_comparators[i].name,
+                                                 g_builtin_comparators[i].fn, NULL, NULL);
+        if (result != TDB_SUCCESS && result != TDB_ERR_EXISTS)
+        {
+            return result;
+        }
+    }
+    return TDB_SUCCESS;
+}
+
+/**
+ * tidesdb_register_comparator needs an open database, so column families recovered inside
+ * tidesdb_open are set up before the binding comparators exist. A column family that resolves
+ * its comparator lazily picks them up on first use; one that was already bound to a different
+ * function would run under the wrong key order, so the open is failed instead. The offending
+ * column family is described in `msg`.
+ */
+static int check_recovered_comparators(tidesdb_t *db, char *msg, size_t msgLen)
+{
+    char **names = NULL;
+    int count = 0;
+    int result = tidesdb_list_column_families(db, &names, &count);
+    if (result != TDB_SUCCESS)
+    {
+        return result;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        tidesdb_column_family_t *cf =
+            result == TDB_SUCCESS ? tidesdb_get_column_family(db, names[i]) : NULL;
+        tidesdb_stats_t *stats = NULL;
+        if (cf != NULL && tidesdb_get_stats(cf, &stats) == TDB_SUCCESS)
+        {
+            const tidesdb_column_family_config_t *config = stats->config;
+            tidesdb_comparator_fn fn =
+                config != NULL ? find_builtin_comparator(config->comparator_name) : NULL;
+            if (fn != NULL && config->comparator_fn_cached != NULL &&
+                config->comparator_fn_cached != fn)
+            {
+                snprintf(msg, msgLen,
+                         "Column family '%s' was recovered before comparator '%s' was registered",
+                         names[i], config->comparator_name);
+                result = TDB_ERR_INVALID_DB;
+            }
+            tidesdb_free_stats(stats);
+        }
+        free(names[i]);
+    }
+    free(names);
+    return result;
+}
+
+#ifdef TIDESDB_WITH_S3
+/* endpoint, bucket, prefix, access key, secret key, region */
+#define S3_STRING_COUNT 6
+#endif
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeOpen(
+    JNIEnv *env, jclass cls, jstring dbPath, jint numFlushThreads, jint numCompactionThreads,
+    jint logLevel, jlong blockCacheSize, jlong maxOpenSSTables, jboolean logToFile,
+    jlong logTruncationAt, jlong maxMemoryUsage, jboolean unifiedMemtable,
+    jlong unifiedMemtableWriteBufferSize, jint unifiedMemtableSkipListMaxLevel,
+    jfloat unifiedMemtableSkipListProbability, jint unifiedMemtableSyncMode,
+    jlong unifiedMemtableSyncIntervalUs, jstring objectStoreFsPath, jstring s3Endpoint,
+    jstring s3Bucket, jstring s3Prefix, jstring s3AccessKey, jstring s3SecretKey, jstring s3Region,
+    jboolean s3UseSsl, jboolean s3UsePathStyle, jstring oscLocalCachePath,
+    jlong oscLocalCacheMaxBytes, jboolean oscCacheOnRead, jboolean oscCacheOnWrite,
+    jint oscMaxConcurrentUploads, jint oscMaxConcurrentDownloads, jlong oscMultipartThreshold,
+    jlong oscMultipartPartSize, jboolean oscSyncManifestToObject, jboolean oscReplicateWal,
+    jboolean oscWalUploadSync, jlong oscWalSyncThresholdBytes, jboolean oscWalSyncOnCommit,
+    jboolean oscReplicaMode, jlong oscReplicaSyncIntervalUs, jboolean oscReplicaReplayWal,
+    jint maxConcurrentFlushes)
+{
+    const char *path = (*env)->GetStringUTFChars(env, dbPath, NULL);
+    if (path == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get database path");
+        return 0;
+    }
+
+    /* object store connector (filesystem or S3) */
+    tidesdb_objstore_t *obj_store = NULL;
+    const char *fs_path = NULL;
+    if (objectStoreFsPath != NULL)
+    {
+        fs_path = (*env)->GetStringUTFChars(env, objectStoreFsPath, NULL);
+        if (fs_path != NULL)
+        {
+            obj_store = tidesdb_objstore_fs_create(fs_path);
+        }
+    }
+    else if (s3Endpoint != NULL)
+    {
+#ifdef TIDESDB_WITH_S3
+        jstring s3Strings[S3_STRING_COUNT] = {s3Endpoint,  s3Bucket,    s3Prefix,
+                                              s3AccessKey, s3SecretKey, s3Region};
+        const char *s3Utf[S3_STRING_COUNT] = {NULL};
+        int s3Ok = 1;
+        for (int i = 0; i < S3_STRING_COUNT; i++)
+        {
+            if (s3Strings[i] != NULL)
+            {
+                s3Utf[i] = (*env)->GetStringUTFChars(env, s3Strings[i], NULL);
+                if (s3Utf[i] == NULL)
+                {
+                    s3Ok = 0;
+                }
+            }
+        }
+        if (s3Ok)
+        {
+            obj_store = tidesdb_objstore_s3_create(s3Utf[0], s3Utf[1], s3Utf[2], s3Utf[3],
+                                                   s3Utf[4], s3Utf[5], s3UseSsl ? 1 : 0,
+                                                   s3UsePathStyle ? 1 : 0);
+        }
+        for (int i = 0; i < S3_STRING_COUNT; i++)
+        {
+            if (s3Utf[i] != NULL)
+            {
+                (*env)->ReleaseStringUTFChars(env, s3Strings[i], s3Utf[i]);
+            }
+        }
+        if (obj_store == NULL)
+        {
+            (*env)->ReleaseStringUTFChars(env, dbPath, path);
+            throwTidesDBException(env, TDB_ERR_IO, "Failed to create S3 object store connector");
+            return 0;
+        }
+#else
+        (*env)->ReleaseStringUTFChars(env, dbPath, path);
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS,
+                              "S3 object store connector not compiled in (build with "
+                              "-DTIDESDB_WITH_S3=ON)");
+        return 0;
+#endif
+    }
+
+    /* object store behavior config */
+    const char *cache_path = NULL;
+    if (oscLocalCachePath != NULL)
+    {
+        cache_path = (*env)->GetStringUTFChars(env, oscLocalCachePath, NULL);
+    }
+
+    tidesdb_objstore_config_t os_cfg = {
+        .local_cache_path = cache_path,
+        .local_cache_max_bytes = (size_t)oscLocalCacheMaxBytes,
+        .cache_on_read = oscCacheOnRead ? 1 : 0,
+        .cache_on_write = oscCacheOnWrite ? 1 : 0,
+        .max_concurrent_uploads = oscMaxConcurrentUploads,
+        .max_concurrent_downloads = oscMaxConcurrentDownloads,
+        .multipart_threshold = (size_t)oscMultipartThreshold,
+        .multipart_part_size = (size_t)oscMultipartPartSize,
+        .sync_manifest_to_object = oscSyncManifestToObject ? 1 : 0,
+        .replicate_wal = oscReplicateWal ? 1 : 0,
+        .wal_upload_sync = oscWalUploadSync ? 1 : 0,
+        .wal_sync_threshold_bytes = (size_t)oscWalSyncThresholdBytes,
+        .wal_sync_on_commit = oscWalSyncOnCommit ? 1 : 0,
+        .replica_mode = oscReplicaMode ? 1 : 0,
+        .replica_sync_interval_us = (uint64_t)oscReplicaSyncIntervalUs,
+        .replica_replay_wal = oscReplicaReplayWal ? 1 : 0};
+
+    tidesdb_config_t config = {
+        .db_path = (char *)path,
+        .num_flush_threads = numFlushThreads,
+        .num_compaction_threads = numCompactionThreads,
+        .log_level = (tidesdb_log_level_t)logLevel,
+        .block_cache_size = (size_t)blockCacheSize,
+        .max_open_sstables = (size_t)maxOpenSSTables,
+        .max_memory_usage = (size_t)maxMemoryUsage,
+        .log_to_file = logToFile ? 1 : 0,
+        .log_truncation_at = (size_t)logTruncationAt,
+        .unified_memtable = unifiedMemtable ? 1 : 0,
+        .unified_memtable_write_buffer_size = (size_t)unifiedMemtableWriteBufferSize,
+        .unified_memtable_skip_list_max_level = unifiedMemtableSkipListMaxLevel,
+        .unified_memtable_skip_list_probability = unifiedMemtableSkipListProbability,
+        .unified_memtable_sync_mode = unifiedMemtableSyncMode,
+        .unified_memtable_sync_interval_us = (uint64_t)unifiedMemtableSyncIntervalUs,
+        .object_store = obj_store,
+        .object_store_config = obj_store != NULL ? &os_cfg : NULL,
+        .max_concurrent_flushes = maxConcurrentFlushes};
+
+    tidesdb_t *db = NULL;
+    int result = tidesdb_open(&config, &db);
+
+    (*env)->ReleaseStringUTFChars(env, dbPath, path);
+    if (fs_path != NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, objectStoreFsPath, fs_path);
+    }
+    if (cache_path != NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, oscLocalCachePath, cache_path);
+    }
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    result = register_builtin_comparators(db);
+    if (result != TDB_SUCCESS)
+    {
+        tidesdb_close(db);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    char msg[256];
+    result = check_recovered_comparators(db, msg, sizeof(msg));
+    if (result != TDB_SUCCESS)
+    {
+        tidesdb_close(db);
+        throwTidesDBException(env, result,
+                              result == TDB_ERR_INVALID_DB ? msg : getErrorMessage(result));
+        return 0;
+    }
+
+    return (jlong)(uintptr_t)db;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeClose(JNIEnv *env, jclass cls, jlong handle)
 {
     tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
     if (db != NULL)
@@ -235,205 +963,3221 @@ JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCreateColumnFamily(
         .object_lazy_compaction = objectLazyCompaction ? 1 : 0,
         .object_prefetch_compaction = objectPrefetchCompaction ? 1 : 0};
 
-    memset(config.comparator_name, 0, TDB_MAX_COMPARATOR_NAME);
-    if (compName != NULL && strlen(compName) > 0)
+    memset(config.comparator_name, 0, TDB_MAX_COMPARATOR_NAME);
+    if (compName != NULL && strlen(compName) > 0)
+    {
+        strncpy(config.comparator_name, compName, TDB_MAX_COMPARATOR_NAME - 1);
+    }
+
+    memset(config.comparator_ctx_str, 0, TDB_MAX_COMPARATOR_CTX);
+    config.comparator_fn_cached = NULL;
+    config.comparator_ctx_cached = NULL;
+
+    int result = tidesdb_create_column_family(db, cfName, &config);
+
+    (*env)->ReleaseStringUTFChars(env, name, cfName);
+    if (compName != NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, comparatorName, compName);
+    }
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeDropColumnFamily(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jstring name)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *cfName = (*env)->GetStringUTFChars(env, name, NULL);
+    if (cfName == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get column family name");
+        return;
+    }
+
+    int result = tidesdb_drop_column_family(db, cfName);
+
+    (*env)->ReleaseStringUTFChars(env, name, cfName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeGetColumnFamily(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jstring name)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *cfName = (*env)->GetStringUTFChars(env, name, NULL);
+    if (cfName == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get column family name");
+        return 0;
+    }
+
+    tidesdb_column_family_t *cf = tidesdb_get_column_family(db, cfName);
+
+    (*env)->ReleaseStringUTFChars(env, name, cfName);
+
+    if (cf == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_NOT_FOUND, "Column family not found");
+        return 0;
+    }
+
+    return (jlong)(uintptr_t)cf;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_tidesdb_TidesDB_nativeListColumnFamilies(JNIEnv *env,
+                                                                                 jclass cls,
+                                                                                 jlong handle)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    char **names = NULL;
+    int count = 0;
+
+    int result = tidesdb_list_column_families(db, &names, &count);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jobjectArray array = (*env)->NewObjectArray(env, count, g_string_class, NULL);
+
+    for (int i = 0; i < count; i++)
+    {
+        jstring str = (*env)->NewStringUTF(env, names[i]);
+        (*env)->SetObjectArrayElement(env, array, i, str);
+        free(names[i]);
+    }
+    free(names);
+
+    return array;
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeBeginTransaction(JNIEnv *env, jclass cls,
+                                                                        jlong handle)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    tidesdb_txn_t *txn = NULL;
+
+    int result = tidesdb_txn_begin(db, &txn);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    return (jlong)(uintptr_t)txn;
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeBeginTransactionWithIsolation(
+    JNIEnv *env, jclass cls, jlong handle, jint isolationLevel)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    tidesdb_txn_t *txn = NULL;
+
+    int result =
+        tidesdb_txn_begin_with_isolation(db, (tidesdb_isolation_level_t)isolationLevel, &txn);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    return (jlong)(uintptr_t)txn;
+}
+
+JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDB_nativeGetCacheStats(JNIEnv *env, jclass cls,
+                                                                       jlong handle)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    tidesdb_cache_stats_t stats;
+
+    int result = tidesdb_get_cache_stats(db, &stats);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    return (*env)->NewObject(env, g_cache_stats_class, g_cache_stats_ctor, stats.enabled != 0,
+                             (jlong)stats.total_entries, (jlong)stats.total_bytes,
+                             (jlong)stats.hits, (jlong)stats.misses, stats.hit_rate,
+                             (jlong)stats.num_partitions);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeRegisterComparator(JNIEnv *env, jclass cls,
+                                                                         jlong handle, jstring name,
+                                                                         jstring context)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *compName = (*env)->GetStringUTFChars(env, name, NULL);
+    if (compName == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get comparator name");
+        return;
+    }
+
+    const char *ctx = NULL;
+    if (context != NULL)
+    {
+        ctx = (*env)->GetStringUTFChars(env, context, NULL);
+    }
+
+    /* names of binding comparators resolve to their compiled function */
+    int result =
+        tidesdb_register_comparator(db, compName, find_builtin_comparator(compName), ctx, NULL);
+
+    (*env)->ReleaseStringUTFChars(env, name, compName);
+    if (ctx != NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, context, ctx);
+    }
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeBackup(JNIEnv *env, jclass cls, jlong handle,
+                                                             jstring dir)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *backupDir = (*env)->GetStringUTFChars(env, dir, NULL);
+    if (backupDir == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get backup directory");
+        return;
+    }
+
+    int result = tidesdb_backup(db, (char *)backupDir);
+
+    (*env)->ReleaseStringUTFChars(env, dir, backupDir);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCheckpoint(JNIEnv *env, jclass cls,
+                                                                 jlong handle, jstring dir)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *checkpointDir = (*env)->GetStringUTFChars(env, dir, NULL);
+    if (checkpointDir == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get checkpoint directory");
+        return;
+    }
+
+    int result = tidesdb_checkpoint(db, checkpointDir);
+
+    (*env)->ReleaseStringUTFChars(env, dir, checkpointDir);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeRenameColumnFamily(JNIEnv *env, jclass cls,
+                                                                          jlong handle,
+                                                                          jstring oldName,
+                                                                          jstring newName)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *oldCfName = (*env)->GetStringUTFChars(env, oldName, NULL);
+    if (oldCfName == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get old column family name");
+        return;
+    }
+
+    const char *newCfName = (*env)->GetStringUTFChars(env, newName, NULL);
+    if (newCfName == NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, oldName, oldCfName);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get new column family name");
+        return;
+    }
+
+    int result = tidesdb_rename_column_family(db, oldCfName, newCfName);
+
+    (*env)->ReleaseStringUTFChars(env, oldName, oldCfName);
+    (*env)->ReleaseStringUTFChars(env, newName, newCfName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCloneColumnFamily(JNIEnv *env, jclass cls,
+                                                                        jlong handle,
+                                                                        jstring sourceName,
+                                                                        jstring destName)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    const char *srcCfName = (*env)->GetStringUTFChars(env, sourceName, NULL);
+    if (srcCfName == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get source column family name");
+        return;
+    }
+
+    const char *dstCfName = (*env)->GetStringUTFChars(env, destName, NULL);
+    if (dstCfName == NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, sourceName, srcCfName);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get destination column family name");
+        return;
+    }
+
+    int result = tidesdb_clone_column_family(db, srcCfName, dstCfName);
+
+    (*env)->ReleaseStringUTFChars(env, sourceName, srcCfName);
+    (*env)->ReleaseStringUTFChars(env, destName, dstCfName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jobject JNICALL Java_com_tidesdb_ColumnFamily_nativeGetStats(JNIEnv *env, jclass cls,
+                                                                       jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    tidesdb_stats_t *stats = NULL;
+
+    int result = tidesdb_get_stats(cf, &stats);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jlongArray levelSizes = (*env)->NewLongArray(env, stats->num_levels);
+    if (stats->level_sizes != NULL)
+    {
+        jlong *sizes = malloc(stats->num_levels * sizeof(jlong));
+        for (int i = 0; i < stats->num_levels; i++)
+        {
+            sizes[i] = (jlong)stats->level_sizes[i];
+        }
+        (*env)->SetLongArrayRegion(env, levelSizes, 0, stats->num_levels, sizes);
+        free(sizes);
+    }
+
+    jintArray levelNumSSTables = (*env)->NewIntArray(env, stats->num_levels);
+    if (stats->level_num_sstables != NULL)
+    {
+        jint *nums = malloc(stats->num_levels * sizeof(jint));
+        for (int i = 0; i < stats->num_levels; i++)
+        {
+            nums[i] = stats->level_num_sstables[i];
+        }
+        (*env)->SetIntArrayRegion(env, levelNumSSTables, 0, stats->num_levels, nums);
+        free(nums);
+    }
+
+    jlongArray levelKeyCounts = (*env)->NewLongArray(env, stats->num_levels);
+    if (stats->level_key_counts != NULL)
+    {
+        jlong *counts = malloc(stats->num_levels * sizeof(jlong));
+        for (int i = 0; i < stats->num_levels; i++)
+        {
+            counts[i] = (jlong)stats->level_key_counts[i];
+        }
+        (*env)->SetLongArrayRegion(env, levelKeyCounts, 0, stats->num_levels, counts);
+        free(counts);
+    }
+
+    jlongArray levelTombstoneCounts = (*env)->NewLongArray(env, stats->num_levels);
+    if (stats->level_tombstone_counts != NULL)
+    {
+        jlong *counts = malloc(stats->num_levels * sizeof(jlong));
+        for (int i = 0; i < stats->num_levels; i++)
+        {
+            counts[i] = (jlong)stats->level_tombstone_counts[i];
+        }
+        (*env)->SetLongArrayRegion(env, levelTombstoneCounts, 0, stats->num_levels, counts);
+        free(counts);
+    }
+
+    /* Build ColumnFamilyConfig from stats->config so callers can round-trip CF settings */
+    jobject cfConfigObj = NULL;
+    if (stats->config != NULL)
+    {
+        jstring comparatorName = (*env)->NewStringUTF(env, stats->config->comparator_name);
+
+        cfConfigObj = (*env)->CallStaticObjectMethod(
+            env, g_cf_config_class, g_cf_config_from_native,
+            (jlong)stats->config->write_buffer_size,
+            (jlong)stats->config->level_size_ratio,
+            (jint)stats->config->min_levels,
+            (jint)stats->config->dividing_level_offset,
+            (jlong)stats->config->klog_value_threshold,
+            (jint)stats->config->compression_algorithm,
+            stats->config->enable_bloom_filter != 0 ? JNI_TRUE : JNI_FALSE,
+            (jdouble)stats->config->bloom_fpr,
+            stats->config->enable_block_indexes != 0 ? JNI_TRUE : JNI_FALSE,
+            (jint)stats->config->index_sample_ratio,
+            (jint)stats->config->block_index_prefix_len,
+            (jint)stats->config->sync_mode,
+            (jlong)stats->config->sync_interval_us,
+            comparatorName,
+            (jint)stats->config->skip_list_max_level,
+            (jfloat)stats->config->skip_list_probability,
+            (jint)stats->config->default_isolation_level,
+            (jlong)stats->config->min_disk_space,
+            (jint)stats->config->l1_file_count_trigger,
+            (jint)stats->config->l0_queue_stall_threshold,
+            (jdouble)stats->config->tombstone_density_trigger,
+            (jlong)stats->config->tombstone_density_min_entries,
+            stats->config->use_btree != 0 ? JNI_TRUE : JNI_FALSE,
+            stats->config->object_lazy_compaction != 0 ? JNI_TRUE : JNI_FALSE,
+            stats->config->object_prefetch_compaction != 0 ? JNI_TRUE : JNI_FALSE);
+
+        (*env)->DeleteLocalRef(env, comparatorName);
+    }
+
+    jobject statsObj = (*env)->NewObject(env, g_stats_class, g_stats_ctor, stats->num_levels,
+                                         (jlong)stats->memtable_size, levelSizes, levelNumSSTables,
+                                         cfConfigObj, (jlong)stats->total_keys,
+                                         (jlong)stats->total_data_size,
+                                         stats->avg_key_size, stats->avg_value_size, levelKeyCounts,
+                                         stats->read_amp, stats->hit_rate,
+                                         stats->use_btree != 0, (jlong)stats->btree_total_nodes,
+                                         (jint)stats->btree_max_height, stats->btree_avg_height,
+                                         (jlong)stats->total_tombstones,
+                                         (jdouble)stats->tombstone_ratio,
+                                         levelTombstoneCounts,
+                                         (jdouble)stats->max_sst_density,
+                                         (jint)stats->max_sst_density_level);
+
+    tidesdb_free_stats(stats);
+
+    return statsObj;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeCompact(JNIEnv *env, jclass cls,
+                                                                   jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    int result = tidesdb_compact(cf);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeCompactRange(JNIEnv *env, jclass cls,
+                                                                        jlong handle,
+                                                                        jbyteArray startKey,
+                                                                        jbyteArray endKey)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+
+    /* Map null/empty byte arrays to NULL pointers for unbounded endpoints. The C API
+       rejects both-NULL with TDB_ERR_INVALID_ARGS, so we don't need to filter here. */
+    jbyte *startBytes = NULL;
+    jsize startLen = 0;
+    if (startKey != NULL)
+    {
+        startLen = (*env)->GetArrayLength(env, startKey);
+        if (startLen > 0)
+        {
+            startBytes = (*env)->GetByteArrayElements(env, startKey, NULL);
+        }
+    }
+
+    jbyte *endBytes = NULL;
+    jsize endLen = 0;
+    if (endKey != NULL)
+    {
+        endLen = (*env)->GetArrayLength(env, endKey);
+        if (endLen > 0)
+        {
+            endBytes = (*env)->GetByteArrayElements(env, endKey, NULL);
+        }
+    }
+
+    int result = tidesdb_compact_range(cf, (const uint8_t *)startBytes, (size_t)startLen,
+                                       (const uint8_t *)endBytes, (size_t)endLen);
+
+    if (startBytes != NULL)
+    {
+        (*env)->ReleaseByteArrayElements(env, startKey, startBytes, JNI_ABORT);
+    }
+    if (endBytes != NULL)
+    {
+        (*env)->ReleaseByteArrayElements(env, endKey, endBytes, JNI_ABORT);
+    }
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeFlushMemtable(JNIEnv *env, jclass cls,
+                                                                         jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    int result = tidesdb_flush_memtable(cf);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_ColumnFamily_nativeIsFlushing(JNIEnv *env, jclass cls,
+                                                                          jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    return tidesdb_is_flushing(cf) != 0;
+}
+
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_ColumnFamily_nativeIsCompacting(JNIEnv *env, jclass cls,
+                                                                            jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    return tidesdb_is_compacting(cf) != 0;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeUpdateRuntimeConfig(
+    JNIEnv *env, jclass cls, jlong handle, jlong writeBufferSize, jint skipListMaxLevel,
+    jfloat skipListProbability, jdouble bloomFPR, jint indexSampleRatio, jint syncMode,
+    jlong syncIntervalUs, jboolean persistToDisk)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+
+    tidesdb_column_family_config_t config = {.write_buffer_size = (size_t)writeBufferSize,
+                                             .skip_list_max_level = skipListMaxLevel,
+                                             .skip_list_probability = skipListProbability,
+                                             .bloom_fpr = bloomFPR,
+                                             .index_sample_ratio = indexSampleRatio,
+                                             .sync_mode = syncMode,
+                                             .sync_interval_us = (uint64_t)syncIntervalUs};
+
+    int result = tidesdb_cf_update_runtime_config(cf, &config, persistToDisk ? 1 : 0);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePut(JNIEnv *env, jclass cls, jlong handle,
+                                                              jlong cfHandle, jbyteArray key,
+                                                              jbyteArray value, jlong ttl)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jsize valueLen = (*env)->GetArrayLength(env, value);
+
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+    jbyte *valueBytes = (*env)->GetByteArrayElements(env, value, NULL);
+
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLen + (uint64_t)valueLen);
+
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_put(txn, cf, (uint8_t *)keyBytes, keyLen, (uint8_t *)valueBytes,
+                                 valueLen, (time_t)ttl);
+    latency_end(LATENCY_PUT, started);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+    (*env)->ReleaseByteArrayElements(env, value, valueBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_Transaction_nativeGet(JNIEnv *env, jclass cls,
+                                                                    jlong handle, jlong cfHandle,
+                                                                    jbyteArray key,
+                                                                    jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    metric_add(METRIC_READS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_get(txn, cf, (uint8_t *)keyBytes, keyLen, &value, &valueLen);
+    latency_end_get(latencySlot, started);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
+    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
+    free(value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return resultArray;
+}
+
+/**
+ * Shared body of the caller-buffer get variants. Looks up a heap key and returns the engine's
+ * malloc'd value in *value (caller frees). Throws and returns non-zero on failure.
+ */
+static int txn_get_value(JNIEnv *env, jlong handle, jlong cfHandle, jbyteArray key,
+                         uint8_t **value, size_t *valueLen, jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+
+    metric_add(METRIC_READS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_get(txn, cf, (uint8_t *)keyBytes, keyLen, value, valueLen);
+    latency_end_get(latencySlot, started);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+    return result;
+}
+
+JNIEXPORT jint JNICALL Java_com_tidesdb_Transaction_nativeGetInto(JNIEnv *env, jclass cls,
+                                                                  jlong handle, jlong cfHandle,
+                                                                  jbyteArray key, jbyteArray dst,
+                                                                  jint dstOffset, jint dstLength,
+                                                                  jint latencySlot)
+{
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    if (txn_get_value(env, handle, cfHandle, key, &value, &valueLen, latencySlot) != TDB_SUCCESS)
+    {
+        return 0;
+    }
+
+    if (valueLen > INT32_MAX)
+    {
+        free(value);
+        throwTidesDBException(env, TDB_ERR_TOO_LARGE, getErrorMessage(TDB_ERR_TOO_LARGE));
+        return 0;
+    }
+
+    /* Too small: report the size needed without copying so the caller can retry */
+    if (valueLen > (size_t)dstLength)
+    {
+        free(value);
+        return -(jint)valueLen;
+    }
+
+    (*env)->SetByteArrayRegion(env, dst, dstOffset, (jsize)valueLen, (jbyte *)value);
+    free(value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return (jint)valueLen;
+}
+
+JNIEXPORT jint JNICALL Java_com_tidesdb_Transaction_nativeGetIntoDirect(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jbyteArray key, jobject dst,
+    jint dstOffset, jint dstLength, jint latencySlot)
+{
+    uint8_t *out = direct_buffer_region(env, dst, dstOffset, dstLength);
+    if (out == NULL)
+    {
+        return 0;
+    }
+
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    if (txn_get_value(env, handle, cfHandle, key, &value, &valueLen, latencySlot) != TDB_SUCCESS)
+    {
+        return 0;
+    }
+
+    if (valueLen > INT32_MAX)
+    {
+        free(value);
+        throwTidesDBException(env, TDB_ERR_TOO_LARGE, getErrorMessage(TDB_ERR_TOO_LARGE));
+        return 0;
+    }
+
+    if (valueLen > (size_t)dstLength)
+    {
+        free(value);
+        return -(jint)valueLen;
+    }
+
+    memcpy(out, value, valueLen);
+    free(value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return (jint)valueLen;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePutDirect(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jobject key, jint keyOffset,
+    jint keyLength, jobject value, jint valueOffset, jint valueLength, jlong ttl)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    uint8_t *keyBytes = direct_buffer_region(env, key, keyOffset, keyLength);
+    if (keyBytes == NULL)
+    {
+        return;
+    }
+    uint8_t *valueBytes = direct_buffer_region(env, value, valueOffset, valueLength);
+    if (valueBytes == NULL)
+    {
+        return;
+    }
+
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLength + (uint64_t)valueLength);
+
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_put(txn, cf, keyBytes, (size_t)keyLength, valueBytes,
+                                 (size_t)valueLength, (time_t)ttl);
+    latency_end(LATENCY_PUT, started);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_Transaction_nativeGetDirect(JNIEnv *env, jclass cls,
+                                                                          jlong handle,
+                                                                          jlong cfHandle,
+                                                                          jobject key,
+                                                                          jint keyOffset,
+                                                                          jint keyLength,
+                                                                          jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    uint8_t *keyBytes = direct_buffer_region(env, key, keyOffset, keyLength);
+    if (keyBytes == NULL)
+    {
+        return NULL;
+    }
+
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    metric_add(METRIC_READS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_get(txn, cf, keyBytes, (size_t)keyLength, &value, &valueLen);
+    latency_end_get(latencySlot, started);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
+    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
+    free(value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return resultArray;
+}
+
+/*
+ * Fixed-width key entry points. Long keys are encoded as 8 big-endian bytes and UUID keys as
+ * 16 (most significant half first) into a stack buffer, so no key array is allocated or
+ * pinned. The encoding sorts like the unsigned integer under bytewise and uint64_be order.
+ */
+#define UUID_KEY_SIZE 16
+
+static void txn_put_key(JNIEnv *env, jlong handle, jlong cfHandle, const uint8_t *key,
+                        size_t keyLen, jbyteArray value, jlong ttl)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize valueLen = (*env)->GetArrayLength(env, value);
+    jbyte *valueBytes = (*env)->GetByteArrayElements(env, value, NULL);
+
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLen + (uint64_t)valueLen);
+
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_put(txn, cf, key, keyLen, (uint8_t *)valueBytes, valueLen,
+                                 (time_t)ttl);
+    latency_end(LATENCY_PUT, started);
+
+    (*env)->ReleaseByteArrayElements(env, value, valueBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+static jbyteArray txn_get_key(JNIEnv *env, jlong handle, jlong cfHandle, const uint8_t *key,
+                              size_t keyLen, jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    metric_add(METRIC_READS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_get(txn, cf, key, keyLen, &value, &valueLen);
+    latency_end_get(latencySlot, started);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
+    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
+    free(value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return resultArray;
+}
+
+static void txn_delete_key(JNIEnv *env, jlong handle, jlong cfHandle, const uint8_t *key,
+                           size_t keyLen)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLen);
+
+    int result = tidesdb_txn_delete(txn, cf, key, keyLen);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+static inline void encode_uuid_key(uint8_t *p, jlong msb, jlong lsb)
+{
+    write_be64(p, (uint64_t)msb);
+    write_be64(p + 8, (uint64_t)lsb);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePutLong(JNIEnv *env, jclass cls,
+                                                                  jlong handle, jlong cfHandle,
+                                                                  jlong key, jbyteArray value,
+                                                                  jlong ttl)
+{
+    uint8_t k[8];
+    write_be64(k, (uint64_t)key);
+    txn_put_key(env, handle, cfHandle, k, sizeof(k), value, ttl);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePutUuid(JNIEnv *env, jclass cls,
+                                                                  jlong handle, jlong cfHandle,
+                                                                  jlong msb, jlong lsb,
+                                                                  jbyteArray value, jlong ttl)
+{
+    uint8_t k[UUID_KEY_SIZE];
+    encode_uuid_key(k, msb, lsb);
+    txn_put_key(env, handle, cfHandle, k, sizeof(k), value, ttl);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_Transaction_nativeGetLong(JNIEnv *env, jclass cls,
+                                                                        jlong handle,
+                                                                        jlong cfHandle, jlong key,
+                                                                        jint latencySlot)
+{
+    uint8_t k[8];
+    write_be64(k, (uint64_t)key);
+    return txn_get_key(env, handle, cfHandle, k, sizeof(k), latencySlot);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_Transaction_nativeGetUuid(JNIEnv *env, jclass cls,
+                                                                        jlong handle,
+                                                                        jlong cfHandle, jlong msb,
+                                                                        jlong lsb, jint latencySlot)
+{
+    uint8_t k[UUID_KEY_SIZE];
+    encode_uuid_key(k, msb, lsb);
+    return txn_get_key(env, handle, cfHandle, k, sizeof(k), latencySlot);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeDeleteLong(JNIEnv *env, jclass cls,
+                                                                     jlong handle, jlong cfHandle,
+                                                                     jlong key)
+{
+    uint8_t k[8];
+    write_be64(k, (uint64_t)key);
+    txn_delete_key(env, handle, cfHandle, k, sizeof(k));
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeDeleteUuid(JNIEnv *env, jclass cls,
+                                                                     jlong handle, jlong cfHandle,
+                                                                     jlong msb, jlong lsb)
+{
+    uint8_t k[UUID_KEY_SIZE];
+    encode_uuid_key(k, msb, lsb);
+    txn_delete_key(env, handle, cfHandle, k, sizeof(k));
+}
+
+/* Length written in place of a value in packed multiGet output when the key does not exist */
+#define MULTI_GET_NOT_FOUND (-1)
+
+/**
+ * One key of a multiGet batch. value is the engine's malloc'd result, NULL when not found.
+ */
+typedef struct
+{
+    const uint8_t *key;
+    size_t key_len;
+    uint8_t *value;
+    size_t value_len;
+} multi_get_entry_t;
+
+static int multi_get_entry_cmp(const void *a, const void *b)
+{
+    const multi_get_entry_t *ea = *(const multi_get_entry_t *const *)a;
+    const multi_get_entry_t *eb = *(const multi_get_entry_t *const *)b;
+    size_t n = ea->key_len < eb->key_len ? ea->key_len : eb->key_len;
+    int c = memcmp(ea->key, eb->key, n);
+    if (c != 0)
+    {
+        return c;
+    }
+    return ea->key_len < eb->key_len ? -1 : (ea->key_len > eb->key_len ? 1 : 0);
+}
+
+static void multi_get_free_values(multi_get_entry_t *entries, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        free(entries[i].value);
+        entries[i].value = NULL;
+    }
+}
+
+/**
+ * Resolves every entry under the transaction's snapshot. Keys are visited in sorted order so
+ * consecutive lookups hit neighbouring blocks; results stay in the caller's order. Returns
+ * TDB_SUCCESS, or the first error other than TDB_ERR_NOT_FOUND (values are freed on error).
+ */
+static int multi_get_resolve(tidesdb_txn_t *txn, tidesdb_column_family_t *cf,
+                             multi_get_entry_t *entries, int count, jint latencySlot)
+{
+    metric_add(METRIC_READS, (uint64_t)(count > 0 ? count : 0));
+
+    multi_get_entry_t **order = NULL;
+    if (count > 1)
+    {
+        order = malloc((size_t)count * sizeof(*order));
+    }
+    if (order != NULL)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            order[i] = &entries[i];
+        }
+        qsort(order, (size_t)count, sizeof(*order), multi_get_entry_cmp);
+    }
+
+    int rc = TDB_SUCCESS;
+    for (int i = 0; i < count; i++)
+    {
+        /* fall back to request order if the sort buffer could not be allocated */
+        multi_get_entry_t *e = order != NULL ? order[i] : &entries[i];
+        uint64_t started = latency_start();
+        int result = tidesdb_txn_get(txn, cf, e->key, e->key_len, &e->value, &e->value_len);
+        latency_end_get(latencySlot, started);
+        if (result == TDB_ERR_NOT_FOUND)
+        {
+            e->value = NULL;
+            e->value_len = 0;
+        }
+        else if (result != TDB_SUCCESS)
+        {
+            e->value = NULL;
+            rc = result;
+            break;
+        }
+    }
+
+    free(order);
+    if (rc != TDB_SUCCESS)
+    {
+        multi_get_free_values(entries, count);
+    }
+    return rc;
+}
+
+/**
+ * Copies the keys of a Java byte[][] into one arena so no Java array stays pinned while the
+ * engine runs. On success *entries and *arena must be freed by the caller; on failure an
+ * exception is pending and -1 is returned.
+ */
+static int multi_get_copy_keys(JNIEnv *env, jobjectArray keys, jsize count,
+                               multi_get_entry_t **entries, uint8_t **arena)
+{
+    *entries = calloc((size_t)(count > 0 ? count : 1), sizeof(**entries));
+    if (*entries == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return -1;
+    }
+
+    size_t total = 0;
+    for (jsize i = 0; i < count; i++)
+    {
+        jbyteArray k = (jbyteArray)(*env)->GetObjectArrayElement(env, keys, i);
+        (*entries)[i].key_len = (size_t)(*env)->GetArrayLength(env, k);
+        total += (*entries)[i].key_len;
+        (*env)->DeleteLocalRef(env, k);
+    }
+
+    *arena = malloc(total > 0 ? total : 1);
+    if (*arena == NULL)
+    {
+        free(*entries);
+        *entries = NULL;
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return -1;
+    }
+
+    size_t off = 0;
+    for (jsize i = 0; i < count; i++)
+    {
+        jbyteArray k = (jbyteArray)(*env)->GetObjectArrayElement(env, keys, i);
+        (*env)->GetByteArrayRegion(env, k, 0, (jsize)(*entries)[i].key_len,
+                                   (jbyte *)*arena + off);
+        (*env)->DeleteLocalRef(env, k);
+        (*entries)[i].key = *arena + off;
+        off += (*entries)[i].key_len;
+    }
+
+    return 0;
+}
+
+/**
+ * Builds the byte[][] result of a resolved batch, with null for keys that were not found.
+ * Returns NULL with an OutOfMemoryError pending if an array cannot be allocated.
+ */
+static jobjectArray multi_get_to_array(JNIEnv *env, const multi_get_entry_t *entries,
+                                       jsize count)
+{
+    jobjectArray values = (*env)->NewObjectArray(env, count, g_byte_array_class, NULL);
+    for (jsize i = 0; values != NULL && i < count; i++)
+    {
+        if (entries[i].value == NULL)
+        {
+            continue;
+        }
+        jbyteArray v = (*env)->NewByteArray(env, (jsize)entries[i].value_len);
+        if (v == NULL)
+        {
+            values = NULL; /* OutOfMemoryError pending */
+            break;
+        }
+        (*env)->SetByteArrayRegion(env, v, 0, (jsize)entries[i].value_len,
+                                   (jbyte *)entries[i].value);
+        (*env)->SetObjectArrayElement(env, values, i, v);
+        (*env)->DeleteLocalRef(env, v);
+    }
+    return values;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_tidesdb_Transaction_nativeMultiGet(JNIEnv *env, jclass cls,
+                                                                           jlong handle,
+                                                                           jlong cfHandle,
+                                                                           jobjectArray keys,
+                                                                           jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize count = (*env)->GetArrayLength(env, keys);
+    multi_get_entry_t *entries = NULL;
+    uint8_t *arena = NULL;
+    if (multi_get_copy_keys(env, keys, count, &entries, &arena) != 0)
+    {
+        return NULL;
+    }
+
+    int result = multi_get_resolve(txn, cf, entries, count, latencySlot);
+    if (result != TDB_SUCCESS)
+    {
+        free(arena);
+        free(entries);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jobjectArray values = multi_get_to_array(env, entries, count);
+
+    multi_get_free_values(entries, count);
+    free(arena);
+    free(entries);
+
+    return values;
+}
+
+/**
+ * multiGet over 8-byte big-endian keys. The long[] is copied out once and encoded into an
+ * arena, so neither the array nor per-key byte[]s are pinned or allocated.
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_tidesdb_Transaction_nativeMultiGetLongs(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jlongArray keys,
+    jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize count = (*env)->GetArrayLength(env, keys);
+    size_t slots = (size_t)(count > 0 ? count : 1);
+    multi_get_entry_t *entries = calloc(slots, sizeof(*entries));
+    jlong *raw = malloc(slots * sizeof(jlong));
+    uint8_t *arena = malloc(slots * 8);
+    if (entries == NULL || raw == NULL || arena == NULL)
+    {
+        free(entries);
+        free(raw);
+        free(arena);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
+    }
+
+    (*env)->GetLongArrayRegion(env, keys, 0, count, raw);
+    for (jsize i = 0; i < count; i++)
+    {
+        write_be64(arena + (size_t)i * 8, (uint64_t)raw[i]);
+        entries[i].key = arena + (size_t)i * 8;
+        entries[i].key_len = 8;
+    }
+    free(raw);
+
+    int result = multi_get_resolve(txn, cf, entries, count, latencySlot);
+    if (result != TDB_SUCCESS)
+    {
+        free(arena);
+        free(entries);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jobjectArray values = multi_get_to_array(env, entries, count);
+
+    multi_get_free_values(entries, count);
+    free(arena);
+    free(entries);
+
+    return values;
+}
+
+JNIEXPORT jint JNICALL Java_com_tidesdb_Transaction_nativeMultiGetPacked(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jobject keys, jint keysOffset,
+    jint keysLength, jint count, jobject out, jint outOffset, jint outLength, jint latencySlot)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    uint8_t *in = direct_buffer_region(env, keys, keysOffset, keysLength);
+    if (in == NULL)
+    {
+        return 0;
+    }
+    uint8_t *dst = direct_buffer_region(env, out, outOffset, outLength);
+    if (dst == NULL)
+    {
+        return 0;
+    }
+
+    multi_get_entry_t *entries = calloc((size_t)(count > 0 ? count : 1), sizeof(*entries));
+    if (entries == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return 0;
+    }
+
+    /* Keys are referenced in place: [int32 length][key bytes] repeated count times */
+    size_t pos = 0;
+    for (jint i = 0; i < count; i++)
+    {
+        if (pos + 4 > (size_t)keysLength)
+        {
+            free(entries);
+            throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "truncated multiGet key buffer");
+            return 0;
+        }
+        size_t len = read_be32(in + pos);
+        pos += 4;
+        if (len == 0 || len > (size_t)keysLength - pos)
+        {
+            free(entries);
+            throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "invalid multiGet key length");
+            return 0;
+        }
+        entries[i].key = in + pos;
+        entries[i].key_len = len;
+        pos += len;
+    }
+
+    int result = multi_get_resolve(txn, cf, entries, count, latencySlot);
+    if (result != TDB_SUCCESS)
+    {
+        free(entries);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    /* Results in request order: [int32 length][value bytes], length -1 when not found.
+       Stop at the first result that does not fit; the caller re-issues the remainder. */
+    size_t used = 0;
+    jint written = 0;
+    for (; written < count; written++)
+    {
+        multi_get_entry_t *e = &entries[written];
+        size_t need = 4 + (e->value != NULL ? e->value_len : 0);
+        if (need > (size_t)outLength - used)
+        {
+            break;
+        }
+        if (e->value == NULL)
+        {
+            write_be32(dst + used, (uint32_t)MULTI_GET_NOT_FOUND);
+        }
+        else
+        {
+            write_be32(dst + used, (uint32_t)e->value_len);
+            memcpy(dst + used + 4, e->value, e->value_len);
+        }
+        used += need;
+    }
+
+    multi_get_free_values(entries, count);
+    free(entries);
+
+    return written;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeDelete(JNIEnv *env, jclass cls,
+                                                                 jlong handle, jlong cfHandle,
+                                                                 jbyteArray key)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLen);
+
+    int result = tidesdb_txn_delete(txn, cf, (uint8_t *)keyBytes, keyLen);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeSingleDelete(JNIEnv *env, jclass cls,
+                                                                       jlong handle,
+                                                                       jlong cfHandle,
+                                                                       jbyteArray key)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+    metric_add(METRIC_WRITES, 1);
+    metric_add(METRIC_BYTES_IN, (uint64_t)keyLen);
+
+    int result = tidesdb_txn_single_delete(txn, cf, (uint8_t *)keyBytes, keyLen);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+/* Keys gathered per iterator pass; deletes are staged only after the iterator is freed */
+#define DELETE_RANGE_BATCH 1024
+
+/**
+ * Copies up to `max` keys visible to the transaction in [start, end) into keys/lens,
+ * resuming after `after` when it is set. A NULL `start` means the first key and a NULL `end`
+ * is unbounded. Both bounds are checked with the column family's comparator on every key, so
+ * the walk never strays outside the range whatever the seek lands on. Returns the number of
+ * keys copied or a TDB_ERR code.
+ */
+static int delete_range_collect(tidesdb_txn_t *txn, tidesdb_column_family_t *cf,
+                                tidesdb_comparator_fn cmp, const uint8_t *start,
+                                size_t startLen, const uint8_t *after, size_t afterLen,
+                                const uint8_t *end, size_t endLen, int max, uint8_t **keys,
+                                size_t *lens)
+{
+    tidesdb_iter_t *iter = NULL;
+    int result = tidesdb_iter_new(txn, cf, &iter);
+    if (result != TDB_SUCCESS)
+    {
+        return result;
+    }
+
+    if (after != NULL)
+    {
+        result = tidesdb_iter_seek(iter, after, afterLen);
+    }
+    else
+    {
+        result = start != NULL ? tidesdb_iter_seek(iter, start, startLen)
+                               : tidesdb_iter_seek_to_first(iter);
+    }
+    int n = 0;
+    while (result == TDB_SUCCESS && n < max && tidesdb_iter_valid(iter))
+    {
+        uint8_t *key = NULL;
+        size_t keyLen = 0;
+        result = tidesdb_iter_key(iter, &key, &keyLen);
+        if (result != TDB_SUCCESS)
+        {
+            break;
+        }
+        if (end != NULL && cmp(key, keyLen, end, endLen, NULL) >= 0)
+        {
+            break;
+        }
+        if ((start == NULL || cmp(key, keyLen, start, startLen, NULL) >= 0) &&
+            (after == NULL || cmp(key, keyLen, after, afterLen, NULL) > 0))
+        {
+            keys[n] = (uint8_t *)malloc(keyLen > 0 ? keyLen : 1);
+            if (keys[n] == NULL)
+            {
+                result = TDB_ERR_MEMORY;
+                break;
+            }
+            memcpy(keys[n], key, keyLen);
+            lens[n] = keyLen;
+            n++;
+        }
+        result = tidesdb_iter_next(iter);
+    }
+    tidesdb_iter_free(iter);
+
+    if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            free(keys[i]);
+        }
+        return result;
+    }
+    return n;
+}
+
+/**
+ * Tombstones up to `limit` keys in [start, end) in one native call. The range is walked in
+ * batches so the key copies stay bounded however many keys it covers. Returns the number of
+ * keys deleted and, when `lastKey` is given, stores the last of them in lastKey[0] so a
+ * caller committing in chunks can resume after it.
+ */
+JNIEXPORT jlong JNICALL Java_com_tidesdb_Transaction_nativeDeleteRange(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jbyteArray start, jbyteArray end,
+    jstring comparatorName, jlong limit, jobjectArray lastKey)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    const char *name =
+        comparatorName != NULL ? (*env)->GetStringUTFChars(env, comparatorName, NULL) : NULL;
+    tidesdb_comparator_fn cmp = key_order_for(name);
+    if (name != NULL)
+    {
+        (*env)->ReleaseStringUTFChars(env, comparatorName, name);
+    }
+    if (cmp == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS,
+                              "Range deletes are not supported for this comparator");
+        return 0;
+    }
+
+    jsize startLen = start != NULL ? (*env)->GetArrayLength(env, start) : 0;
+    jsize endLen = end != NULL ? (*env)->GetArrayLength(env, end) : 0;
+    uint8_t *startBytes = start != NULL ? (uint8_t *)malloc((size_t)startLen + 1) : NULL;
+    uint8_t *endBytes = end != NULL ? (uint8_t *)malloc((size_t)endLen + 1) : NULL;
+    uint8_t **keys = (uint8_t **)malloc(DELETE_RANGE_BATCH * sizeof(*keys));
+    size_t *lens = (size_t *)malloc(DELETE_RANGE_BATCH * sizeof(*lens));
+    if ((start != NULL && startBytes == NULL) || (end != NULL && endBytes == NULL) ||
+        keys == NULL || lens == NULL)
+    {
+        free(startBytes);
+        free(endBytes);
+        free(keys);
+        free(lens);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return 0;
+    }
+    if (start != NULL)
+    {
+        (*env)->GetByteArrayRegion(env, start, 0, startLen, (jbyte *)startBytes);
+    }
+    if (end != NULL)
+    {
+        (*env)->GetByteArrayRegion(env, end, 0, endLen, (jbyte *)endBytes);
+    }
+
+    /* `last` owns the last key deleted; each pass resumes after it */
+    uint8_t *last = NULL;
+    size_t lastLen = 0;
+    jlong deleted = 0;
+    int result = TDB_SUCCESS;
+    while (deleted < limit)
+    {
+        int max = limit - deleted < DELETE_RANGE_BATCH ? (int)(limit - deleted)
+                                                       : DELETE_RANGE_BATCH;
+        int n = delete_range_collect(txn, cf, cmp, startBytes, (size_t)startLen, last, lastLen,
+                                     endBytes, (size_t)endLen, max, keys, lens);
+        if (n < 0)
+        {
+            result = n;
+            break;
+        }
+
+        int collected = n;
+        int done = 0;
+        for (; done < n && result == TDB_SUCCESS; done++)
+        {
+            metric_add(METRIC_WRITES, 1);
+            metric_add(METRIC_BYTES_IN, (uint64_t)lens[done]);
+            result = tidesdb_txn_delete(txn, cf, keys[done], lens[done]);
+        }
+        if (result == TDB_SUCCESS && n > 0)
+        {
+            deleted += n;
+            free(last);
+            last = keys[n - 1];
+            lastLen = lens[n - 1];
+            n--;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            free(keys[i]);
+        }
+        if (result != TDB_SUCCESS || collected < max)
+        {
+            break;
+        }
+    }
+
+    free(startBytes);
+    free(endBytes);
+    free(keys);
+    free(lens);
+
+    if (result != TDB_SUCCESS)
+    {
+        free(last);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+    if (lastKey != NULL && last != NULL)
+    {
+        jbyteArray key = (*env)->NewByteArray(env, (jsize)lastLen);
+        if (key != NULL)
+        {
+            (*env)->SetByteArrayRegion(env, key, 0, (jsize)lastLen, (jbyte *)last);
+            (*env)->SetObjectArrayElement(env, lastKey, 0, key);
+            (*env)->DeleteLocalRef(env, key);
+        }
+    }
+    free(last);
+    return deleted;
+}
+
+/* WriteBatch op codes, mirrored in WriteBatch.java */
+#define WRITE_BATCH_OP_PUT           0
+#define WRITE_BATCH_OP_DELETE        1
+#define WRITE_BATCH_OP_SINGLE_DELETE 2
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeWriteBatch(JNIEnv *env, jclass cls,
+                                                                     jlong handle, jobject batch,
+                                                                     jint length, jint count,
+                                                                     jboolean commit)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+
+    uint8_t *in = direct_buffer_region(env, batch, 0, length);
+    if (in == NULL)
+    {
+        return;
+    }
+    metric_add(METRIC_WRITES, (uint64_t)(count > 0 ? count : 0));
+    metric_add(METRIC_BYTES_IN, (uint64_t)length);
+
+    /* Each op: [u8 op][int64 cf handle][int32 key length][key], puts then append
+       [int32 value length][value][int64 ttl]. All integers big-endian. */
+    size_t end = (size_t)length;
+    size_t pos = 0;
+    for (jint i = 0; i < count; i++)
+    {
+        if (end - pos < 1 + 8 + 4)
+        {
+            throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "truncated write batch");
+            return;
+        }
+        uint8_t op = in[pos];
+        tidesdb_column_family_t *cf =
+            (tidesdb_column_family_t *)(uintptr_t)read_be64(in + pos + 1);
+        size_t keyLen = read_be32(in + pos + 9);
+        pos += 13;
+        if (keyLen == 0 || keyLen > end - pos)
+        {
+            throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "invalid write batch key length");
+            return;
+        }
+        const uint8_t *keyBytes = in + pos;
+        pos += keyLen;
+
+        int result;
+        switch (op)
+        {
+            case WRITE_BATCH_OP_PUT:
+            {
+                if (end - pos < 4)
+                {
+                    throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "truncated write batch");
+                    return;
+                }
+                size_t valueLen = read_be32(in + pos);
+                pos += 4;
+                if (valueLen > end - pos || end - pos - valueLen < 8)
+                {
+                    throwTidesDBException(env, TDB_ERR_INVALID_ARGS,
+                                          "invalid write batch value length");
+                    return;
+                }
+                const uint8_t *valueBytes = in + pos;
+                pos += valueLen;
+                int64_t ttl = (int64_t)read_be64(in + pos);
+                pos += 8;
+                uint64_t started = latency_start();
+                result = tidesdb_txn_put(txn, cf, keyBytes, keyLen, valueBytes, valueLen,
+                                         (time_t)ttl);
+                latency_end(LATENCY_PUT, started);
+                break;
+            }
+            case WRITE_BATCH_OP_DELETE:
+                result = tidesdb_txn_delete(txn, cf, keyBytes, keyLen);
+                break;
+            case WRITE_BATCH_OP_SINGLE_DELETE:
+                result = tidesdb_txn_single_delete(txn, cf, keyBytes, keyLen);
+                break;
+            default:
+                throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "unknown write batch op");
+                return;
+        }
+
+        if (result != TDB_SUCCESS)
+        {
+            throwTidesDBException(env, result, getErrorMessage(result));
+            return;
+        }
+    }
+
+    if (commit)
+    {
+        metric_add(METRIC_COMMITS, 1);
+        uint64_t started = latency_start();
+        int result = tidesdb_txn_commit(txn);
+        latency_end(LATENCY_COMMIT, started);
+        if (result != TDB_SUCCESS)
+        {
+            throwTidesDBException(env, result, getErrorMessage(result));
+        }
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeCommit(JNIEnv *env, jclass cls,
+                                                                 jlong handle)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    metric_add(METRIC_COMMITS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_txn_commit(txn);
+    latency_end(LATENCY_COMMIT, started);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeRollback(JNIEnv *env, jclass cls,
+                                                                   jlong handle)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    int result = tidesdb_txn_rollback(txn);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeSavepoint(JNIEnv *env, jclass cls,
+                                                                    jlong handle, jstring name)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
+
+    int result = tidesdb_txn_savepoint(txn, spName);
+
+    (*env)->ReleaseStringUTFChars(env, name, spName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeRollbackToSavepoint(JNIEnv *env,
+                                                                              jclass cls,
+                                                                              jlong handle,
+                                                                              jstring name)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
+
+    int result = tidesdb_txn_rollback_to_savepoint(txn, spName);
+
+    (*env)->ReleaseStringUTFChars(env, name, spName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeReleaseSavepoint(JNIEnv *env, jclass cls,
+                                                                           jlong handle,
+                                                                           jstring name)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
+
+    int result = tidesdb_txn_release_savepoint(txn, spName);
+
+    (*env)->ReleaseStringUTFChars(env, name, spName);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+/**
+ * Native side of a TidesDBIterator handle. Wraps the engine iterator with optional key
+ * bounds so range scans stop in C rather than pulling every key into Java to compare.
+ * The lower bound is inclusive, the upper bound exclusive; an absent bound has a NULL
+ * pointer. Bounds are compared in the column family's key order and share one allocation
+ * with the struct.
+ */
+typedef struct
+{
+    tidesdb_iter_t *iter;
+    tidesdb_comparator_fn cmp;
+    uint8_t *lower;
+    size_t lower_len;
+    uint8_t *upper;
+    size_t upper_len;
+} jni_iter_t;
+
+/**
+ * Returns TDB_SUCCESS when the iterator sits on an entry inside its bounds, and
+ * TDB_ERR_NOT_FOUND when the engine iterator is exhausted or has moved past a bound.
+ */
+static int jni_iter_check(jni_iter_t *it)
+{
+    if (!tidesdb_iter_valid(it->iter))
+    {
+        return TDB_ERR_NOT_FOUND;
+    }
+    if (it->lower == NULL && it->upper == NULL)
+    {
+        return TDB_SUCCESS;
+    }
+
+    uint8_t *key = NULL;
+    size_t keyLen = 0;
+    int result = tidesdb_iter_key(it->iter, &key, &keyLen);
+    if (result != TDB_SUCCESS)
+    {
+        return result;
+    }
+    if (it->lower != NULL && it->cmp(key, keyLen, it->lower, it->lower_len, NULL) < 0)
+    {
+        return TDB_ERR_NOT_FOUND;
+    }
+    if (it->upper != NULL && it->cmp(key, keyLen, it->upper, it->upper_len, NULL) >= 0)
+    {
+        return TDB_ERR_NOT_FOUND;
+    }
+    return TDB_SUCCESS;
+}
+
+/* Positions at the last entry strictly below the upper bound */
+static int jni_iter_seek_below_upper(jni_iter_t *it)
+{
+    int result = tidesdb_iter_seek_for_prev(it->iter, it->upper, it->upper_len);
+    if (result != TDB_SUCCESS || !tidesdb_iter_valid(it->iter))
+    {
+        return result;
+    }
+
+    uint8_t *key = NULL;
+    size_t keyLen = 0;
+    result = tidesdb_iter_key(it->iter, &key, &keyLen);
+    if (result != TDB_SUCCESS)
+    {
+        return result;
+    }
+    if (it->cmp(key, keyLen, it->upper, it->upper_len, NULL) >= 0)
+    {
+        result = tidesdb_iter_prev(it->iter);
+        if (result == TDB_ERR_NOT_FOUND)
+        {
+            result = TDB_SUCCESS;
+        }
+    }
+    return result;
+}
+
+/* Seeking to the lower bound instead of the first key lets the engine skip whole
+   SSTables and blocks through its block index rather than scanning up to the range. */
+static int jni_iter_seek(jni_iter_t *it, const uint8_t *key, size_t keyLen)
+{
+    if (it->lower != NULL && it->cmp(key, keyLen, it->lower, it->lower_len, NULL) < 0)
+    {
+        key = it->lower;
+        keyLen = it->lower_len;
+    }
+    return tidesdb_iter_seek(it->iter, key, keyLen);
+}
+
+static int jni_iter_seek_for_prev(jni_iter_t *it, const uint8_t *key, size_t keyLen)
+{
+    if (it->upper != NULL && it->cmp(key, keyLen, it->upper, it->upper_len, NULL) >= 0)
+    {
+        return jni_iter_seek_below_upper(it);
+    }
+    return tidesdb_iter_seek_for_prev(it->iter, key, keyLen);
+}
+
+static jlong jni_iter_new(JNIEnv *env, tidesdb_txn_t *txn, tidesdb_column_family_t *cf,
+                          jbyteArray lower, jbyteArray upper, jstring comparatorName)
+{
+    tidesdb_comparator_fn cmp = bytewise_order_cmp;
+    if (lower != NULL || upper != NULL)
+    {
+        const char *name =
+            comparatorName != NULL ? (*env)->GetStringUTFChars(env, comparatorName, NULL) : NULL;
+        cmp = key_order_for(name);
+        if (name != NULL)
+        {
+            (*env)->ReleaseStringUTFChars(env, comparatorName, name);
+        }
+        if (cmp == NULL)
+        {
+            throwTidesDBException(env, TDB_ERR_INVALID_ARGS,
+                                  "Key bounds are not supported for this comparator");
+            return 0;
+        }
+    }
+
+    jsize lowerLen = lower != NULL ? (*env)->GetArrayLength(env, lower) : 0;
+    jsize upperLen = upper != NULL ? (*env)->GetArrayLength(env, upper) : 0;
+
+    jni_iter_t *it = malloc(sizeof(*it) + (size_t)lowerLen + (size_t)upperLen);
+    if (it == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return 0;
+    }
+
+    uint8_t *bounds = (uint8_t *)(it + 1);
+    it->cmp = cmp;
+    it->lower = NULL;
+    it->lower_len = 0;
+    it->upper = NULL;
+    it->upper_len = 0;
+    if (lower != NULL)
+    {
+        it->lower = bounds;
+        it->lower_len = (size_t)lowerLen;
+        (*env)->GetByteArrayRegion(env, lower, 0, lowerLen, (jbyte *)it->lower);
+    }
+    if (upper != NULL)
+    {
+        it->upper = bounds + lowerLen;
+        it->upper_len = (size_t)upperLen;
+        (*env)->GetByteArrayRegion(env, upper, 0, upperLen, (jbyte *)it->upper);
+    }
+
+    it->iter = NULL;
+    int result = tidesdb_iter_new(txn, cf, &it->iter);
+    if (result != TDB_SUCCESS)
+    {
+        free(it);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return 0;
+    }
+
+    return (jlong)(uintptr_t)it;
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_Transaction_nativeNewIterator(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jlong cfHandle)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    return jni_iter_new(env, txn, cf, NULL, NULL, NULL);
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_Transaction_nativeNewBoundedIterator(
+    JNIEnv *env, jclass cls, jlong handle, jlong cfHandle, jbyteArray lowerBound,
+    jbyteArray upperBound, jstring comparatorName)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    return jni_iter_new(env, txn, cf, lowerBound, upperBound, comparatorName);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeReset(JNIEnv *env, jclass cls,
+                                                                jlong handle, jint isolationLevel)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    int result = tidesdb_txn_reset(txn, (tidesdb_isolation_level_t)isolationLevel);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+/* Reuses a pooled txn in one crossing: a txn left active by its previous owner fails the
+ * reset, so roll it back and retry. Never throws; JNI_FALSE tells the pool to free it. */
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_Transaction_nativeRecycle(JNIEnv *env, jclass cls,
+                                                                      jlong handle,
+                                                                      jint isolationLevel)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_isolation_level_t level = (tidesdb_isolation_level_t)isolationLevel;
+
+    if (tidesdb_txn_reset(txn, level) == TDB_SUCCESS)
+    {
+        return JNI_TRUE;
+    }
+    if (tidesdb_txn_rollback(txn) != TDB_SUCCESS)
+    {
+        return JNI_FALSE;
+    }
+    return tidesdb_txn_reset(txn, level) == TDB_SUCCESS ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeFree(JNIEnv *env, jclass cls,
+                                                               jlong handle)
+{
+    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    if (txn != NULL)
+    {
+        tidesdb_txn_free(txn);
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekToFirst(JNIEnv *env, jclass cls,
+                                                                          jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    int result = it->lower != NULL ? tidesdb_iter_seek(it->iter, it->lower, it->lower_len)
+                                   : tidesdb_iter_seek_to_first(it->iter);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekToLast(JNIEnv *env, jclass cls,
+                                                                         jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    int result = it->upper != NULL ? jni_iter_seek_below_upper(it)
+                                   : tidesdb_iter_seek_to_last(it->iter);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeek(JNIEnv *env, jclass cls,
+                                                                   jlong handle, jbyteArray key)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+
+    int result = jni_iter_seek(it, (uint8_t *)keyBytes, (size_t)keyLen);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekForPrev(JNIEnv *env, jclass cls,
+                                                                          jlong handle,
+                                                                          jbyteArray key)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+
+    int result = jni_iter_seek_for_prev(it, (uint8_t *)keyBytes, (size_t)keyLen);
+
+    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekLong(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jlong key,
+                                                                       jboolean forPrev)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t k[8];
+    write_be64(k, (uint64_t)key);
+
+    int result = forPrev ? jni_iter_seek_for_prev(it, k, sizeof(k))
+                         : jni_iter_seek(it, k, sizeof(k));
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekUuid(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jlong msb,
+                                                                       jlong lsb, jboolean forPrev)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t k[UUID_KEY_SIZE];
+    encode_uuid_key(k, msb, lsb);
+
+    int result = forPrev ? jni_iter_seek_for_prev(it, k, sizeof(k))
+                         : jni_iter_seek(it, k, sizeof(k));
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekDirect(JNIEnv *env, jclass cls,
+                                                                         jlong handle, jobject key,
+                                                                         jint keyOffset,
+                                                                         jint keyLength)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t *keyBytes = direct_buffer_region(env, key, keyOffset, keyLength);
+    if (keyBytes == NULL)
+    {
+        return;
+    }
+
+    int result = jni_iter_seek(it, keyBytes, (size_t)keyLength);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekForPrevDirect(
+    JNIEnv *env, jclass cls, jlong handle, jobject key, jint keyOffset, jint keyLength)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t *keyBytes = direct_buffer_region(env, key, keyOffset, keyLength);
+    if (keyBytes == NULL)
+    {
+        return;
+    }
+
+    int result = jni_iter_seek_for_prev(it, keyBytes, (size_t)keyLength);
+
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_TidesDBIterator_nativeValid(JNIEnv *env, jclass cls,
+                                                                        jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    return jni_iter_check(it) == TDB_SUCCESS;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeNext(JNIEnv *env, jclass cls,
+                                                                   jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    metric_add(METRIC_ITERATOR_STEPS, 1);
+    uint64_t started = latency_start();
+    int result = tidesdb_iter_next(it->iter);
+    latency_end(LATENCY_ITERATOR_NEXT, started);
+
+    /* TDB_ERR_NOT_FOUND is expected when reaching end of iteration -- iterator becomes invalid */
+    if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativePrev(JNIEnv *env, jclass cls,
+                                                                   jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    metric_add(METRIC_ITERATOR_STEPS, 1);
+    int result = tidesdb_iter_prev(it->iter);
+
+    /* TDB_ERR_NOT_FOUND is expected when reaching start of iteration -- iterator becomes invalid */
+    if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_TidesDBIterator_nativeKey(JNIEnv *env, jclass cls,
+                                                                        jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t *key = NULL;
+    size_t keyLen = 0;
+
+    int result = jni_iter_check(it);
+    if (result == TDB_SUCCESS)
+    {
+        result = tidesdb_iter_key(it->iter, &key, &keyLen);
+    }
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jbyteArray resultArray = (*env)->NewByteArray(env, keyLen);
+    (*env)->SetByteArrayRegion(env, resultArray, 0, keyLen, (jbyte *)key);
+    metric_add(METRIC_BYTES_OUT, keyLen);
+
+    return resultArray;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_TidesDBIterator_nativeValue(JNIEnv *env, jclass cls,
+                                                                          jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t *value = NULL;
+    size_t valueLen = 0;
+
+    int result = jni_iter_check(it);
+    if (result == TDB_SUCCESS)
+    {
+        result = tidesdb_iter_value(it->iter, &value, &valueLen);
+    }
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
+    }
+
+    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
+    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
+    metric_add(METRIC_BYTES_OUT, valueLen);
+
+    return resultArray;
+}
+
+JNIEXPORT jint JNICALL Java_com_tidesdb_TidesDBIterator_nativeNextBatch(JNIEnv *env, jclass cls,
+                                                                        jlong handle, jobject out,
+                                                                        jint outOffset,
+                                                                        jint outLength,
+                                                                        jint maxEntries)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+
+    uint8_t *dst = direct_buffer_region(env, out, outOffset, outLength);
+    if (dst == NULL)
+    {
+        return 0;
+    }
+
+    /* Entries: [int32 key length][key][int32 value length][value], starting from the
+       entry the iterator is positioned at. The iterator is advanced past every entry
+       written, so the next call resumes where this one stopped. */
+    size_t used = 0;
+    jint written = 0;
+    while (written < maxEntries)
+    {
+        uint8_t *key = NULL;
+        size_t keyLen = 0;
+        uint8_t *value = NULL;
+        size_t valueLen = 0;
+
+        int result = jni_iter_check(it);
+        if (result == TDB_ERR_NOT_FOUND)
+        {
+            break;
+        }
+        if (result == TDB_SUCCESS)
+        {
+            result = tidesdb_iter_key_value(it->iter, &key, &keyLen, &value, &valueLen);
+        }
+        if (result != TDB_SUCCESS)
+        {
+            throwTidesDBException(env, result, getErrorMessage(result));
+            return 0;
+        }
+
+        size_t need = 4 + keyLen + 4 + valueLen;
+        if (need > (size_t)outLength - used)
+        {
+            if (written == 0)
+            {
+                /* Not even one entry fits; report the size needed so the caller can grow */
+                if (need > INT32_MAX)
+                {
+                    throwTidesDBException(env, TDB_ERR_TOO_LARGE,
+                                          getErrorMessage(TDB_ERR_TOO_LARGE));
+                    return 0;
+                }
+                return -(jint)need;
+            }
+            break;
+        }
+
+        write_be32(dst + used, (uint32_t)keyLen);
+        memcpy(dst + used + 4, key, keyLen);
+        used += 4 + keyLen;
+        write_be32(dst + used, (uint32_t)valueLen);
+        memcpy(dst + used + 4, value, valueLen);
+        used += 4 + valueLen;
+        written++;
+
+        uint64_t started = latency_start();
+        result = tidesdb_iter_next(it->iter);
+        latency_end(LATENCY_ITERATOR_NEXT, started);
+        if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
+        {
+            throwTidesDBException(env, result, getErrorMessage(result));
+            return 0;
+        }
+    }
+
+    metric_add(METRIC_ITERATOR_STEPS, (uint64_t)written);
+    metric_add(METRIC_BYTES_OUT, used);
+    return written;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeFree(JNIEnv *env, jclass cls,
+                                                                   jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    if (it != NULL)
+    {
+        tidesdb_iter_free(it->iter);
+        free(it);
+    }
+}
+
+#define EXPIRY_MAX_BUCKETS 4096
+#define EXPIRY_MIN_SLOTS   1024
+#define EXPIRY_MAX_KEYS    (1u << 20)
+
+/**
+ * Owned copy of a key bounding the keys of an expiry bucket.
+ */
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+} expiry_key_t;
+
+/**
+ * Keys written with the same expiration second. Bounds are bytewise; when a bound could not
+ * be copied the bucket is marked unbounded and a sweep compacts the whole column family.
+ */
+typedef struct
+{
+    int64_t expires_at;
+    uint64_t count;
+    uint64_t bytes;
+    expiry_key_t min;
+    expiry_key_t max;
+    int unbounded;
+} expiry_bucket_t;
+
+/**
+ * A key still waiting to expire, held as a 64-bit hash of its bytes. hash 0 marks a free slot.
+ */
+typedef struct
+{
+    uint64_t hash;
+    int64_t expires_at;
+} expiry_slot_t;
+
+/**
+ * Per column family index of TTL writes, fed by the commit hook trampolines. Buckets are kept
+ * sorted by expiration and folded into the expired totals once their second has passed.
+ * Tracked keys are also kept in a linear-probing hash table, so overwriting, refreshing or
+ * deleting a key before it expires takes it back out of its bucket. The table holds at most
+ * EXPIRY_MAX_KEYS keys; writes beyond that are counted without their key and, like hash
+ * collisions, keep the counts an upper bound.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    expiry_bucket_t *buckets;
+    int num_buckets;
+    int64_t folded_through; /* buckets expiring at or before this second are folded */
+    expiry_slot_t *keys;
+    size_t key_slots;
+    size_t num_keys;
+    uint64_t tracked;
+    uint64_t expired;
+    uint64_t expired_bytes;
+    expiry_key_t expired_min;
+    expiry_key_t expired_max;
+    int expired_unbounded;
+} expiry_index_t;
+
+static int expiry_key_cmp(const uint8_t *a, size_t a_size, const uint8_t *b, size_t b_size)
+{
+    size_t n = a_size < b_size ? a_size : b_size;
+    int c = n > 0 ? memcmp(a, b, n) : 0;
+    if (c != 0)
+        return c;
+    return a_size < b_size ? -1 : (a_size > b_size ? 1 : 0);
+}
+
+static int expiry_key_set(expiry_key_t *k, const uint8_t *key, size_t size)
+{
+    uint8_t *data = (uint8_t *)realloc(k->data, size > 0 ? size : 1);
+    if (data == NULL)
+        return -1;
+    memcpy(data, key, size);
+    k->data = data;
+    k->size = size;
+    return 0;
+}
+
+static void expiry_key_free(expiry_key_t *k)
+{
+    free(k->data);
+    k->data = NULL;
+    k->size = 0;
+}
+
+/**
+ * Widens [min, max] to include key. Returns -1 if a bound could not be copied.
+ */
+static int expiry_widen(expiry_key_t *min, expiry_key_t *max, uint64_t had,
+                        const uint8_t *key, size_t size)
+{
+    int rc = 0;
+    if (had == 0 || expiry_key_cmp(key, size, min->data, min->size) < 0)
+        rc |= expiry_key_set(min, key, size);
+    if (had == 0 || expiry_key_cmp(key, size, max->data, max->size) > 0)
+        rc |= expiry_key_set(max, key, size);
+    return rc;
+}
+
+/**
+ * Finds the bucket for expires_at, inserting it while there is room. A full index hands out
+ * the next later bucket instead, or moves the last bucket later, so keys are never counted as
+ * expired early.
+ */
+static expiry_bucket_t *expiry_bucket_for(expiry_index_t *ex, int64_t expires_at)
+{
+    int lo = 0;
+    int hi = ex->num_buckets;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (ex->buckets[mid].expires_at < expires_at)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < ex->num_buckets && ex->buckets[lo].expires_at == expires_at)
+        return &ex->buckets[lo];
+
+    if (ex->num_buckets == EXPIRY_MAX_BUCKETS)
+    {
+        if (lo < ex->num_buckets)
+            return &ex->buckets[lo];
+        expiry_bucket_t *last = &ex->buckets[ex->num_buckets - 1];
+        last->expires_at = expires_at;
+        return last;
+    }
+
+    if (ex->buckets == NULL)
+    {
+        ex->buckets = (expiry_bucket_t *)malloc(EXPIRY_MAX_BUCKETS * sizeof(expiry_bucket_t));
+        if (ex->buckets == NULL)
+            return NULL;
+    }
+    memmove(&ex->buckets[lo + 1], &ex->buckets[lo],
+            (size_t)(ex->num_buckets - lo) * sizeof(expiry_bucket_t));
+    memset(&ex->buckets[lo], 0, sizeof(expiry_bucket_t));
+    ex->buckets[lo].expires_at = expires_at;
+    ex->num_buckets++;
+    return &ex->buckets[lo];
+}
+
+/** FNV-1a with a final avalanche, never 0 so 0 can mark a free slot. */
+static uint64_t expiry_key_hash(const uint8_t *key, size_t size)
+{
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= key[i];
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h != 0 ? h : 1;
+}
+
+/** Returns the slot holding hash, or key_slots if it is not tracked. */
+static size_t expiry_keys_find(const expiry_index_t *ex, uint64_t hash)
+{
+    size_t mask = ex->key_slots - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        if (ex->keys[i].hash == hash)
+            return i;
+        if (ex->keys[i].hash == 0)
+            return ex->key_slots;
+    }
+}
+
+/** Frees slot i, shifting back later entries of its probe run so lookups still find them. */
+static void expiry_keys_remove_at(expiry_index_t *ex, size_t i)
+{
+    size_t mask = ex->key_slots - 1;
+    size_t hole = i;
+    for (size_t j = (i + 1) & mask; ex->keys[j].hash != 0; j = (j + 1) & mask)
+    {
+        size_t home = ex->keys[j].hash & mask;
+        /* move j into the hole unless its home lies cyclically in (hole, j] */
+        if (((j - home) & mask) >= ((j - hole) & mask))
+        {
+            ex->keys[hole] = ex->keys[j];
+            hole = j;
+        }
+    }
+    ex->keys[hole].hash = 0;
+    ex->num_keys--;
+}
+
+static void expiry_keys_insert(expiry_slot_t *keys, size_t slots, uint64_t hash,
+                               int64_t expires_at)
+{
+    size_t mask = slots - 1;
+    size_t i = hash & mask;
+    while (keys[i].hash != 0)
+        i = (i + 1) & mask;
+    keys[i].hash = hash;
+    keys[i].expires_at = expires_at;
+}
+
+/**
+ * Rebuilds the table with room for slots entries, dropping keys that expired at or before
+ * drop_through. Returns -1, leaving the table as it was, if it cannot be allocated.
+ */
+static int expiry_keys_rebuild(expiry_index_t *ex, size_t slots, int64_t drop_through)
+{
+    expiry_slot_t *keys = (expiry_slot_t *)calloc(slots, sizeof(expiry_slot_t));
+    if (keys == NULL)
+        return -1;
+    size_t kept = 0;
+    for (size_t i = 0; i < ex->key_slots; i++)
+    {
+        if (ex->keys[i].hash != 0 && ex->keys[i].expires_at > drop_through)
+        {
+            expiry_keys_insert(keys, slots, ex->keys[i].hash, ex->keys[i].expires_at);
+            kept++;
+        }
+    }
+    free(ex->keys);
+    ex->keys = keys;
+    ex->key_slots = slots;
+    ex->num_keys = kept;
+    return 0;
+}
+
+/**
+ * Takes a superseded write back out of the bucket it was counted in. Writes whose second has
+ * already been folded stay counted: the old version is expired garbage until compacted.
+ */
+static void expiry_unbucket(expiry_index_t *ex, int64_t expires_at)
+{
+    if (expires_at <= ex->folded_through)
+        return;
+    int lo = 0;
+    int hi = ex->num_buckets;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (ex->buckets[mid].expires_at < expires_at)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    /* a full index may have counted the write in a later bucket, never an earlier one */
+    if (lo == ex->num_buckets || ex->buckets[lo].count == 0)
+        return;
+    expiry_bucket_t *b = &ex->buckets[lo];
+    b->bytes -= b->bytes / b->count;
+    b->count--;
+    ex->tracked--;
+}
+
+/**
+ * Records the TTL puts of one commit and retires tracked keys the commit overwrites or
+ * deletes. Called from the commit hook trampolines.
+ */
+static void expiry_record(expiry_index_t *ex, const tidesdb_commit_op_t *ops, int num_ops)
+{
+    int locked = 0;
+    for (int i = 0; i < num_ops; i++)
+    {
+        int ttl_put = !ops[i].is_delete && ops[i].ttl > 0;
+        if (!locked)
+        {
+            pthread_mutex_lock(&ex->lock);
+            locked = 1;
+        }
+        if (!ttl_put && ex->num_keys == 0)
+            continue;
+
+        uint64_t hash = expiry_key_hash(ops[i].key, ops[i].key_size);
+        if (ex->num_keys > 0)
+        {
+            size_t slot = expiry_keys_find(ex, hash);
+            if (slot < ex->key_slots)
+            {
+                expiry_unbucket(ex, ex->keys[slot].expires_at);
+                expiry_keys_remove_at(ex, slot);
+            }
+        }
+        if (!ttl_put)
+            continue;
+
+        expiry_bucket_t *b = expiry_bucket_for(ex, (int64_t)ops[i].ttl);
+        if (b == NULL)
+            continue;
+        if (expiry_widen(&b->min, &b->max, b->count, ops[i].key, ops[i].key_size) != 0)
+            b->unbounded = 1;
+        b->count++;
+        b->bytes += ops[i].key_size + ops[i].value_size;
+        ex->tracked++;
+
+        if (ex->num_keys < EXPIRY_MAX_KEYS &&
+            ((ex->num_keys + 1) * 2 <= ex->key_slots ||
+             expiry_keys_rebuild(ex, ex->key_slots > 0 ? ex->key_slots * 2 : EXPIRY_MIN_SLOTS,
+                                 INT64_MIN) == 0))
+        {
+            expiry_keys_insert(ex->keys, ex->key_slots, hash, (int64_t)ops[i].ttl);
+            ex->num_keys++;
+        }
+    }
+    if (locked)
+        pthread_mutex_unlock(&ex->lock);
+}
+
+/**
+ * Moves every bucket that has expired by now into the expired totals. Caller holds the lock.
+ */
+static void expiry_fold(expiry_index_t *ex, int64_t now)
+{
+    if (now > ex->folded_through)
+        ex->folded_through = now;
+    int folded = 0;
+    while (folded < ex->num_buckets && ex->buckets[folded].expires_at <= now)
+    {
+        expiry_bucket_t *b = &ex->buckets[folded];
+        if (b->unbounded ||
+            expiry_widen(&ex->expired_min, &ex->expired_max, ex->expired, b->min.data,
+                         b->min.size) != 0 ||
+            expiry_widen(&ex->expired_min, &ex->expired_max, 1, b->max.data, b->max.size) != 0)
+        {
+            ex->expired_unbounded = 1;
+        }
+        ex->expired += b->count;
+        ex->expired_bytes += b->bytes;
+        ex->tracked -= b->count;
+        expiry_key_free(&b->min);
+        expiry_key_free(&b->max);
+        folded++;
+    }
+    if (folded > 0)
+    {
+        memmove(&ex->buckets[0], &ex->buckets[folded],
+                (size_t)(ex->num_buckets - folded) * sizeof(expiry_bucket_t));
+        ex->num_buckets -= folded;
+    }
+}
+
+static jbyteArray expiry_key_to_java(JNIEnv *env, const expiry_key_t *k)
+{
+    jbyteArray arr = (*env)->NewByteArray(env, (jsize)k->size);
+    if (arr != NULL && k->size > 0)
+        (*env)->SetByteArrayRegion(env, arr, 0, (jsize)k->size, (const jbyte *)k->data);
+    return arr;
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamily_nativeExpiryIndexCreate(JNIEnv *env,
+                                                                               jclass cls)
+{
+    expiry_index_t *ex = (expiry_index_t *)calloc(1, sizeof(expiry_index_t));
+    if (ex == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate expiry index");
+        return 0;
+    }
+    pthread_mutex_init(&ex->lock, NULL);
+    return (jlong)(uintptr_t)ex;
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeExpiryIndexFree(JNIEnv *env,
+                                                                           jclass cls,
+                                                                           jlong handle)
+{
+    expiry_index_t *ex = (expiry_index_t *)(uintptr_t)handle;
+    if (ex == NULL)
+        return;
+    for (int i = 0; i < ex->num_buckets; i++)
+    {
+        expiry_key_free(&ex->buckets[i].min);
+        expiry_key_free(&ex->buckets[i].max);
+    }
+    expiry_key_free(&ex->expired_min);
+    expiry_key_free(&ex->expired_max);
+    free(ex->buckets);
+    free(ex->keys);
+    pthread_mutex_destroy(&ex->lock);
+    free(ex);
+}
+
+/**
+ * Folds buckets expired by now and writes {tracked, expired, expiredBytes} into out. Returns
+ * {min, max} of the expired keys, or NULL when nothing has expired or the range is unknown.
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_tidesdb_ColumnFamily_nativeExpiryIndexPeek(
+    JNIEnv *env, jclass cls, jlong handle, jlong now, jlongArray out)
+{
+    expiry_index_t *ex = (expiry_index_t *)(uintptr_t)handle;
+    jlong counts[3];
+    expiry_key_t min = {NULL, 0};
+    expiry_key_t max = {NULL, 0};
+    int bounded;
+
+    pthread_mutex_lock(&ex->lock);
+    expiry_fold(ex, (int64_t)now);
+    counts[0] = (jlong)ex->tracked;
+    counts[1] = (jlong)ex->expired;
+    counts[2] = (jlong)ex->expired_bytes;
+    bounded = ex->expired > 0 && !ex->expired_unbounded &&
+              expiry_key_set(&min, ex->expired_min.data, ex->expired_min.size) == 0 &&
+              expiry_key_set(&max, ex->expired_max.data, ex->expired_max.size) == 0;
+    pthread_mutex_unlock(&ex->lock);
+
+    (*env)->SetLongArrayRegion(env, out, 0, 3, counts);
+
+    jobjectArray range = NULL;
+    if (bounded)
+    {
+        range = (*env)->NewObjectArray(env, 2, g_byte_array_class, NULL);
+        jbyteArray jmin = range != NULL ? expiry_key_to_java(env, &min) : NULL;
+        jbyteArray jmax = jmin != NULL ? expiry_key_to_java(env, &max) : NULL;
+        if (jmax != NULL)
+        {
+            (*env)->SetObjectArrayElement(env, range, 0, jmin);
+            (*env)->SetObjectArrayElement(env, range, 1, jmax);
+        }
+        else
+        {
+            range = NULL;
+        }
+    }
+    expiry_key_free(&min);
+    expiry_key_free(&max);
+    return range;
+}
+
+/**
+ * Subtracts expired keys a sweep has compacted away and forgets the keys that had expired by
+ * the time it peeked. The expired key range is kept until the count reaches zero, since keys
+ * that expired during the sweep may lie outside it.
+ */
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeExpiryIndexConsume(JNIEnv *env,
+                                                                              jclass cls,
+                                                                              jlong handle,
+                                                                              jlong count,
+                                                                              jlong bytes,
+                                                                              jlong now)
+{
+    expiry_index_t *ex = (expiry_index_t *)(uintptr_t)handle;
+
+    pthread_mutex_lock(&ex->lock);
+    if (ex->num_keys > 0)
+    {
+        /* on allocation failure the expired keys linger until the next sweep */
+        (void)expiry_keys_rebuild(ex, ex->key_slots, (int64_t)now);
+    }
+    uint64_t c = (uint64_t)count;
+    uint64_t b = (uint64_t)bytes;
+    ex->expired -= c < ex->expired ? c : ex->expired;
+    ex->expired_bytes -= b < ex->expired_bytes ? b : ex->expired_bytes;
+    if (ex->expired == 0)
+    {
+        expiry_key_free(&ex->expired_min);
+        expiry_key_free(&ex->expired_max);
+        ex->expired_bytes = 0;
+        ex->expired_unbounded = 0;
+    }
+    pthread_mutex_unlock(&ex->lock);
+}
+
+#define COMMIT_HOOK_SYNC  0
+#define COMMIT_HOOK_ASYNC 1
+#define COMMIT_HOOK_EXPIRY 2
+
+#define COMMIT_HOOK_POLICY_BLOCK 0
+#define COMMIT_HOOK_POLICY_DROP  1
+
+#define HOOK_RING_MIN_CAPACITY (64 * 1024)
+#define HOOK_RING_MAX_CAPACITY (1u << 30)
+
+/**
+ * Context stored as the commit hook ctx pointer.
+ * Holds the JavaVM, a global reference to the Java CommitHook object and the column family's
+ * expiry index, if TTL tracking is enabled. COMMIT_HOOK_EXPIRY contexts only feed the index.
+ */
+typedef struct
+{
+    int kind; /* COMMIT_HOOK_SYNC, COMMIT_HOOK_ASYNC or COMMIT_HOOK_EXPIRY */
+    JavaVM *jvm;
+    jobject hook_obj; /* global reference to CommitHook, NULL for COMMIT_HOOK_EXPIRY */
+    _Atomic(expiry_index_t *) expiry;
+} java_hook_ctx_t;
+
+/**
+ * Feeds the expiry index attached to a hook context, if any. The index outlives every context
+ * it is attached to, so a trampoline racing a detach still sees valid memory.
+ */
+static inline void hook_record_expiry(java_hook_ctx_t *hctx, const tidesdb_commit_op_t *ops,
+                                      int num_ops)
+{
+    expiry_index_t *ex = atomic_load(&hctx->expiry);
+    if (ex != NULL)
+        expiry_record(ex, ops, num_ops);
+}
+
+/**
+ * Header in front of every record in the asynchronous hook ring.
+ * total_len stays 0 until the producer has finished writing the payload.
+ * A payload_len of 0 marks padding that skips to the start of the ring.
+ */
+typedef struct
+{
+    _Atomic uint32_t total_len;
+    uint32_t payload_len;
+} hook_record_t;
+
+/**
+ * Context for asynchronous commit hooks. Committing threads copy their ops into a
+ * multi-producer ring and return, a single consumer thread drains the ring and hands
+ * whole batches of commits to Java through one direct ByteBuffer.
+ */
+typedef struct
+{
+    java_hook_ctx_t base;
+    uint8_t *ring;
+    uint64_t capacity; /* power of two */
+    uint64_t mask;
+    _Atomic uint64_t tail; /* next byte reserved by producers */
+    _Atomic uint64_t head; /* next byte read by the consumer */
+    _Atomic int waiting;   /* consumer is (about to be) parked on not_empty */
+    _Atomic int blocked;   /* producers parked on not_full under the block policy */
+    _Atomic int stop;
+    _Atomic uint64_t dropped;
+    int policy;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_t consumer;
+    uint8_t *delivery;
+    jobject delivery_buf; /* global reference to a DirectByteBuffer over delivery */
+} async_hook_ctx_t;
+
+static inline uint64_t align8(uint64_t v)
+{
+    return (v + 7) & ~(uint64_t)7;
+}
+
+static size_t hook_payload_size(const tidesdb_commit_op_t *ops, int num_ops)
+{
+    size_t size = 12;
+    for (int i = 0; i < num_ops; i++)
+    {
+        size += 1 + 8 + 4 + ops[i].key_size + 4;
+        if (ops[i].value != NULL && ops[i].value_size > 0)
+            size += ops[i].value_size;
+    }
+    return size;
+}
+
+/**
+ * Serializes one commit as [be64 seq][be32 nops] followed per op by
+ * [u8 delete][be64 ttl][be32 klen][key][be32 vlen or -1][value].
+ */
+static void hook_payload_write(uint8_t *dst, const tidesdb_commit_op_t *ops, int num_ops,
+                               uint64_t commit_seq)
+{
+    write_be64(dst, commit_seq);
+    write_be32(dst + 8, (uint32_t)num_ops);
+    size_t pos = 12;
+
+    for (int i = 0; i < num_ops; i++)
+    {
+        dst[pos] = ops[i].is_delete ? 1 : 0;
+        write_be64(dst + pos + 1, (uint64_t)(int64_t)ops[i].ttl);
+        write_be32(dst + pos + 9, (uint32_t)ops[i].key_size);
+        pos += 13;
+        memcpy(dst + pos, ops[i].key, ops[i].key_size);
+        pos += ops[i].key_size;
+
+        if (ops[i].value != NULL && ops[i].value_size > 0)
+        {
+            write_be32(dst + pos, (uint32_t)ops[i].value_size);
+            memcpy(dst + pos + 4, ops[i].value, ops[i].value_size);
+            pos += 4 + ops[i].value_size;
+        }
+        else
+        {
+            write_be32(dst + pos, (uint32_t)-1);
+            pos += 4;
+        }
+    }
+}
+
+/**
+ * Parks a producer until the consumer frees ring space or stops. blocked is raised before head
+ * is re-read, so a consumer that advances head after the check sees it and signals.
+ */
+static void hook_ring_wait(async_hook_ctx_t *a, uint64_t head)
+{
+    pthread_mutex_lock(&a->lock);
+    atomic_fetch_add(&a->blocked, 1);
+    if (atomic_load(&a->head) == head && !atomic_load(&a->stop))
+        pthread_cond_wait(&a->not_full, &a->lock);
+    atomic_fetch_sub(&a->blocked, 1);
+    pthread_mutex_unlock(&a->lock);
+}
+
+/**
+ * Reserves total bytes in the ring, first claiming the rest of the ring as padding when the
+ * record would not be contiguous. Returns NULL when the record is dropped.
+ */
+static hook_record_t *hook_ring_reserve(async_hook_ctx_t *a, uint64_t total)
+{
+    for (;;)
     {
-        strncpy(config.comparator_name, compName, TDB_MAX_COMPARATOR_NAME - 1);
-    }
+        uint64_t t = atomic_load(&a->tail);
+        uint64_t h = atomic_load(&a->head);
+        uint64_t off = t & a->mask;
+        uint64_t pad = (a->capacity - off < total) ? a->capacity - off : 0;
 
-    memset(config.comparator_ctx_str, 0, TDB_MAX_COMPARATOR_CTX);
-    config.comparator_fn_cached = NULL;
-    config.comparator_ctx_cached = NULL;
+        if (t + pad + total - h > a->capacity)
+        {
+            if (a->policy == COMMIT_HOOK_POLICY_DROP || atomic_load(&a->stop))
+                return NULL;
+            hook_ring_wait(a, h);
+            continue;
+        }
 
-    int result = tidesdb_create_column_family(db, cfName, &config);
+        if (!atomic_compare_exchange_weak(&a->tail, &t, t + pad + total))
+            continue;
 
-    (*env)->ReleaseStringUTFChars(env, name, cfName);
-    if (compName != NULL)
+        if (pad > 0)
+        {
+            hook_record_t *padding = (hook_record_t *)(a->ring + off);
+            padding->payload_len = 0;
+            atomic_store(&padding->total_len, (uint32_t)pad);
+            off = 0;
+        }
+        return (hook_record_t *)(a->ring + off);
+    }
+}
+
+/**
+ * Trampoline for asynchronous hooks. Runs on the committing thread but never enters Java,
+ * it only copies the ops into the ring and wakes the consumer if it is parked.
+ */
+static int async_commit_hook_trampoline(const tidesdb_commit_op_t *ops, int num_ops,
+                                        uint64_t commit_seq, void *ctx)
+{
+    async_hook_ctx_t *a = (async_hook_ctx_t *)ctx;
+    hook_record_expiry(&a->base, ops, num_ops);
+    size_t payload = hook_payload_size(ops, num_ops);
+    uint64_t total = align8(sizeof(hook_record_t) + payload);
+
+    hook_record_t *rec = total <= a->capacity ? hook_ring_reserve(a, total) : NULL;
+    if (rec == NULL)
     {
-        (*env)->ReleaseStringUTFChars(env, comparatorName, compName);
+        atomic_fetch_add(&a->dropped, 1);
+        return 0;
     }
 
-    if (result != TDB_SUCCESS)
+    rec->payload_len = (uint32_t)payload;
+    hook_payload_write((uint8_t *)(rec + 1), ops, num_ops, commit_seq);
+    atomic_store(&rec->total_len, (uint32_t)total);
+
+    if (atomic_load(&a->waiting))
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        pthread_mutex_lock(&a->lock);
+        pthread_cond_signal(&a->not_empty);
+        pthread_mutex_unlock(&a->lock);
     }
+    return 0;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeDropColumnFamily(JNIEnv *env, jclass cls,
-                                                                       jlong handle, jstring name)
+/**
+ * Copies every ready record into the delivery buffer (up to its capacity) and releases the
+ * ring space. Returns the number of commits copied and stores the byte length in used.
+ */
+static int async_hook_drain(async_hook_ctx_t *a, uint32_t *used)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *cfName = (*env)->GetStringUTFChars(env, name, NULL);
-    if (cfName == NULL)
-    {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get column family name");
-        return;
-    }
+    int commits = 0;
+    *used = 0;
 
-    int result = tidesdb_drop_column_family(db, cfName);
+    for (;;)
+    {
+        uint64_t h = atomic_load(&a->head);
+        hook_record_t *rec = (hook_record_t *)(a->ring + (h & a->mask));
+        uint32_t total = atomic_load(&rec->total_len);
+        if (total == 0)
+            break;
+
+        uint32_t len = rec->payload_len;
+        if (len > 0)
+        {
+            if (*used + len > a->capacity)
+                break;
+            memcpy(a->delivery + *used, rec + 1, len);
+            *used += len;
+            commits++;
+        }
 
-    (*env)->ReleaseStringUTFChars(env, name, cfName);
+        /* stale payload bytes must not look like a header to the next reader */
+        rec->payload_len = 0;
+        memset(rec + 1, 0, total - sizeof(hook_record_t));
+        atomic_store(&rec->total_len, 0);
+        atomic_store(&a->head, h + total);
+    }
+    return commits;
+}
 
-    if (result != TDB_SUCCESS)
+/** Wakes producers parked on a full ring, if there are any. */
+static void async_hook_wake_producers(async_hook_ctx_t *a)
+{
+    if (atomic_load(&a->blocked))
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        pthread_mutex_lock(&a->lock);
+        pthread_cond_broadcast(&a->not_full);
+        pthread_mutex_unlock(&a->lock);
     }
 }
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeGetColumnFamily(JNIEnv *env, jclass cls,
-                                                                       jlong handle, jstring name)
+static void *async_hook_consumer(void *arg)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *cfName = (*env)->GetStringUTFChars(env, name, NULL);
-    if (cfName == NULL)
+    async_hook_ctx_t *a = (async_hook_ctx_t *)arg;
+    JNIEnv *env = attach_thread_env("tidesdb-hook");
+    if (env == NULL)
     {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get column family name");
-        return 0;
+        /* nothing can be delivered, make producers drop instead of blocking */
+        pthread_mutex_lock(&a->lock);
+        atomic_store(&a->stop, 1);
+        pthread_cond_broadcast(&a->not_full);
+        pthread_mutex_unlock(&a->lock);
+        return NULL;
     }
 
-    tidesdb_column_family_t *cf = tidesdb_get_column_family(db, cfName);
+    for (;;)
+    {
+        uint32_t used;
+        int commits = async_hook_drain(a, &used);
+        /* the ring space is free once copied out, before the hook runs */
+        async_hook_wake_producers(a);
 
-    (*env)->ReleaseStringUTFChars(env, name, cfName);
+        if (commits > 0)
+        {
+            uint64_t started = latency_start();
+            (*env)->CallStaticVoidMethod(env, g_async_commit_hooks_class,
+                                         g_async_commit_hooks_deliver, a->base.hook_obj,
+                                         a->delivery_buf, (jint)used, (jint)commits);
+            latency_end(LATENCY_COMMIT_HOOK, started);
+            if ((*env)->ExceptionCheck(env))
+                (*env)->ExceptionClear(env);
+            continue;
+        }
 
-    if (cf == NULL)
+        if (atomic_load(&a->stop))
+            break;
+
+        pthread_mutex_lock(&a->lock);
+        atomic_store(&a->waiting, 1);
+        hook_record_t *rec = (hook_record_t *)(a->ring + (atomic_load(&a->head) & a->mask));
+        if (atomic_load(&rec->total_len) == 0 && !atomic_load(&a->stop))
+            pthread_cond_wait(&a->not_empty, &a->lock);
+        atomic_store(&a->waiting, 0);
+        pthread_mutex_unlock(&a->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * Releases a hook context. Asynchronous contexts deliver whatever is still queued before
+ * their consumer thread exits.
+ */
+static void hook_ctx_free(JNIEnv *env, java_hook_ctx_t *ctx)
+{
+    if (ctx->kind == COMMIT_HOOK_ASYNC)
     {
-        throwTidesDBException(env, TDB_ERR_NOT_FOUND, "Column family not found");
-        return 0;
+        async_hook_ctx_t *a = (async_hook_ctx_t *)ctx;
+
+        pthread_mutex_lock(&a->lock);
+        atomic_store(&a->stop, 1);
+        pthread_cond_signal(&a->not_empty);
+        pthread_cond_broadcast(&a->not_full);
+        pthread_mutex_unlock(&a->lock);
+        pthread_join(a->consumer, NULL);
+
+        (*env)->DeleteGlobalRef(env, a->delivery_buf);
+        pthread_cond_destroy(&a->not_full);
+        pthread_cond_destroy(&a->not_empty);
+        pthread_mutex_destroy(&a->lock);
+        free(a->delivery);
+        free(a->ring);
     }
 
-    return (jlong)(uintptr_t)cf;
+    if (ctx->hook_obj != NULL)
+        (*env)->DeleteGlobalRef(env, ctx->hook_obj);
+    free(ctx);
 }
 
-JNIEXPORT jobjectArray JNICALL Java_com_tidesdb_TidesDB_nativeListColumnFamilies(JNIEnv *env,
-                                                                                 jclass cls,
-                                                                                 jlong handle)
+/**
+ * Trampoline for contexts that only track TTL writes. Never enters Java.
+ */
+static int expiry_commit_hook_trampoline(const tidesdb_commit_op_t *ops, int num_ops,
+                                         uint64_t commit_seq, void *ctx)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    char **names = NULL;
-    int count = 0;
+    hook_record_expiry((java_hook_ctx_t *)ctx, ops, num_ops);
+    return 0;
+}
 
-    int result = tidesdb_list_column_families(db, &names, &count);
-    if (result != TDB_SUCCESS)
+/**
+ * C trampoline that bridges the tidesdb_commit_hook_fn callback to the Java CommitHook.onCommit
+ * method. Fires synchronously on the committing thread; a thread the JVM does not know about is
+ * attached once and stays attached until it exits.
+ */
+static int java_commit_hook_trampoline(const tidesdb_commit_op_t *ops, int num_ops,
+                                        uint64_t commit_seq, void *ctx)
+{
+    java_hook_ctx_t *hctx = (java_hook_ctx_t *)ctx;
+    hook_record_expiry(hctx, ops, num_ops);
+    JNIEnv *env = attach_thread_env("tidesdb-callback");
+    if (env == NULL)
+        return -1;
+
+    jint ret = -1;
+
+    /* Create CommitOp[] array */
+    jobjectArray opsArray = (*env)->NewObjectArray(env, num_ops, g_commit_op_class, NULL);
+    if (opsArray == NULL)
+        goto cleanup;
+
+    for (int i = 0; i < num_ops; i++)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return NULL;
+        jbyteArray jkey = (*env)->NewByteArray(env, (jsize)ops[i].key_size);
+        (*env)->SetByteArrayRegion(env, jkey, 0, (jsize)ops[i].key_size, (jbyte *)ops[i].key);
+
+        jbyteArray jvalue = NULL;
+        if (ops[i].value != NULL && ops[i].value_size > 0)
+        {
+            jvalue = (*env)->NewByteArray(env, (jsize)ops[i].value_size);
+            (*env)->SetByteArrayRegion(env, jvalue, 0, (jsize)ops[i].value_size,
+                                       (jbyte *)ops[i].value);
+        }
+
+        jobject opObj = (*env)->NewObject(env, g_commit_op_class, g_commit_op_ctor, jkey, jvalue,
+                                          (jlong)ops[i].ttl,
+                                          ops[i].is_delete ? JNI_TRUE : JNI_FALSE);
+        (*env)->SetObjectArrayElement(env, opsArray, i, opObj);
+
+        (*env)->DeleteLocalRef(env, opObj);
+        (*env)->DeleteLocalRef(env, jkey);
+        if (jvalue != NULL)
+            (*env)->DeleteLocalRef(env, jvalue);
     }
 
-    jclass stringClass = (*env)->FindClass(env, "java/lang/String");
-    jobjectArray array = (*env)->NewObjectArray(env, count, stringClass, NULL);
+    /* Call CommitHook.onCommit(CommitOp[], long) */
+    uint64_t started = latency_start();
+    ret = (*env)->CallIntMethod(env, hctx->hook_obj, g_commit_hook_on_commit, opsArray,
+                                (jlong)commit_seq);
+    latency_end(LATENCY_COMMIT_HOOK, started);
 
-    for (int i = 0; i < count; i++)
+    if ((*env)->ExceptionCheck(env))
     {
-        jstring str = (*env)->NewStringUTF(env, names[i]);
-        (*env)->SetObjectArrayElement(env, array, i, str);
-        free(names[i]);
+        (*env)->ExceptionClear(env);
+        ret = -1;
     }
-    free(names);
 
-    return array;
-}
+    (*env)->DeleteLocalRef(env, opsArray);
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeBeginTransaction(JNIEnv *env, jclass cls,
-                                                                        jlong handle)
-{
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    tidesdb_txn_t *txn = NULL;
+    return (int)ret;
 
-    int result = tidesdb_txn_begin(db, &txn);
-    if (result != TDB_SUCCESS)
-    {
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return 0;
-    }
+cleanup:
+    if ((*env)->ExceptionCheck(env))
+        (*env)->ExceptionClear(env);
+    return -1;
+}
 
-    return (jlong)(uintptr_t)txn;
+/**
+ * Frees the hook context of a column family the engine has already dropped, so there is no
+ * column family left to uninstall it from.
+ */
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeFreeCommitHook(JNIEnv *env, jclass cls,
+                                                                          jlong ctxHandle)
+{
+    java_hook_ctx_t *ctx = (java_hook_ctx_t *)(uintptr_t)ctxHandle;
+    if (ctx != NULL)
+        hook_ctx_free(env, ctx);
 }
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeBeginTransactionWithIsolation(
-    JNIEnv *env, jclass cls, jlong handle, jint isolationLevel)
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamily_nativeSetCommitHook(JNIEnv *env, jclass cls,
+                                                                           jlong cfHandle,
+                                                                           jobject hook,
+                                                                           jlong oldCtxHandle,
+                                                                           jlong expiryHandle)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    tidesdb_txn_t *txn = NULL;
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+    java_hook_ctx_t *old_ctx = (java_hook_ctx_t *)(uintptr_t)oldCtxHandle;
+    expiry_index_t *expiry = (expiry_index_t *)(uintptr_t)expiryHandle;
 
-    int result =
-        tidesdb_txn_begin_with_isolation(db, (tidesdb_isolation_level_t)isolationLevel, &txn);
-    if (result != TDB_SUCCESS)
+    /* If hook is NULL and nothing is tracked, clear the hook */
+    if (hook == NULL && expiry == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        int result = tidesdb_cf_set_commit_hook(cf, NULL, NULL);
+        if (result != TDB_SUCCESS)
+        {
+            throwTidesDBException(env, result, getErrorMessage(result));
+            return oldCtxHandle;
+        }
+        if (old_ctx != NULL)
+            hook_ctx_free(env, old_ctx);
         return 0;
     }
 
-    return (jlong)(uintptr_t)txn;
-}
+    /* Allocate new context */
+    java_hook_ctx_t *ctx = (java_hook_ctx_t *)malloc(sizeof(java_hook_ctx_t));
+    if (ctx == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate commit hook context");
+        return oldCtxHandle;
+    }
 
-JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDB_nativeGetCacheStats(JNIEnv *env, jclass cls,
-                                                                       jlong handle)
-{
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    tidesdb_cache_stats_t stats;
+    ctx->kind = hook != NULL ? COMMIT_HOOK_SYNC : COMMIT_HOOK_EXPIRY;
+    (*env)->GetJavaVM(env, &ctx->jvm);
+    ctx->hook_obj = hook != NULL ? (*env)->NewGlobalRef(env, hook) : NULL;
+    atomic_init(&ctx->expiry, expiry);
 
-    int result = tidesdb_get_cache_stats(db, &stats);
+    int result = tidesdb_cf_set_commit_hook(
+        cf, hook != NULL ? java_commit_hook_trampoline : expiry_commit_hook_trampoline, ctx);
     if (result != TDB_SUCCESS)
     {
+        if (ctx->hook_obj != NULL)
+            (*env)->DeleteGlobalRef(env, ctx->hook_obj);
+        free(ctx);
         throwTidesDBException(env, result, getErrorMessage(result));
-        return NULL;
+        return oldCtxHandle;
     }
 
-    jclass cacheStatsClass = (*env)->FindClass(env, "com/tidesdb/CacheStats");
-    jmethodID constructor = (*env)->GetMethodID(env, cacheStatsClass, "<init>", "(ZJJJJDJ)V");
-
-    return (*env)->NewObject(env, cacheStatsClass, constructor, stats.enabled != 0,
-                             (jlong)stats.total_entries, (jlong)stats.total_bytes,
-                             (jlong)stats.hits, (jlong)stats.misses, stats.hit_rate,
-                             (jlong)stats.num_partitions);
+    /* the engine no longer references the old context once the new hook is installed */
+    if (old_ctx != NULL)
+        hook_ctx_free(env, old_ctx);
+    return (jlong)(uintptr_t)ctx;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeRegisterComparator(JNIEnv *env, jclass cls,
-                                                                         jlong handle, jstring name,
-                                                                         jstring context)
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamily_nativeSetAsyncCommitHook(
+    JNIEnv *env, jclass cls, jlong cfHandle, jobject hook, jlong oldCtxHandle,
+    jint capacityBytes, jint policy, jlong expiryHandle)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *compName = (*env)->GetStringUTFChars(env, name, NULL);
-    if (compName == NULL)
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+
+    uint64_t capacity = HOOK_RING_MIN_CAPACITY;
+    while (capacity < (uint64_t)capacityBytes && capacity < HOOK_RING_MAX_CAPACITY)
+        capacity <<= 1;
+
+    async_hook_ctx_t *a = (async_hook_ctx_t *)calloc(1, sizeof(async_hook_ctx_t));
+    uint8_t *ring = (uint8_t *)calloc(1, capacity);
+    uint8_t *delivery = (uint8_t *)malloc(capacity);
+    if (a == NULL || ring == NULL || delivery == NULL)
     {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get comparator name");
-        return;
+        free(a);
+        free(ring);
+        free(delivery);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate commit hook queue");
+        return oldCtxHandle;
     }
 
-    const char *ctx = NULL;
-    if (context != NULL)
+    a->base.kind = COMMIT_HOOK_ASYNC;
+    (*env)->GetJavaVM(env, &a->base.jvm);
+    atomic_init(&a->base.expiry, (expiry_index_t *)(uintptr_t)expiryHandle);
+    a->ring = ring;
+    a->capacity = capacity;
+    a->mask = capacity - 1;
+    a->delivery = delivery;
+    a->policy = policy;
+    atomic_init(&a->tail, 0);
+    atomic_init(&a->head, 0);
+    atomic_init(&a->waiting, 0);
+    atomic_init(&a->blocked, 0);
+    atomic_init(&a->stop, 0);
+    atomic_init(&a->dropped, 0);
+
+    jobject buf = (*env)->NewDirectByteBuffer(env, delivery, (jlong)capacity);
+    if (buf == NULL)
     {
-        ctx = (*env)->GetStringUTFChars(env, context, NULL);
+        free(delivery);
+        free(ring);
+        free(a);
+        return oldCtxHandle;
     }
-
-    int result = tidesdb_register_comparator(db, compName, NULL, ctx, NULL);
-
-    (*env)->ReleaseStringUTFChars(env, name, compName);
-    if (ctx != NULL)
+    a->delivery_buf = (*env)->NewGlobalRef(env, buf);
+    (*env)->DeleteLocalRef(env, buf);
+    a->base.hook_obj = (*env)->NewGlobalRef(env, hook);
+
+    pthread_mutex_init(&a->lock, NULL);
+    pthread_cond_init(&a->not_empty, NULL);
+    pthread_cond_init(&a->not_full, NULL);
+    if (pthread_create(&a->consumer, NULL, async_hook_consumer, a) != 0)
     {
-        (*env)->ReleaseStringUTFChars(env, context, ctx);
+        pthread_cond_destroy(&a->not_full);
+        pthread_cond_destroy(&a->not_empty);
+        pthread_mutex_destroy(&a->lock);
+        (*env)->DeleteGlobalRef(env, a->delivery_buf);
+        (*env)->DeleteGlobalRef(env, a->base.hook_obj);
+        free(delivery);
+        free(ring);
+        free(a);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to start commit hook thread");
+        return oldCtxHandle;
     }
 
+    int result = tidesdb_cf_set_commit_hook(cf, async_commit_hook_trampoline, a);
     if (result != TDB_SUCCESS)
     {
+        hook_ctx_free(env, &a->base);
         throwTidesDBException(env, result, getErrorMessage(result));
+        return oldCtxHandle;
     }
+
+    if (oldCtxHandle != 0)
+        hook_ctx_free(env, (java_hook_ctx_t *)(uintptr_t)oldCtxHandle);
+    return (jlong)(uintptr_t)a;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeBackup(JNIEnv *env, jclass cls, jlong handle,
-                                                             jstring dir)
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeSetCommitHookExpiry(
+    JNIEnv *env, jclass cls, jlong ctxHandle, jlong expiryHandle)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *backupDir = (*env)->GetStringUTFChars(env, dir, NULL);
-    if (backupDir == NULL)
-    {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get backup directory");
-        return;
-    }
+    java_hook_ctx_t *ctx = (java_hook_ctx_t *)(uintptr_t)ctxHandle;
+    if (ctx != NULL)
+        atomic_store(&ctx->expiry, (expiry_index_t *)(uintptr_t)expiryHandle);
+}
 
-    int result = tidesdb_backup(db, (char *)backupDir);
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamily_nativeCommitHookDropped(JNIEnv *env,
+                                                                               jclass cls,
+                                                                               jlong ctxHandle)
+{
+    java_hook_ctx_t *ctx = (java_hook_ctx_t *)(uintptr_t)ctxHandle;
+    if (ctx == NULL || ctx->kind != COMMIT_HOOK_ASYNC)
+        return 0;
+    return (jlong)atomic_load(&((async_hook_ctx_t *)ctx)->dropped);
+}
 
-    (*env)->ReleaseStringUTFChars(env, dir, backupDir);
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativePurge(JNIEnv *env, jclass cls,
+                                                                  jlong handle)
+{
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    int result = tidesdb_purge_cf(cf);
 
     if (result != TDB_SUCCESS)
     {
@@ -441,20 +4185,11 @@ JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeBackup(JNIEnv *env, jclass
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCheckpoint(JNIEnv *env, jclass cls,
-                                                                 jlong handle, jstring dir)
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeSyncWal(JNIEnv *env, jclass cls,
+                                                                    jlong handle)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *checkpointDir = (*env)->GetStringUTFChars(env, dir, NULL);
-    if (checkpointDir == NULL)
-    {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get checkpoint directory");
-        return;
-    }
-
-    int result = tidesdb_checkpoint(db, checkpointDir);
-
-    (*env)->ReleaseStringUTFChars(env, dir, checkpointDir);
+    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
+    int result = tidesdb_sync_wal(cf);
 
     if (result != TDB_SUCCESS)
     {
@@ -462,31 +4197,10 @@ JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCheckpoint(JNIEnv *env, jc
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeRenameColumnFamily(JNIEnv *env, jclass cls,
-                                                                          jlong handle,
-                                                                          jstring oldName,
-                                                                          jstring newName)
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativePurge(JNIEnv *env, jclass cls, jlong handle)
 {
     tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *oldCfName = (*env)->GetStringUTFChars(env, oldName, NULL);
-    if (oldCfName == NULL)
-    {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get old column family name");
-        return;
-    }
-
-    const char *newCfName = (*env)->GetStringUTFChars(env, newName, NULL);
-    if (newCfName == NULL)
-    {
-        (*env)->ReleaseStringUTFChars(env, oldName, oldCfName);
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get new column family name");
-        return;
-    }
-
-    int result = tidesdb_rename_column_family(db, oldCfName, newCfName);
-
-    (*env)->ReleaseStringUTFChars(env, oldName, oldCfName);
-    (*env)->ReleaseStringUTFChars(env, newName, newCfName);
+    int result = tidesdb_purge(db);
 
     if (result != TDB_SUCCESS)
     {
@@ -494,293 +4208,379 @@ JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeRenameColumnFamily(JNIEnv
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeCloneColumnFamily(JNIEnv *env, jclass cls,
-                                                                        jlong handle,
-                                                                        jstring sourceName,
-                                                                        jstring destName)
+JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDB_nativeGetDbStats(JNIEnv *env, jclass cls,
+                                                                     jlong handle)
 {
     tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    const char *srcCfName = (*env)->GetStringUTFChars(env, sourceName, NULL);
-    if (srcCfName == NULL)
+    tidesdb_db_stats_t db_stats;
+    memset(&db_stats, 0, sizeof(db_stats));
+
+    int result = tidesdb_get_db_stats(db, &db_stats);
+    if (result != TDB_SUCCESS)
     {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get source column family name");
-        return;
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return NULL;
     }
 
-    const char *dstCfName = (*env)->GetStringUTFChars(env, destName, NULL);
-    if (dstCfName == NULL)
+    jstring connectorStr = NULL;
+    if (db_stats.object_store_connector != NULL)
     {
-        (*env)->ReleaseStringUTFChars(env, sourceName, srcCfName);
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to get destination column family name");
-        return;
+        connectorStr = (*env)->NewStringUTF(env, db_stats.object_store_connector);
     }
 
-    int result = tidesdb_clone_column_family(db, srcCfName, dstCfName);
+    return (*env)->NewObject(env, g_db_stats_class, g_db_stats_ctor,
+                             (jint)db_stats.num_column_families,
+                             (jlong)db_stats.total_memory,
+                             (jlong)db_stats.available_memory,
+                             (jlong)db_stats.resolved_memory_limit,
+                             (jint)db_stats.memory_pressure_level,
+                             (jint)db_stats.flush_pending_count,
+                             (jlong)db_stats.total_memtable_bytes,
+                             (jint)db_stats.total_immutable_count,
+                             (jint)db_stats.total_sstable_count,
+                             (jlong)db_stats.total_data_size_bytes,
+                             (jint)db_stats.num_open_sstables,
+                             (jlong)db_stats.global_seq,
+                             (jlong)db_stats.txn_memory_bytes,
+                             (jlong)db_stats.compaction_queue_size,
+                             (jlong)db_stats.flush_queue_size,
+                             db_stats.unified_memtable_enabled != 0,
+                             (jlong)db_stats.unified_memtable_bytes,
+                             (jint)db_stats.unified_immutable_count,
+                             db_stats.unified_is_flushing != 0,
+                             (jint)db_stats.unified_next_cf_index,
+                             (jlong)db_stats.unified_wal_generation,
+                             db_stats.object_store_enabled != 0,
+                             connectorStr,
+                             (jlong)db_stats.local_cache_bytes_used,
+                             (jlong)db_stats.local_cache_bytes_max,
+                             (jint)db_stats.local_cache_num_files,
+                             (jlong)db_stats.last_uploaded_generation,
+                             (jlong)db_stats.upload_queue_depth,
+                             (jlong)db_stats.total_uploads,
+                             (jlong)db_stats.total_upload_failures,
+                             db_stats.replica_mode != 0);
+}
 
-    (*env)->ReleaseStringUTFChars(env, sourceName, srcCfName);
-    (*env)->ReleaseStringUTFChars(env, destName, dstCfName);
+/*
+ * Metrics natives fill caller-owned direct LongBuffers (native byte order) in place without
+ * allocating Java objects. Slot offsets are mirrored in Metrics.java.
+ */
+#define CF_METRIC_MEMTABLE_BYTES   0
+#define CF_METRIC_NUM_LEVELS       1
+#define CF_METRIC_TOTAL_KEYS       2
+#define CF_METRIC_DATA_BYTES       3
+#define CF_METRIC_TOMBSTONES       4
+#define CF_METRIC_SSTABLES         5
+#define CF_METRIC_LEVEL_BYTES      6
+#define CF_METRIC_SLOTS            7
+
+#define DB_METRIC_COLUMN_FAMILIES  0
+#define DB_METRIC_MEMORY_PRESSURE  1
+#define DB_METRIC_FLUSH_PENDING    2
+#define DB_METRIC_MEMTABLE_BYTES   3
+#define DB_METRIC_IMMUTABLES       4
+#define DB_METRIC_SSTABLES         5
+#define DB_METRIC_DATA_BYTES       6
+#define DB_METRIC_OPEN_SSTABLES    7
+#define DB_METRIC_GLOBAL_SEQ       8
+#define DB_METRIC_TXN_MEMORY_BYTES 9
+#define DB_METRIC_COMPACTION_QUEUE 10
+#define DB_METRIC_FLUSH_QUEUE      11
+#define DB_METRIC_CACHE_ENTRIES    12
+#define DB_METRIC_CACHE_BYTES      13
+#define DB_METRIC_CACHE_HITS       14
+#define DB_METRIC_CACHE_MISSES     15
+#define DB_METRIC_SLOTS            16
 
-    if (result != TDB_SUCCESS)
+/**
+ * Resolves slots [offset, offset + slots) of a direct LongBuffer. Throws and returns NULL if
+ * the buffer is not direct or too small.
+ */
+static jlong *metric_slots(JNIEnv *env, jobject buf, jint offset, jint slots)
+{
+    jlong *base = (jlong *)(*env)->GetDirectBufferAddress(env, buf);
+    if (base == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "buffer is not a direct LongBuffer");
+        return NULL;
+    }
+
+    /* capacity of a LongBuffer is reported in longs */
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buf);
+    if (offset < 0 || (jlong)offset + (jlong)slots > capacity)
+    {
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "metrics buffer too small");
+        return NULL;
     }
+
+    return base + offset;
 }
 
-JNIEXPORT jobject JNICALL Java_com_tidesdb_ColumnFamily_nativeGetStats(JNIEnv *env, jclass cls,
-                                                                       jlong handle)
+JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeFillMetrics(JNIEnv *env, jclass cls,
+                                                                       jlong handle, jobject out,
+                                                                       jint offset)
 {
     tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    tidesdb_stats_t *stats = NULL;
 
+    jlong *slots = metric_slots(env, out, offset, CF_METRIC_SLOTS);
+    if (slots == NULL)
+    {
+        return;
+    }
+
+    tidesdb_stats_t *stats = NULL;
     int result = tidesdb_get_stats(cf, &stats);
     if (result != TDB_SUCCESS)
     {
         throwTidesDBException(env, result, getErrorMessage(result));
-        return NULL;
+        return;
     }
 
-    jlongArray levelSizes = (*env)->NewLongArray(env, stats->num_levels);
-    if (stats->level_sizes != NULL)
+    jlong sstables = 0;
+    jlong levelBytes = 0;
+    for (int i = 0; i < stats->num_levels; i++)
     {
-        jlong *sizes = malloc(stats->num_levels * sizeof(jlong));
-        for (int i = 0; i < stats->num_levels; i++)
+        if (stats->level_num_sstables != NULL)
         {
-            sizes[i] = (jlong)stats->level_sizes[i];
+            sstables += stats->level_num_sstables[i];
         }
-        (*env)->SetLongArrayRegion(env, levelSizes, 0, stats->num_levels, sizes);
-        free(sizes);
-    }
-
-    jintArray levelNumSSTables = (*env)->NewIntArray(env, stats->num_levels);
-    if (stats->level_num_sstables != NULL)
-    {
-        jint *nums = malloc(stats->num_levels * sizeof(jint));
-        for (int i = 0; i < stats->num_levels; i++)
+        if (stats->level_sizes != NULL)
         {
-            nums[i] = stats->level_num_sstables[i];
+            levelBytes += (jlong)stats->level_sizes[i];
         }
-        (*env)->SetIntArrayRegion(env, levelNumSSTables, 0, stats->num_levels, nums);
-        free(nums);
     }
 
-    jlongArray levelKeyCounts = (*env)->NewLongArray(env, stats->num_levels);
-    if (stats->level_key_counts != NULL)
-    {
-        jlong *counts = malloc(stats->num_levels * sizeof(jlong));
-        for (int i = 0; i < stats->num_levels; i++)
-        {
-            counts[i] = (jlong)stats->level_key_counts[i];
-        }
-        (*env)->SetLongArrayRegion(env, levelKeyCounts, 0, stats->num_levels, counts);
-        free(counts);
-    }
+    slots[CF_METRIC_MEMTABLE_BYTES] = (jlong)stats->memtable_size;
+    slots[CF_METRIC_NUM_LEVELS] = stats->num_levels;
+    slots[CF_METRIC_TOTAL_KEYS] = (jlong)stats->total_keys;
+    slots[CF_METRIC_DATA_BYTES] = (jlong)stats->total_data_size;
+    slots[CF_METRIC_TOMBSTONES] = (jlong)stats->total_tombstones;
+    slots[CF_METRIC_SSTABLES] = sstables;
+    slots[CF_METRIC_LEVEL_BYTES] = levelBytes;
 
-    jlongArray levelTombstoneCounts = (*env)->NewLongArray(env, stats->num_levels);
-    if (stats->level_tombstone_counts != NULL)
+    tidesdb_free_stats(stats);
+}
+
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeFillMetrics(JNIEnv *env, jclass cls,
+                                                                  jlong handle, jobject out,
+                                                                  jint offset)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+
+    jlong *slots = metric_slots(env, out, offset, DB_METRIC_SLOTS);
+    if (slots == NULL)
     {
-        jlong *counts = malloc(stats->num_levels * sizeof(jlong));
-        for (int i = 0; i < stats->num_levels; i++)
-        {
-            counts[i] = (jlong)stats->level_tombstone_counts[i];
-        }
-        (*env)->SetLongArrayRegion(env, levelTombstoneCounts, 0, stats->num_levels, counts);
-        free(counts);
+        return;
     }
 
-    /* Build ColumnFamilyConfig from stats->config so callers can round-trip CF settings */
-    jobject cfConfigObj = NULL;
-    if (stats->config != NULL)
+    tidesdb_db_stats_t db_stats;
+    memset(&db_stats, 0, sizeof(db_stats));
+    int result = tidesdb_get_db_stats(db, &db_stats);
+    if (result != TDB_SUCCESS)
     {
-        jclass cfConfigClass = (*env)->FindClass(env, "com/tidesdb/ColumnFamilyConfig");
-        jmethodID fromNative = (*env)->GetStaticMethodID(
-            env, cfConfigClass, "fromNative",
-            "(JJIIJIZDZIIIJLjava/lang/String;IFIJIIDJZZZ)Lcom/tidesdb/ColumnFamilyConfig;");
-
-        jstring comparatorName = (*env)->NewStringUTF(env, stats->config->comparator_name);
-
-        cfConfigObj = (*env)->CallStaticObjectMethod(
-            env, cfConfigClass, fromNative,
-            (jlong)stats->config->write_buffer_size,
-            (jlong)stats->config->level_size_ratio,
-            (jint)stats->config->min_levels,
-            (jint)stats->config->dividing_level_offset,
-            (jlong)stats->config->klog_value_threshold,
-            (jint)stats->config->compression_algorithm,
-            stats->config->enable_bloom_filter != 0 ? JNI_TRUE : JNI_FALSE,
-            (jdouble)stats->config->bloom_fpr,
-            stats->config->enable_block_indexes != 0 ? JNI_TRUE : JNI_FALSE,
-            (jint)stats->config->index_sample_ratio,
-            (jint)stats->config->block_index_prefix_len,
-            (jint)stats->config->sync_mode,
-            (jlong)stats->config->sync_interval_us,
-            comparatorName,
-            (jint)stats->config->skip_list_max_level,
-            (jfloat)stats->config->skip_list_probability,
-            (jint)stats->config->default_isolation_level,
-            (jlong)stats->config->min_disk_space,
-            (jint)stats->config->l1_file_count_trigger,
-            (jint)stats->config->l0_queue_stall_threshold,
-            (jdouble)stats->config->tombstone_density_trigger,
-            (jlong)stats->config->tombstone_density_min_entries,
-            stats->config->use_btree != 0 ? JNI_TRUE : JNI_FALSE,
-            stats->config->object_lazy_compaction != 0 ? JNI_TRUE : JNI_FALSE,
-            stats->config->object_prefetch_compaction != 0 ? JNI_TRUE : JNI_FALSE);
-
-        (*env)->DeleteLocalRef(env, comparatorName);
-        (*env)->DeleteLocalRef(env, cfConfigClass);
+        throwTidesDBException(env, result, getErrorMessage(result));
+        return;
     }
 
-    jclass statsClass = (*env)->FindClass(env, "com/tidesdb/Stats");
-    jmethodID constructor = (*env)->GetMethodID(env, statsClass, "<init>",
-                                                "(IJ[J[ILcom/tidesdb/ColumnFamilyConfig;JJDD[JDDZJIDJD[JDI)V");
-
-    jobject statsObj = (*env)->NewObject(env, statsClass, constructor, stats->num_levels,
-                                         (jlong)stats->memtable_size, levelSizes, levelNumSSTables,
-                                         cfConfigObj, (jlong)stats->total_keys,
-                                         (jlong)stats->total_data_size,
-                                         stats->avg_key_size, stats->avg_value_size, levelKeyCounts,
-                                         stats->read_amp, stats->hit_rate,
-                                         stats->use_btree != 0, (jlong)stats->btree_total_nodes,
-                                         (jint)stats->btree_max_height, stats->btree_avg_height,
-                                         (jlong)stats->total_tombstones,
-                                         (jdouble)stats->tombstone_ratio,
-                                         levelTombstoneCounts,
-                                         (jdouble)stats->max_sst_density,
-                                         (jint)stats->max_sst_density_level);
-
-    tidesdb_free_stats(stats);
-
-    return statsObj;
-}
-
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeCompact(JNIEnv *env, jclass cls,
-                                                                   jlong handle)
-{
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    int result = tidesdb_compact(cf);
-
+    tidesdb_cache_stats_t cache_stats;
+    memset(&cache_stats, 0, sizeof(cache_stats));
+    result = tidesdb_get_cache_stats(db, &cache_stats);
     if (result != TDB_SUCCESS)
     {
         throwTidesDBException(env, result, getErrorMessage(result));
+        return;
     }
+
+    slots[DB_METRIC_COLUMN_FAMILIES] = db_stats.num_column_families;
+    slots[DB_METRIC_MEMORY_PRESSURE] = db_stats.memory_pressure_level;
+    slots[DB_METRIC_FLUSH_PENDING] = db_stats.flush_pending_count;
+    slots[DB_METRIC_MEMTABLE_BYTES] = (jlong)db_stats.total_memtable_bytes;
+    slots[DB_METRIC_IMMUTABLES] = db_stats.total_immutable_count;
+    slots[DB_METRIC_SSTABLES] = db_stats.total_sstable_count;
+    slots[DB_METRIC_DATA_BYTES] = (jlong)db_stats.total_data_size_bytes;
+    slots[DB_METRIC_OPEN_SSTABLES] = db_stats.num_open_sstables;
+    slots[DB_METRIC_GLOBAL_SEQ] = (jlong)db_stats.global_seq;
+    slots[DB_METRIC_TXN_MEMORY_BYTES] = (jlong)db_stats.txn_memory_bytes;
+    slots[DB_METRIC_COMPACTION_QUEUE] = (jlong)db_stats.compaction_queue_size;
+    slots[DB_METRIC_FLUSH_QUEUE] = (jlong)db_stats.flush_queue_size;
+    slots[DB_METRIC_CACHE_ENTRIES] = (jlong)cache_stats.total_entries;
+    slots[DB_METRIC_CACHE_BYTES] = (jlong)cache_stats.total_bytes;
+    slots[DB_METRIC_CACHE_HITS] = (jlong)cache_stats.hits;
+    slots[DB_METRIC_CACHE_MISSES] = (jlong)cache_stats.misses;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeCompactRange(JNIEnv *env, jclass cls,
-                                                                        jlong handle,
-                                                                        jbyteArray startKey,
-                                                                        jbyteArray endKey)
+JNIEXPORT void JNICALL Java_com_tidesdb_Metrics_nativeFillBinding(JNIEnv *env, jclass cls,
+                                                                  jobject out, jint offset)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-
-    /* Map null/empty byte arrays to NULL pointers for unbounded endpoints. The C API
-       rejects both-NULL with TDB_ERR_INVALID_ARGS, so we don't need to filter here. */
-    jbyte *startBytes = NULL;
-    jsize startLen = 0;
-    if (startKey != NULL)
+    jlong *slots = metric_slots(env, out, offset, METRIC_SLOTS);
+    if (slots == NULL)
     {
-        startLen = (*env)->GetArrayLength(env, startKey);
-        if (startLen > 0)
-        {
-            startBytes = (*env)->GetByteArrayElements(env, startKey, NULL);
-        }
+        return;
     }
 
-    jbyte *endBytes = NULL;
-    jsize endLen = 0;
-    if (endKey != NULL)
+    for (int i = 0; i < METRIC_SLOTS; i++)
     {
-        endLen = (*env)->GetArrayLength(env, endKey);
-        if (endLen > 0)
-        {
-            endBytes = (*env)->GetByteArrayElements(env, endKey, NULL);
-        }
+        slots[i] = (jlong)atomic_load_explicit(&g_metrics[i], memory_order_relaxed);
     }
+}
 
-    int result = tidesdb_compact_range(cf, (const uint8_t *)startBytes, (size_t)startLen,
-                                       (const uint8_t *)endBytes, (size_t)endLen);
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeSetLatencyTracking(JNIEnv *env, jclass cls,
+                                                                          jboolean enabled)
+{
+    atomic_store(&g_latency_enabled, enabled ? 1 : 0);
+}
 
-    if (startBytes != NULL)
+JNIEXPORT jlongArray JNICALL Java_com_tidesdb_TidesDB_nativeLatencySnapshot(JNIEnv *env,
+                                                                            jclass cls)
+{
+    jlong *sums = (jlong *)calloc(LATENCY_OPS * LATENCY_BUCKETS, sizeof(jlong));
+    if (sums == NULL)
     {
-        (*env)->ReleaseByteArrayElements(env, startKey, startBytes, JNI_ABORT);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
     }
-    if (endBytes != NULL)
+
+    for (latency_block_t *block = atomic_load(&g_latency_blocks); block != NULL;
+         block = block->next)
     {
-        (*env)->ReleaseByteArrayElements(env, endKey, endBytes, JNI_ABORT);
+        for (int op = 0; op < LATENCY_OPS; op++)
+        {
+            for (int b = 0; b < LATENCY_BUCKETS; b++)
+            {
+                sums[op * LATENCY_BUCKETS + b] +=
+                    (jlong)atomic_load_explicit(&block->counts[op][b], memory_order_relaxed);
+            }
+        }
     }
 
-    if (result != TDB_SUCCESS)
+    jlongArray result = (*env)->NewLongArray(env, LATENCY_OPS * LATENCY_BUCKETS);
+    if (result != NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        (*env)->SetLongArrayRegion(env, result, 0, LATENCY_OPS * LATENCY_BUCKETS, sums);
     }
+    free(sums);
+    return result;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeFlushMemtable(JNIEnv *env, jclass cls,
-                                                                         jlong handle)
+/**
+ * Claims a free per-database latency slot, clearing the counts its previous owner left, or
+ * returns -1 when every slot is taken.
+ */
+JNIEXPORT jint JNICALL Java_com_tidesdb_TidesDB_nativeAcquireLatencySlot(JNIEnv *env, jclass cls)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    int result = tidesdb_flush_memtable(cf);
-
-    if (result != TDB_SUCCESS)
+    unsigned used = atomic_load(&g_latency_db_slots);
+    for (;;)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        int slot = 0;
+        while (slot < LATENCY_DB_SLOTS && (used & (1u << slot)) != 0)
+        {
+            slot++;
+        }
+        if (slot == LATENCY_DB_SLOTS)
+        {
+            return -1;
+        }
+        if (atomic_compare_exchange_weak(&g_latency_db_slots, &used, used | (1u << slot)))
+        {
+            for (latency_block_t *block = atomic_load(&g_latency_blocks); block != NULL;
+                 block = block->next)
+            {
+                for (int b = 0; b < LATENCY_BUCKETS; b++)
+                {
+                    atomic_store_explicit(&block->db_gets[slot][b], 0, memory_order_relaxed);
+                }
+            }
+            return slot;
+        }
     }
 }
 
-JNIEXPORT jboolean JNICALL Java_com_tidesdb_ColumnFamily_nativeIsFlushing(JNIEnv *env, jclass cls,
-                                                                          jlong handle)
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeReleaseLatencySlot(JNIEnv *env, jclass cls,
+                                                                          jint slot)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    return tidesdb_is_flushing(cf) != 0;
+    if ((unsigned)slot < LATENCY_DB_SLOTS)
+    {
+        atomic_fetch_and(&g_latency_db_slots, ~(1u << slot));
+    }
 }
 
-JNIEXPORT jboolean JNICALL Java_com_tidesdb_ColumnFamily_nativeIsCompacting(JNIEnv *env, jclass cls,
-                                                                            jlong handle)
+JNIEXPORT jlongArray JNICALL Java_com_tidesdb_TidesDB_nativeDbGetLatencySnapshot(JNIEnv *env,
+                                                                                 jclass cls,
+                                                                                 jint slot)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    return tidesdb_is_compacting(cf) != 0;
+    jlong sums[LATENCY_BUCKETS] = {0};
+    if ((unsigned)slot < LATENCY_DB_SLOTS)
+    {
+        for (latency_block_t *block = atomic_load(&g_latency_blocks); block != NULL;
+             block = block->next)
+        {
+            for (int b = 0; b < LATENCY_BUCKETS; b++)
+            {
+                sums[b] +=
+                    (jlong)atomic_load_explicit(&block->db_gets[slot][b], memory_order_relaxed);
+            }
+        }
+    }
+
+    jlongArray result = (*env)->NewLongArray(env, LATENCY_BUCKETS);
+    if (result != NULL)
+    {
+        (*env)->SetLongArrayRegion(env, result, 0, LATENCY_BUCKETS, sums);
+    }
+    return result;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeUpdateRuntimeConfig(
-    JNIEnv *env, jclass cls, jlong handle, jlong writeBufferSize, jint skipListMaxLevel,
-    jfloat skipListProbability, jdouble bloomFPR, jint indexSampleRatio, jint syncMode,
-    jlong syncIntervalUs, jboolean persistToDisk)
+JNIEXPORT jdouble JNICALL Java_com_tidesdb_ColumnFamily_nativeRangeCost(JNIEnv *env, jclass cls,
+                                                                         jlong handle,
+                                                                         jbyteArray keyA,
+                                                                         jbyteArray keyB)
 {
     tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
 
-    tidesdb_column_family_config_t config = {.write_buffer_size = (size_t)writeBufferSize,
-                                             .skip_list_max_level = skipListMaxLevel,
-                                             .skip_list_probability = skipListProbability,
-                                             .bloom_fpr = bloomFPR,
-                                             .index_sample_ratio = indexSampleRatio,
-                                             .sync_mode = syncMode,
-                                             .sync_interval_us = (uint64_t)syncIntervalUs};
+    jsize keyALen = (*env)->GetArrayLength(env, keyA);
+    jsize keyBLen = (*env)->GetArrayLength(env, keyB);
 
-    int result = tidesdb_cf_update_runtime_config(cf, &config, persistToDisk ? 1 : 0);
+    jbyte *keyABytes = (*env)->GetByteArrayElements(env, keyA, NULL);
+    jbyte *keyBBytes = (*env)->GetByteArrayElements(env, keyB, NULL);
+
+    double cost = 0.0;
+    int result = tidesdb_range_cost(cf, (uint8_t *)keyABytes, keyALen, (uint8_t *)keyBBytes,
+                                    keyBLen, &cost);
+
+    (*env)->ReleaseByteArrayElements(env, keyA, keyABytes, JNI_ABORT);
+    (*env)->ReleaseByteArrayElements(env, keyB, keyBBytes, JNI_ABORT);
 
     if (result != TDB_SUCCESS)
     {
         throwTidesDBException(env, result, getErrorMessage(result));
+        return 0.0;
     }
+
+    return (jdouble)cost;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePut(JNIEnv *env, jclass cls, jlong handle,
-                                                              jlong cfHandle, jbyteArray key,
-                                                              jbyteArray value, jlong ttl)
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeDeleteColumnFamily(JNIEnv *env, jclass cls,
+                                                                          jlong handle,
+                                                                          jlong cfHandle)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
     tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
 
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jsize valueLen = (*env)->GetArrayLength(env, value);
+    int result = tidesdb_delete_column_family(db, cf);
 
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
-    jbyte *valueBytes = (*env)->GetByteArrayElements(env, value, NULL);
+    if (result != TDB_SUCCESS)
+    {
+        throwTidesDBException(env, result, getErrorMessage(result));
+    }
+}
 
-    int result = tidesdb_txn_put(txn, cf, (uint8_t *)keyBytes, keyLen, (uint8_t *)valueBytes,
-                                 valueLen, (time_t)ttl);
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativePromoteToPrimary(JNIEnv *env, jclass cls,
+                                                                        jlong handle)
+{
+    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
 
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
-    (*env)->ReleaseByteArrayElements(env, value, valueBytes, JNI_ABORT);
+    int result = tidesdb_promote_to_primary(db);
 
     if (result != TDB_SUCCESS)
     {
@@ -788,685 +4588,1293 @@ JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativePut(JNIEnv *env, jclas
     }
 }
 
-JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_Transaction_nativeGet(JNIEnv *env, jclass cls,
-                                                                    jlong handle, jlong cfHandle,
-                                                                    jbyteArray key)
+JNIEXPORT jint JNICALL Java_com_tidesdb_Config_nativeDefaultMaxConcurrentFlushes(JNIEnv *env,
+                                                                                  jclass cls)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+    tidesdb_config_t cfg = tidesdb_default_config();
+    return (jint)cfg.max_concurrent_flushes;
+}
 
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+JNIEXPORT jdouble JNICALL Java_com_tidesdb_ColumnFamilyConfig_nativeDefaultTombstoneDensityTrigger(
+    JNIEnv *env, jclass cls)
+{
+    tidesdb_column_family_config_t cfg = tidesdb_default_column_family_config();
+    return (jdouble)cfg.tombstone_density_trigger;
+}
+
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamilyConfig_nativeDefaultTombstoneDensityMinEntries(
+    JNIEnv *env, jclass cls)
+{
+    tidesdb_column_family_config_t cfg = tidesdb_default_column_family_config();
+    return (jlong)cfg.tombstone_density_min_entries;
+}
 
+JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDBIterator_nativeKeyValue(JNIEnv *env, jclass cls,
+                                                                           jlong handle)
+{
+    jni_iter_t *it = (jni_iter_t *)(uintptr_t)handle;
+    uint8_t *key = NULL;
+    size_t keyLen = 0;
     uint8_t *value = NULL;
     size_t valueLen = 0;
 
-    int result = tidesdb_txn_get(txn, cf, (uint8_t *)keyBytes, keyLen, &value, &valueLen);
-
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
-
+    int result = jni_iter_check(it);
+    if (result == TDB_SUCCESS)
+    {
+        result = tidesdb_iter_key_value(it->iter, &key, &keyLen, &value, &valueLen);
+    }
     if (result != TDB_SUCCESS)
     {
         throwTidesDBException(env, result, getErrorMessage(result));
         return NULL;
     }
 
-    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
-    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
-    free(value);
+    jbyteArray jkey = (*env)->NewByteArray(env, keyLen);
+    (*env)->SetByteArrayRegion(env, jkey, 0, keyLen, (jbyte *)key);
 
-    return resultArray;
+    jbyteArray jvalue = (*env)->NewByteArray(env, valueLen);
+    (*env)->SetByteArrayRegion(env, jvalue, 0, valueLen, (jbyte *)value);
+    metric_add(METRIC_BYTES_OUT, (uint64_t)keyLen + (uint64_t)valueLen);
+
+    return (*env)->NewObject(env, g_key_value_class, g_key_value_ctor, jkey, jvalue);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeDelete(JNIEnv *env, jclass cls,
-                                                                 jlong handle, jlong cfHandle,
-                                                                 jbyteArray key)
+/*
+ * Asynchronous operations. Each TidesDB instance lazily owns a pool of native worker threads
+ * fed by a bounded FIFO queue. A job owns copies of its inputs and a global reference to the
+ * CompletableFuture it completes, so the submitting thread returns as soon as the job is
+ * queued. Workers attach to the JVM once, as daemons, and stay attached until the pool is
+ * destroyed.
+ */
+typedef enum
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
-
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
-
-    int result = tidesdb_txn_delete(txn, cf, (uint8_t *)keyBytes, keyLen);
+    ASYNC_OP_GET,
+    ASYNC_OP_COMMIT,
+    ASYNC_OP_MULTI_GET,
+    ASYNC_OP_BACKUP
+} async_op_t;
 
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+typedef struct async_job_t
+{
+    struct async_job_t *next;
+    async_op_t op;
+    jobject future; /* global reference to the CompletableFuture */
+    tidesdb_t *db;
+    tidesdb_txn_t *txn;
+    tidesdb_column_family_t *cf;
+    uint8_t *data; /* key, multiGet key arena or NUL-terminated backup path */
+    size_t data_len;
+    multi_get_entry_t *entries;
+    jsize count;
+    jint latency_slot; /* database latency slot gets are recorded against */
+} async_job_t;
 
-    if (result != TDB_SUCCESS)
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    async_job_t *head;
+    async_job_t *tail;
+    int queued;
+    int capacity;
+    int shutdown;
+    int num_threads; /* threads created, all of which must be joined */
+    int num_ready;   /* threads that have reported whether they attached */
+    int num_workers; /* threads attached to the JVM and serving the queue */
+    pthread_cond_t ready;
+    pthread_t *threads;
+} async_pool_t;
+
+static void async_complete(JNIEnv *env, jobject future, jobject value)
+{
+    (*env)->CallBooleanMethod(env, future, g_future_complete, value);
+    if ((*env)->ExceptionCheck(env))
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        (*env)->ExceptionClear(env);
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeSingleDelete(JNIEnv *env, jclass cls,
-                                                                       jlong handle,
-                                                                       jlong cfHandle,
-                                                                       jbyteArray key)
+/**
+ * Completes the future exceptionally. A Java exception already pending on this thread (an
+ * OutOfMemoryError from building the result) takes precedence over the error code.
+ */
+static void async_fail(JNIEnv *env, jobject future, int errorCode)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
-
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
-
-    int result = tidesdb_txn_single_delete(txn, cf, (uint8_t *)keyBytes, keyLen);
+    jthrowable cause = (*env)->ExceptionOccurred(env);
+    if (cause != NULL)
+    {
+        (*env)->ExceptionClear(env);
+    }
+    else
+    {
+        int codeSlot = (errorCode < 0 && -errorCode < METRIC_EXCEPTION_CODES) ? -errorCode : 0;
+        metric_add(METRIC_EXCEPTIONS + codeSlot, 1);
 
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+        jstring jMessage = (*env)->NewStringUTF(env, getErrorMessage(errorCode));
+        if (jMessage != NULL)
+        {
+            cause = (jthrowable)(*env)->NewObject(env, g_exception_class, g_exception_ctor,
+                                                  jMessage, errorCode);
+        }
+        if (cause == NULL)
+        {
+            (*env)->ExceptionClear(env);
+            return;
+        }
+    }
 
-    if (result != TDB_SUCCESS)
+    (*env)->CallBooleanMethod(env, future, g_future_complete_exceptionally, cause);
+    if ((*env)->ExceptionCheck(env))
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        (*env)->ExceptionClear(env);
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeCommit(JNIEnv *env, jclass cls,
-                                                                 jlong handle)
+static void async_run(JNIEnv *env, async_job_t *job)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    int result = tidesdb_txn_commit(txn);
+    if ((*env)->PushLocalFrame(env, 8) != JNI_OK)
+    {
+        (*env)->ExceptionClear(env);
+        return;
+    }
 
-    if (result != TDB_SUCCESS)
+    switch (job->op)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        case ASYNC_OP_GET:
+        {
+            uint8_t *value = NULL;
+            size_t valueLen = 0;
+            metric_add(METRIC_READS, 1);
+            uint64_t started = latency_start();
+            int result =
+                tidesdb_txn_get(job->txn, job->cf, job->data, job->data_len, &value, &valueLen);
+            latency_end_get(job->latency_slot, started);
+            if (result != TDB_SUCCESS)
+            {
+                async_fail(env, job->future, result);
+                break;
+            }
+            jbyteArray jvalue = (*env)->NewByteArray(env, (jsize)valueLen);
+            if (jvalue != NULL)
+            {
+                (*env)->SetByteArrayRegion(env, jvalue, 0, (jsize)valueLen, (jbyte *)value);
+                metric_add(METRIC_BYTES_OUT, valueLen);
+            }
+            free(value);
+            if (jvalue == NULL)
+            {
+                async_fail(env, job->future, TDB_ERR_MEMORY);
+                break;
+            }
+            async_complete(env, job->future, jvalue);
+            break;
+        }
+        case ASYNC_OP_COMMIT:
+        {
+            metric_add(METRIC_COMMITS, 1);
+            uint64_t started = latency_start();
+            int result = tidesdb_txn_commit(job->txn);
+            latency_end(LATENCY_COMMIT, started);
+            if (result != TDB_SUCCESS)
+            {
+                async_fail(env, job->future, result);
+                break;
+            }
+            async_complete(env, job->future, NULL);
+            break;
+        }
+        case ASYNC_OP_MULTI_GET:
+        {
+            int result = multi_get_resolve(job->txn, job->cf, job->entries, job->count,
+                                           job->latency_slot);
+            if (result != TDB_SUCCESS)
+            {
+                async_fail(env, job->future, result);
+                break;
+            }
+            jobjectArray values = multi_get_to_array(env, job->entries, job->count);
+            multi_get_free_values(job->entries, job->count);
+            if (values == NULL)
+            {
+                async_fail(env, job->future, TDB_ERR_MEMORY);
+                break;
+            }
+            async_complete(env, job->future, values);
+            break;
+        }
+        case ASYNC_OP_BACKUP:
+        {
+            int result = tidesdb_backup(job->db, (char *)job->data);
+            if (result != TDB_SUCCESS)
+            {
+                async_fail(env, job->future, result);
+                break;
+            }
+            async_complete(env, job->future, NULL);
+            break;
+        }
     }
+
+    (*env)->PopLocalFrame(env, NULL);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeRollback(JNIEnv *env, jclass cls,
-                                                                   jlong handle)
+static void async_job_free(JNIEnv *env, async_job_t *job)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    int result = tidesdb_txn_rollback(txn);
-
-    if (result != TDB_SUCCESS)
+    if (job->future != NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        (*env)->DeleteGlobalRef(env, job->future);
     }
+    free(job->entries);
+    free(job->data);
+    free(job);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeSavepoint(JNIEnv *env, jclass cls,
-                                                                    jlong handle, jstring name)
+static void *async_worker(void *arg)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
-
-    int result = tidesdb_txn_savepoint(txn, spName);
+    async_pool_t *pool = (async_pool_t *)arg;
 
-    (*env)->ReleaseStringUTFChars(env, name, spName);
+    JNIEnv *env = attach_thread_env("tidesdb-async");
+    pthread_mutex_lock(&pool->lock);
+    pool->num_ready++;
+    if (env != NULL)
+    {
+        pool->num_workers++;
+    }
+    pthread_cond_signal(&pool->ready);
+    pthread_mutex_unlock(&pool->lock);
+    if (env == NULL)
+    {
+        return NULL;
+    }
 
-    if (result != TDB_SUCCESS)
+    for (;;)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        pthread_mutex_lock(&pool->lock);
+        while (pool->head == NULL && !pool->shutdown)
+        {
+            pthread_cond_wait(&pool->not_empty, &pool->lock);
+        }
+        async_job_t *job = pool->head;
+        if (job == NULL)
+        {
+            /* shut down and fully drained */
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        pool->head = job->next;
+        if (pool->head == NULL)
+        {
+            pool->tail = NULL;
+        }
+        pool->queued--;
+        pthread_mutex_unlock(&pool->lock);
+
+        async_run(env, job);
+        async_job_free(env, job);
     }
+
+    return NULL;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeRollbackToSavepoint(JNIEnv *env,
-                                                                              jclass cls,
-                                                                              jlong handle,
-                                                                              jstring name)
+/**
+ * Queues a job. Returns JNI_FALSE, leaving the job to the caller, when the queue is full or
+ * the pool is shutting down.
+ */
+static jboolean async_submit(async_pool_t *pool, async_job_t *job)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
-
-    int result = tidesdb_txn_rollback_to_savepoint(txn, spName);
+    pthread_mutex_lock(&pool->lock);
+    if (pool->shutdown || pool->queued >= pool->capacity)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        return JNI_FALSE;
+    }
 
-    (*env)->ReleaseStringUTFChars(env, name, spName);
+    job->next = NULL;
+    if (pool->tail != NULL)
+    {
+        pool->tail->next = job;
+    }
+    else
+    {
+        pool->head = job;
+    }
+    pool->tail = job;
+    pool->queued++;
+    pthread_cond_signal(&pool->not_empty);
+    pthread_mutex_unlock(&pool->lock);
+    return JNI_TRUE;
+}
 
-    if (result != TDB_SUCCESS)
+/**
+ * Allocates a job holding a global reference to the future. Throws and returns NULL on
+ * failure.
+ */
+static async_job_t *async_job_new(JNIEnv *env, async_op_t op, jobject future)
+{
+    async_job_t *job = calloc(1, sizeof(*job));
+    if (job == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
+    }
+    job->op = op;
+    job->future = (*env)->NewGlobalRef(env, future);
+    if (job->future == NULL)
+    {
+        free(job);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
     }
+    return job;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeReleaseSavepoint(JNIEnv *env, jclass cls,
-                                                                           jlong handle,
-                                                                           jstring name)
+static jboolean async_enqueue(JNIEnv *env, jlong poolHandle, async_job_t *job)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    const char *spName = (*env)->GetStringUTFChars(env, name, NULL);
-
-    int result = tidesdb_txn_release_savepoint(txn, spName);
-
-    (*env)->ReleaseStringUTFChars(env, name, spName);
-
-    if (result != TDB_SUCCESS)
+    async_pool_t *pool = (async_pool_t *)(uintptr_t)poolHandle;
+    if (!async_submit(pool, job))
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        async_job_free(env, job);
+        return JNI_FALSE;
     }
+    return JNI_TRUE;
 }
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_Transaction_nativeNewIterator(JNIEnv *env, jclass cls,
-                                                                       jlong handle, jlong cfHandle)
+JNIEXPORT jlong JNICALL Java_com_tidesdb_AsyncPool_nativeCreate(JNIEnv *env, jclass cls,
+                                                                jint numThreads,
+                                                                jint queueCapacity)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
-    tidesdb_iter_t *iter = NULL;
-
-    int result = tidesdb_iter_new(txn, cf, &iter);
-    if (result != TDB_SUCCESS)
+    async_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return 0;
+    }
+    pool->threads = calloc((size_t)numThreads, sizeof(*pool->threads));
+    if (pool->threads == NULL)
+    {
+        free(pool);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
         return 0;
     }
+    pool->capacity = queueCapacity;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->not_empty, NULL);
+    pthread_cond_init(&pool->ready, NULL);
 
-    return (jlong)(uintptr_t)iter;
-}
+    for (jint i = 0; i < numThreads; i++)
+    {
+        if (pthread_create(&pool->threads[i], NULL, async_worker, pool) != 0)
+        {
+            break;
+        }
+        pool->num_threads++;
+    }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeReset(JNIEnv *env, jclass cls,
-                                                                jlong handle, jint isolationLevel)
-{
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    int result = tidesdb_txn_reset(txn, (tidesdb_isolation_level_t)isolationLevel);
+    /* a thread that failed to attach has already exited and serves nothing */
+    pthread_mutex_lock(&pool->lock);
+    while (pool->num_ready < pool->num_threads)
+    {
+        pthread_cond_wait(&pool->ready, &pool->lock);
+    }
+    int workers = pool->num_workers;
+    if (workers == 0)
+    {
+        pool->shutdown = 1;
+    }
+    pthread_mutex_unlock(&pool->lock);
 
-    if (result != TDB_SUCCESS)
+    if (workers == 0)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        for (int i = 0; i < pool->num_threads; i++)
+        {
+            pthread_join(pool->threads[i], NULL);
+        }
+        pthread_cond_destroy(&pool->ready);
+        pthread_cond_destroy(&pool->not_empty);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->threads);
+        free(pool);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "failed to start async worker threads");
+        return 0;
     }
+
+    return (jlong)(uintptr_t)pool;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_Transaction_nativeFree(JNIEnv *env, jclass cls,
-                                                               jlong handle)
+/**
+ * Stops accepting jobs, lets the workers drain everything already queued, then joins them.
+ * Must run before the database the jobs refer to is closed.
+ */
+JNIEXPORT void JNICALL Java_com_tidesdb_AsyncPool_nativeDestroy(JNIEnv *env, jclass cls,
+                                                                jlong handle)
 {
-    tidesdb_txn_t *txn = (tidesdb_txn_t *)(uintptr_t)handle;
-    if (txn != NULL)
+    async_pool_t *pool = (async_pool_t *)(uintptr_t)handle;
+    if (pool == NULL)
     {
-        tidesdb_txn_free(txn);
+        return;
     }
-}
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekToFirst(JNIEnv *env, jclass cls,
-                                                                          jlong handle)
-{
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    int result = tidesdb_iter_seek_to_first(iter);
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->not_empty);
+    pthread_mutex_unlock(&pool->lock);
 
-    if (result != TDB_SUCCESS)
+    for (int i = 0; i < pool->num_threads; i++)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        pthread_join(pool->threads[i], NULL);
     }
+
+    pthread_cond_destroy(&pool->ready);
+    pthread_cond_destroy(&pool->not_empty);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekToLast(JNIEnv *env, jclass cls,
-                                                                         jlong handle)
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_AsyncPool_nativeSubmitGet(JNIEnv *env, jclass cls,
+                                                                      jlong handle,
+                                                                      jlong txnHandle,
+                                                                      jlong cfHandle,
+                                                                      jbyteArray key,
+                                                                      jint latencySlot,
+                                                                      jobject future)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    int result = tidesdb_iter_seek_to_last(iter);
+    async_job_t *job = async_job_new(env, ASYNC_OP_GET, future);
+    if (job == NULL)
+    {
+        return JNI_FALSE;
+    }
+    job->txn = (tidesdb_txn_t *)(uintptr_t)txnHandle;
+    job->cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+    job->latency_slot = latencySlot;
 
-    if (result != TDB_SUCCESS)
+    jsize keyLen = (*env)->GetArrayLength(env, key);
+    job->data = malloc((size_t)keyLen);
+    if (job->data == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        async_job_free(env, job);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return JNI_FALSE;
     }
+    job->data_len = (size_t)keyLen;
+    (*env)->GetByteArrayRegion(env, key, 0, keyLen, (jbyte *)job->data);
+
+    return async_enqueue(env, handle, job);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeek(JNIEnv *env, jclass cls,
-                                                                   jlong handle, jbyteArray key)
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_AsyncPool_nativeSubmitCommit(JNIEnv *env, jclass cls,
+                                                                         jlong handle,
+                                                                         jlong txnHandle,
+                                                                         jobject future)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
+    async_job_t *job = async_job_new(env, ASYNC_OP_COMMIT, future);
+    if (job == NULL)
+    {
+        return JNI_FALSE;
+    }
+    job->txn = (tidesdb_txn_t *)(uintptr_t)txnHandle;
 
-    int result = tidesdb_iter_seek(iter, (uint8_t *)keyBytes, keyLen);
+    return async_enqueue(env, handle, job);
+}
 
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_AsyncPool_nativeSubmitMultiGet(
+    JNIEnv *env, jclass cls, jlong handle, jlong txnHandle, jlong cfHandle, jobjectArray keys,
+    jint latencySlot, jobject future)
+{
+    async_job_t *job = async_job_new(env, ASYNC_OP_MULTI_GET, future);
+    if (job == NULL)
+    {
+        return JNI_FALSE;
+    }
+    job->txn = (tidesdb_txn_t *)(uintptr_t)txnHandle;
+    job->cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
+    job->latency_slot = latencySlot;
+    job->count = (*env)->GetArrayLength(env, keys);
 
-    if (result != TDB_SUCCESS)
+    if (multi_get_copy_keys(env, keys, job->count, &job->entries, &job->data) != 0)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        async_job_free(env, job);
+        return JNI_FALSE;
     }
+
+    return async_enqueue(env, handle, job);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeSeekForPrev(JNIEnv *env, jclass cls,
-                                                                          jlong handle,
-                                                                          jbyteArray key)
+JNIEXPORT jboolean JNICALL Java_com_tidesdb_AsyncPool_nativeSubmitBackup(JNIEnv *env, jclass cls,
+                                                                         jlong handle,
+                                                                         jlong dbHandle,
+                                                                         jstring dir,
+                                                                         jobject future)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    jsize keyLen = (*env)->GetArrayLength(env, key);
-    jbyte *keyBytes = (*env)->GetByteArrayElements(env, key, NULL);
-
-    int result = tidesdb_iter_seek_for_prev(iter, (uint8_t *)keyBytes, keyLen);
+    async_job_t *job = async_job_new(env, ASYNC_OP_BACKUP, future);
+    if (job == NULL)
+    {
+        return JNI_FALSE;
+    }
+    job->db = (tidesdb_t *)(uintptr_t)dbHandle;
 
-    (*env)->ReleaseByteArrayElements(env, key, keyBytes, JNI_ABORT);
+    const char *backupDir = (*env)->GetStringUTFChars(env, dir, NULL);
+    if (backupDir == NULL)
+    {
+        async_job_free(env, job);
+        return JNI_FALSE; /* OutOfMemoryError pending */
+    }
+    size_t len = strlen(backupDir);
+    job->data = malloc(len + 1);
+    if (job->data != NULL)
+    {
+        memcpy(job->data, backupDir, len + 1);
+        job->data_len = len;
+    }
+    (*env)->ReleaseStringUTFChars(env, dir, backupDir);
 
-    if (result != TDB_SUCCESS)
+    if (job->data == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        async_job_free(env, job);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return JNI_FALSE;
     }
+
+    return async_enqueue(env, handle, job);
 }
 
-JNIEXPORT jboolean JNICALL Java_com_tidesdb_TidesDBIterator_nativeValid(JNIEnv *env, jclass cls,
-                                                                        jlong handle)
+/*
+ * Event monitor. The engine has no event callbacks, so one native thread per database samples
+ * its state every interval and turns transitions into events for an EventListener. Nothing runs
+ * on engine threads, and Java is only called when something changed. Event types are mirrored
+ * in EventType.java. Sampling holds the monitor lock; Java takes it around column family drops
+ * so the monitor never touches a column family that is being freed. Events are delivered after
+ * the lock is released, so listeners may call back into the database.
+ */
+#define EVENT_MEMORY_PRESSURE    0 /* value: new level, duration: previous level */
+#define EVENT_WRITE_STALL_BEGIN  1 /* value: immutable memtables queued */
+#define EVENT_WRITE_STALL_END    2 /* value: immutable memtables queued */
+#define EVENT_FLUSH_BEGIN        3
+#define EVENT_FLUSH_END          4 /* value: bytes added to SSTables */
+#define EVENT_COMPACTION_BEGIN   5
+#define EVENT_COMPACTION_END     6 /* value: bytes reclaimed */
+
+typedef struct
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    return tidesdb_iter_valid(iter) != 0;
-}
+    char *name;
+    int flushing;
+    int compacting;
+    int stall_threshold;
+    int known;
+    int seen;
+    uint64_t flush_started;
+    uint64_t compaction_started;
+    int64_t flush_start_bytes;
+    int64_t compaction_start_bytes;
+} monitor_cf_t;
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeNext(JNIEnv *env, jclass cls,
-                                                                   jlong handle)
+typedef struct
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    int result = tidesdb_iter_next(iter);
+    int type;
+    char *cf_name;
+    int64_t value;
+    int64_t duration_us;
+} monitor_event_t;
 
-    /* TDB_ERR_NOT_FOUND is expected when reaching end of iteration -- iterator becomes invalid */
-    if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
-    {
-        throwTidesDBException(env, result, getErrorMessage(result));
-    }
+typedef struct
+{
+    tidesdb_t *db;
+    jobject listener;
+    uint64_t interval_us;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    int stop;
+    int paused;
+    int memory_pressure;
+    int stalled;
+    uint64_t stall_started;
+    monitor_cf_t *cfs;
+    int num_cfs;
+    monitor_event_t *events;
+    int num_events;
+    int cap_events;
+} event_monitor_t;
+
+static uint64_t monitor_now_us(void)
+{
+    return latency_now() / 1000u;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativePrev(JNIEnv *env, jclass cls,
-                                                                   jlong handle)
+static void monitor_emit(event_monitor_t *m, int type, const char *cf_name, int64_t value,
+                         int64_t duration_us)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    int result = tidesdb_iter_prev(iter);
+    if (m->num_events == m->cap_events)
+    {
+        int cap = m->cap_events > 0 ? m->cap_events * 2 : 16;
+        monitor_event_t *grown = realloc(m->events, (size_t)cap * sizeof(*grown));
+        if (grown == NULL)
+        {
+            return; /* the transition is still tracked, only this event is lost */
+        }
+        m->events = grown;
+        m->cap_events = cap;
+    }
 
-    /* TDB_ERR_NOT_FOUND is expected when reaching start of iteration -- iterator becomes invalid */
-    if (result != TDB_SUCCESS && result != TDB_ERR_NOT_FOUND)
+    monitor_event_t *e = &m->events[m->num_events];
+    e->cf_name = cf_name != NULL ? strdup(cf_name) : NULL;
+    if (cf_name != NULL && e->cf_name == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        return;
     }
+    e->type = type;
+    e->value = value;
+    e->duration_us = duration_us;
+    m->num_events++;
 }
 
-JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_TidesDBIterator_nativeKey(JNIEnv *env, jclass cls,
-                                                                        jlong handle)
+/** Sum of SSTable bytes across levels, the base for flush and compaction byte counts. */
+static int64_t monitor_level_bytes(tidesdb_column_family_t *cf, int *stall_threshold)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    uint8_t *key = NULL;
-    size_t keyLen = 0;
-
-    int result = tidesdb_iter_key(iter, &key, &keyLen);
-    if (result != TDB_SUCCESS)
+    tidesdb_stats_t *stats = NULL;
+    if (tidesdb_get_stats(cf, &stats) != TDB_SUCCESS)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return NULL;
+        return 0;
     }
 
-    jbyteArray resultArray = (*env)->NewByteArray(env, keyLen);
-    (*env)->SetByteArrayRegion(env, resultArray, 0, keyLen, (jbyte *)key);
-
-    return resultArray;
+    int64_t bytes = 0;
+    for (int i = 0; i < stats->num_levels && stats->level_sizes != NULL; i++)
+    {
+        bytes += (int64_t)stats->level_sizes[i];
+    }
+    if (stall_threshold != NULL && stats->config != NULL)
+    {
+        *stall_threshold = stats->config->l0_queue_stall_threshold;
+    }
+    tidesdb_free_stats(stats);
+    return bytes;
 }
 
-JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_TidesDBIterator_nativeValue(JNIEnv *env, jclass cls,
-                                                                          jlong handle)
+static monitor_cf_t *monitor_find_cf(event_monitor_t *m, const char *name)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    uint8_t *value = NULL;
-    size_t valueLen = 0;
+    for (int i = 0; i < m->num_cfs; i++)
+    {
+        if (strcmp(m->cfs[i].name, name) == 0)
+        {
+            return &m->cfs[i];
+        }
+    }
 
-    int result = tidesdb_iter_value(iter, &value, &valueLen);
-    if (result != TDB_SUCCESS)
+    monitor_cf_t *grown = realloc(m->cfs, (size_t)(m->num_cfs + 1) * sizeof(*grown));
+    if (grown == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
         return NULL;
     }
+    m->cfs = grown;
 
-    jbyteArray resultArray = (*env)->NewByteArray(env, valueLen);
-    (*env)->SetByteArrayRegion(env, resultArray, 0, valueLen, (jbyte *)value);
-
-    return resultArray;
-}
-
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDBIterator_nativeFree(JNIEnv *env, jclass cls,
-                                                                   jlong handle)
-{
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    if (iter != NULL)
+    monitor_cf_t *state = &m->cfs[m->num_cfs];
+    memset(state, 0, sizeof(*state));
+    state->name = strdup(name);
+    if (state->name == NULL)
     {
-        tidesdb_iter_free(iter);
+        return NULL;
     }
+    m->num_cfs++;
+    return state;
 }
 
 /**
- * Context stored as the commit hook ctx pointer.
- * Holds the JavaVM and a global reference to the Java CommitHook object.
+ * Samples one column family. first is set the first time it is seen: work already running then
+ * has no begin time, so its end is not reported either.
  */
-typedef struct
+static void monitor_sample_cf(event_monitor_t *m, tidesdb_column_family_t *cf,
+                              monitor_cf_t *state, uint64_t now, int first)
 {
-    JavaVM *jvm;
-    jobject hook_obj; /* global reference to CommitHook */
-} java_hook_ctx_t;
+    int flushing = tidesdb_is_flushing(cf) != 0;
+    int compacting = tidesdb_is_compacting(cf) != 0;
+    int flushBegin = !first && flushing && !state->flushing;
+    int flushEnd = !first && !flushing && state->flushing && state->flush_started != 0;
+    int compactionBegin = !first && compacting && !state->compacting;
+    int compactionEnd =
+        !first && !compacting && state->compacting && state->compaction_started != 0;
+
+    if (first || flushBegin || flushEnd || compactionBegin || compactionEnd)
+    {
+        int64_t bytes = monitor_level_bytes(cf, &state->stall_threshold);
 
-/**
- * C trampoline that bridges the tidesdb_commit_hook_fn callback to the Java CommitHook.onCommit
- * method. Fires synchronously on the committing thread (which is always a Java thread).
- */
-static int java_commit_hook_trampoline(const tidesdb_commit_op_t *ops, int num_ops,
-                                        uint64_t commit_seq, void *ctx)
-{
-    java_hook_ctx_t *hctx = (java_hook_ctx_t *)ctx;
-    JNIEnv *env = NULL;
-    int need_detach = 0;
+        if (flushBegin)
+        {
+            state->flush_started = now;
+            state->flush_start_bytes = bytes;
+            monitor_emit(m, EVENT_FLUSH_BEGIN, state->name, 0, 0);
+        }
+        else if (flushEnd)
+        {
+            int64_t added = bytes - state->flush_start_bytes;
+            monitor_emit(m, EVENT_FLUSH_END, state->name, added > 0 ? added : 0,
+                         (int64_t)(now - state->flush_started));
+        }
+
+        if (compactionBegin)
+        {
+            state->compaction_started = now;
+            state->compaction_start_bytes = bytes;
+            monitor_emit(m, EVENT_COMPACTION_BEGIN, state->name, 0, 0);
+        }
+        else if (compactionEnd)
+        {
+            int64_t reclaimed = state->compaction_start_bytes - bytes;
+            monitor_emit(m, EVENT_COMPACTION_END, state->name, reclaimed > 0 ? reclaimed : 0,
+                         (int64_t)(now - state->compaction_started));
+        }
+    }
 
-    jint rc = (*hctx->jvm)->GetEnv(hctx->jvm, (void **)&env, JNI_VERSION_1_6);
-    if (rc == JNI_EDETACHED)
+    if (!flushing)
     {
-        if ((*hctx->jvm)->AttachCurrentThread(hctx->jvm, (void **)&env, NULL) != 0)
-            return -1;
-        need_detach = 1;
+        state->flush_started = 0;
     }
-    else if (rc != JNI_OK)
+    if (!compacting)
     {
-        return -1;
+        state->compaction_started = 0;
     }
+    state->flushing = flushing;
+    state->compacting = compacting;
+}
 
-    jint ret = -1;
-
-    /* Find CommitOp class and constructor: CommitOp(byte[], byte[], long, boolean) */
-    jclass commitOpClass = (*env)->FindClass(env, "com/tidesdb/CommitOp");
-    if (commitOpClass == NULL)
-        goto cleanup;
-
-    jmethodID ctor = (*env)->GetMethodID(env, commitOpClass, "<init>", "([B[BJZ)V");
-    if (ctor == NULL)
-        goto cleanup;
-
-    /* Create CommitOp[] array */
-    jobjectArray opsArray = (*env)->NewObjectArray(env, num_ops, commitOpClass, NULL);
-    if (opsArray == NULL)
-        goto cleanup;
+/** Takes one sample; called with the monitor lock held. */
+static void monitor_sample(event_monitor_t *m, int first)
+{
+    uint64_t now = monitor_now_us();
 
-    for (int i = 0; i < num_ops; i++)
+    char **names = NULL;
+    int count = 0;
+    if (tidesdb_list_column_families(m->db, &names, &count) == TDB_SUCCESS)
     {
-        jbyteArray jkey = (*env)->NewByteArray(env, (jsize)ops[i].key_size);
-        (*env)->SetByteArrayRegion(env, jkey, 0, (jsize)ops[i].key_size, (jbyte *)ops[i].key);
+        for (int i = 0; i < m->num_cfs; i++)
+        {
+            m->cfs[i].seen = 0;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            tidesdb_column_family_t *cf = tidesdb_get_column_family(m->db, names[i]);
+            monitor_cf_t *state = cf != NULL ? monitor_find_cf(m, names[i]) : NULL;
+            if (state != NULL)
+            {
+                monitor_sample_cf(m, cf, state, now, !state->known);
+                state->known = 1;
+                state->seen = 1;
+            }
+            free(names[i]);
+        }
+        free(names);
 
-        jbyteArray jvalue = NULL;
-        if (ops[i].value != NULL && ops[i].value_size > 0)
+        /* forget column families that were dropped since the last sample */
+        int kept = 0;
+        for (int i = 0; i < m->num_cfs; i++)
         {
-            jvalue = (*env)->NewByteArray(env, (jsize)ops[i].value_size);
-            (*env)->SetByteArrayRegion(env, jvalue, 0, (jsize)ops[i].value_size,
-                                       (jbyte *)ops[i].value);
+            if (m->cfs[i].seen)
+            {
+                m->cfs[kept++] = m->cfs[i];
+            }
+            else
+            {
+                free(m->cfs[i].name);
+            }
         }
+        m->num_cfs = kept;
+    }
 
-        jobject opObj = (*env)->NewObject(env, commitOpClass, ctor, jkey, jvalue,
-                                          (jlong)ops[i].ttl,
-                                          ops[i].is_delete ? JNI_TRUE : JNI_FALSE);
-        (*env)->SetObjectArrayElement(env, opsArray, i, opObj);
+    tidesdb_db_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    if (tidesdb_get_db_stats(m->db, &stats) != TDB_SUCCESS)
+    {
+        return;
+    }
 
-        (*env)->DeleteLocalRef(env, opObj);
-        (*env)->DeleteLocalRef(env, jkey);
-        if (jvalue != NULL)
-            (*env)->DeleteLocalRef(env, jvalue);
+    if (!first && stats.memory_pressure_level != m->memory_pressure)
+    {
+        monitor_emit(m, EVENT_MEMORY_PRESSURE, NULL, stats.memory_pressure_level,
+                     m->memory_pressure);
     }
+    m->memory_pressure = stats.memory_pressure_level;
 
-    /* Call CommitHook.onCommit(CommitOp[], long) */
-    jclass hookClass = (*env)->GetObjectClass(env, hctx->hook_obj);
-    jmethodID onCommit =
-        (*env)->GetMethodID(env, hookClass, "onCommit", "([Lcom/tidesdb/CommitOp;J)I");
+    /* per-CF queue depths are not exposed, so the stall is judged on the database total
+       against the lowest threshold any column family is configured with */
+    int threshold = 0;
+    for (int i = 0; i < m->num_cfs; i++)
+    {
+        if (m->cfs[i].stall_threshold > 0 &&
+            (threshold == 0 || m->cfs[i].stall_threshold < threshold))
+        {
+            threshold = m->cfs[i].stall_threshold;
+        }
+    }
+    int stalled = threshold > 0 && stats.total_immutable_count >= threshold;
+    if (stalled && !m->stalled)
+    {
+        m->stall_started = now;
+        monitor_emit(m, EVENT_WRITE_STALL_BEGIN, NULL, stats.total_immutable_count, 0);
+    }
+    else if (!stalled && m->stalled)
+    {
+        monitor_emit(m, EVENT_WRITE_STALL_END, NULL, stats.total_immutable_count,
+                     (int64_t)(now - m->stall_started));
+    }
+    m->stalled = stalled;
+}
 
-    ret = (*env)->CallIntMethod(env, hctx->hook_obj, onCommit, opsArray, (jlong)commit_seq);
+static void monitor_deliver(JNIEnv *env, event_monitor_t *m, monitor_event_t *events, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        jstring cfName = NULL;
+        if (events[i].cf_name != NULL)
+        {
+            cfName = (*env)->NewStringUTF(env, events[i].cf_name);
+            free(events[i].cf_name);
+        }
+        (*env)->CallStaticVoidMethod(env, g_event_listeners_class, g_event_listeners_deliver,
+                                     m->listener, (jint)events[i].type, cfName,
+                                     (jlong)events[i].value, (jlong)events[i].duration_us);
+        if ((*env)->ExceptionCheck(env))
+        {
+            (*env)->ExceptionClear(env);
+        }
+        if (cfName != NULL)
+        {
+            (*env)->DeleteLocalRef(env, cfName);
+        }
+    }
+}
 
-    if ((*env)->ExceptionCheck(env))
+static void *event_monitor_thread(void *arg)
+{
+    event_monitor_t *m = (event_monitor_t *)arg;
+    JNIEnv *env = attach_thread_env("tidesdb-monitor");
+    if (env == NULL)
     {
-        (*env)->ExceptionClear(env);
-        ret = -1;
+        return NULL;
     }
 
-    (*env)->DeleteLocalRef(env, opsArray);
-    (*env)->DeleteLocalRef(env, commitOpClass);
-    (*env)->DeleteLocalRef(env, hookClass);
-
-    if (need_detach)
-        (*hctx->jvm)->DetachCurrentThread(hctx->jvm);
+    pthread_mutex_lock(&m->lock);
+    int first = 1;
+    while (!m->stop)
+    {
+        monitor_sample(m, first);
+        first = 0;
 
-    return (int)ret;
+        if (m->num_events > 0)
+        {
+            monitor_event_t *events = m->events;
+            int count = m->num_events;
+            m->events = NULL;
+            m->num_events = 0;
+            m->cap_events = 0;
+
+            pthread_mutex_unlock(&m->lock);
+            monitor_deliver(env, m, events, count);
+            free(events);
+            pthread_mutex_lock(&m->lock);
+        }
 
-cleanup:
-    if ((*env)->ExceptionCheck(env))
-        (*env)->ExceptionClear(env);
-    if (need_detach)
-        (*hctx->jvm)->DetachCurrentThread(hctx->jvm);
-    return -1;
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t nsec = (uint64_t)deadline.tv_nsec + (m->interval_us % 1000000u) * 1000u;
+        deadline.tv_sec += (time_t)(m->interval_us / 1000000u + nsec / 1000000000u);
+        deadline.tv_nsec = (long)(nsec % 1000000000u);
+        int rc = 0;
+        while (!m->stop && rc == 0)
+        {
+            /* woken early by a pause or resume; only stop or the deadline end the wait */
+            rc = pthread_cond_timedwait(&m->wake, &m->lock, &deadline);
+        }
+        while (!m->stop && m->paused > 0)
+        {
+            pthread_cond_wait(&m->wake, &m->lock);
+        }
+    }
+    pthread_mutex_unlock(&m->lock);
+    return NULL;
 }
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamily_nativeSetCommitHook(JNIEnv *env, jclass cls,
-                                                                           jlong cfHandle,
-                                                                           jobject hook,
-                                                                           jlong oldCtxHandle)
+JNIEXPORT jlong JNICALL Java_com_tidesdb_TidesDB_nativeStartEventMonitor(JNIEnv *env, jclass cls,
+                                                                         jlong handle,
+                                                                         jobject listener,
+                                                                         jlong intervalUs)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
-
-    /* Free old context if present */
-    if (oldCtxHandle != 0)
+    event_monitor_t *m = (event_monitor_t *)calloc(1, sizeof(event_monitor_t));
+    if (m == NULL)
     {
-        java_hook_ctx_t *old_ctx = (java_hook_ctx_t *)(uintptr_t)oldCtxHandle;
-        (*env)->DeleteGlobalRef(env, old_ctx->hook_obj);
-        free(old_ctx);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate event monitor");
+        return 0;
     }
 
-    /* If hook is NULL, clear the hook */
-    if (hook == NULL)
+    m->db = (tidesdb_t *)(uintptr_t)handle;
+    m->interval_us = (uint64_t)intervalUs;
+    m->listener = (*env)->NewGlobalRef(env, listener);
+    if (m->listener == NULL)
     {
-        int result = tidesdb_cf_set_commit_hook(cf, NULL, NULL);
-        if (result != TDB_SUCCESS)
-        {
-            throwTidesDBException(env, result, getErrorMessage(result));
-        }
+        free(m);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to reference event listener");
         return 0;
     }
+    pthread_mutex_init(&m->lock, NULL);
+    pthread_cond_init(&m->wake, NULL);
 
-    /* Allocate new context */
-    java_hook_ctx_t *ctx = (java_hook_ctx_t *)malloc(sizeof(java_hook_ctx_t));
-    if (ctx == NULL)
+    if (pthread_create(&m->thread, NULL, event_monitor_thread, m) != 0)
     {
-        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate commit hook context");
+        pthread_cond_destroy(&m->wake);
+        pthread_mutex_destroy(&m->lock);
+        (*env)->DeleteGlobalRef(env, m->listener);
+        free(m);
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to start event monitor thread");
         return 0;
     }
 
-    (*env)->GetJavaVM(env, &ctx->jvm);
-    ctx->hook_obj = (*env)->NewGlobalRef(env, hook);
+    return (jlong)(uintptr_t)m;
+}
 
-    int result = tidesdb_cf_set_commit_hook(cf, java_commit_hook_trampoline, ctx);
-    if (result != TDB_SUCCESS)
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeStopEventMonitor(JNIEnv *env, jclass cls,
+                                                                       jlong monitorHandle)
+{
+    event_monitor_t *m = (event_monitor_t *)(uintptr_t)monitorHandle;
+    if (m == NULL)
     {
-        (*env)->DeleteGlobalRef(env, ctx->hook_obj);
-        free(ctx);
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return 0;
+        return;
     }
 
-    return (jlong)(uintptr_t)ctx;
+    pthread_mutex_lock(&m->lock);
+    m->stop = 1;
+    pthread_cond_signal(&m->wake);
+    pthread_mutex_unlock(&m->lock);
+    pthread_join(m->thread, NULL);
+
+    for (int i = 0; i < m->num_events; i++)
+    {
+        free(m->events[i].cf_name);
+    }
+    free(m->events);
+    for (int i = 0; i < m->num_cfs; i++)
+    {
+        free(m->cfs[i].name);
+    }
+    free(m->cfs);
+    pthread_cond_destroy(&m->wake);
+    pthread_mutex_destroy(&m->lock);
+    (*env)->DeleteGlobalRef(env, m->listener);
+    free(m);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativePurge(JNIEnv *env, jclass cls,
-                                                                  jlong handle)
+JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativePauseEventMonitor(JNIEnv *env, jclass cls,
+                                                                        jlong monitorHandle,
+                                                                        jboolean paused)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    int result = tidesdb_purge_cf(cf);
-
-    if (result != TDB_SUCCESS)
+    event_monitor_t *m = (event_monitor_t *)(uintptr_t)monitorHandle;
+    if (m == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        return;
     }
+
+    /* sampling holds the lock, so once it is taken no sample is in progress */
+    pthread_mutex_lock(&m->lock);
+    m->paused += paused ? 1 : -1;
+    pthread_cond_broadcast(&m->wake);
+    pthread_mutex_unlock(&m->lock);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_ColumnFamily_nativeSyncWal(JNIEnv *env, jclass cls,
-                                                                    jlong handle)
+/*
+ * Dictionary value codec. Values are compressed in the binding before they reach the engine,
+ * so SSTables, the vlog and the block cache all hold the compressed form. Encoded values
+ * start with a tag byte: VALUE_CODEC_RAW is followed by the value unchanged, VALUE_CODEC_ZSTD
+ * by the 4-byte big-endian dictionary id and a zstd frame written without its own dictionary
+ * id. Values that do not shrink are stored raw.
+ */
+#define VALUE_CODEC_RAW    0
+#define VALUE_CODEC_ZSTD   1
+#define VALUE_CODEC_HEADER 5
+
+/* Largest value the codec encodes, and so the largest content size a frame may claim */
+#define VALUE_CODEC_MAX_SIZE (256u << 20)
+
+typedef struct
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-    int result = tidesdb_sync_wal(cf);
+    ZSTD_CDict *cdict;
+    ZSTD_DDict *ddict;
+    uint32_t id;
+} value_dict_t;
 
-    if (result != TDB_SUCCESS)
-    {
-        throwTidesDBException(env, result, getErrorMessage(result));
-    }
+/**
+ * Per-thread compression contexts, created on first use and freed when the thread exits.
+ */
+typedef struct
+{
+    ZSTD_CCtx *cctx;
+    ZSTD_DCtx *dctx;
+} value_codec_ctx_t;
+
+static pthread_key_t g_codec_key;
+static pthread_once_t g_codec_key_once = PTHREAD_ONCE_INIT;
+static _Thread_local value_codec_ctx_t *t_codec_ctx = NULL;
+
+static void value_codec_ctx_release(void *p)
+{
+    value_codec_ctx_t *ctx = (value_codec_ctx_t *)p;
+    ZSTD_freeCCtx(ctx->cctx);
+    ZSTD_freeDCtx(ctx->dctx);
+    free(ctx);
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativePurge(JNIEnv *env, jclass cls, jlong handle)
+static void value_codec_key_init(void)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    int result = tidesdb_purge(db);
+    pthread_key_create(&g_codec_key, value_codec_ctx_release);
+}
 
-    if (result != TDB_SUCCESS)
+static value_codec_ctx_t *value_codec_ctx(void)
+{
+    value_codec_ctx_t *ctx = t_codec_ctx;
+    if (ctx != NULL)
+        return ctx;
+
+    pthread_once(&g_codec_key_once, value_codec_key_init);
+    ctx = (value_codec_ctx_t *)calloc(1, sizeof(value_codec_ctx_t));
+    if (ctx == NULL)
+        return NULL;
+    ctx->cctx = ZSTD_createCCtx();
+    ctx->dctx = ZSTD_createDCtx();
+    if (ctx->cctx == NULL || ctx->dctx == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        value_codec_ctx_release(ctx);
+        return NULL;
     }
+    pthread_setspecific(g_codec_key, ctx);
+    t_codec_ctx = ctx;
+    return ctx;
 }
 
-JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDB_nativeGetDbStats(JNIEnv *env, jclass cls,
-                                                                     jlong handle)
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_ValueCodec_nativeTrain(JNIEnv *env, jclass cls,
+                                                                     jobjectArray samples,
+                                                                     jint dictSize)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    tidesdb_db_stats_t db_stats;
-    memset(&db_stats, 0, sizeof(db_stats));
+    jsize count = (*env)->GetArrayLength(env, samples);
+    size_t *sizes = (size_t *)malloc((size_t)(count > 0 ? count : 1) * sizeof(size_t));
+    if (sizes == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
+    }
 
-    int result = tidesdb_get_db_stats(db, &db_stats);
-    if (result != TDB_SUCCESS)
+    size_t total = 0;
+    for (jsize i = 0; i < count; i++)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        jbyteArray s = (jbyteArray)(*env)->GetObjectArrayElement(env, samples, i);
+        sizes[i] = (size_t)(*env)->GetArrayLength(env, s);
+        total += sizes[i];
+        (*env)->DeleteLocalRef(env, s);
+    }
+
+    uint8_t *buf = (uint8_t *)malloc(total > 0 ? total : 1);
+    uint8_t *dict = (uint8_t *)malloc((size_t)dictSize);
+    if (buf == NULL || dict == NULL)
+    {
+        free(sizes);
+        free(buf);
+        free(dict);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
         return NULL;
     }
 
-    jclass dbStatsClass = (*env)->FindClass(env, "com/tidesdb/DbStats");
-    /* Constructor signature:
-       int, long, long, long, int, int, long, int, int, long, int, long, long, long, long,
-       boolean, long, int, boolean, int, long,
-       boolean, String, long, long, int, long, long, long, long, boolean */
-    jmethodID constructor = (*env)->GetMethodID(
-        env, dbStatsClass, "<init>",
-        "(IJJJIIJIIJIJJJJZJIZIJZLjava/lang/String;JJIJJJJZ)V");
+    size_t off = 0;
+    for (jsize i = 0; i < count; i++)
+    {
+        jbyteArray s = (jbyteArray)(*env)->GetObjectArrayElement(env, samples, i);
+        (*env)->GetByteArrayRegion(env, s, 0, (jsize)sizes[i], (jbyte *)buf + off);
+        (*env)->DeleteLocalRef(env, s);
+        off += sizes[i];
+    }
 
-    jstring connectorStr = NULL;
-    if (db_stats.object_store_connector != NULL)
+    size_t len = ZDICT_trainFromBuffer(dict, (size_t)dictSize, buf, sizes, (unsigned)count);
+    free(buf);
+    free(sizes);
+    if (ZDICT_isError(len))
     {
-        connectorStr = (*env)->NewStringUTF(env, db_stats.object_store_connector);
+        free(dict);
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, ZDICT_getErrorName(len));
+        return NULL;
     }
 
-    return (*env)->NewObject(env, dbStatsClass, constructor,
-                             (jint)db_stats.num_column_families,
-                             (jlong)db_stats.total_memory,
-                             (jlong)db_stats.available_memory,
-                             (jlong)db_stats.resolved_memory_limit,
-                             (jint)db_stats.memory_pressure_level,
-                             (jint)db_stats.flush_pending_count,
-                             (jlong)db_stats.total_memtable_bytes,
-                             (jint)db_stats.total_immutable_count,
-                             (jint)db_stats.total_sstable_count,
-                             (jlong)db_stats.total_data_size_bytes,
-                             (jint)db_stats.num_open_sstables,
-                             (jlong)db_stats.global_seq,
-                             (jlong)db_stats.txn_memory_bytes,
-                             (jlong)db_stats.compaction_queue_size,
-                             (jlong)db_stats.flush_queue_size,
-                             db_stats.unified_memtable_enabled != 0,
-                             (jlong)db_stats.unified_memtable_bytes,
-                             (jint)db_stats.unified_immutable_count,
-                             db_stats.unified_is_flushing != 0,
-                             (jint)db_stats.unified_next_cf_index,
-                             (jlong)db_stats.unified_wal_generation,
-                             db_stats.object_store_enabled != 0,
-                             connectorStr,
-                             (jlong)db_stats.local_cache_bytes_used,
-                             (jlong)db_stats.local_cache_bytes_max,
-                             (jint)db_stats.local_cache_num_files,
-                             (jlong)db_stats.last_uploaded_generation,
-                             (jlong)db_stats.upload_queue_depth,
-                             (jlong)db_stats.total_uploads,
-                             (jlong)db_stats.total_upload_failures,
-                             db_stats.replica_mode != 0);
+    jbyteArray result = (*env)->NewByteArray(env, (jsize)len);
+    if (result != NULL)
+        (*env)->SetByteArrayRegion(env, result, 0, (jsize)len, (jbyte *)dict);
+    free(dict);
+    return result;
 }
 
-JNIEXPORT jdouble JNICALL Java_com_tidesdb_ColumnFamily_nativeRangeCost(JNIEnv *env, jclass cls,
-                                                                         jlong handle,
-                                                                         jbyteArray keyA,
-                                                                         jbyteArray keyB)
+JNIEXPORT jlong JNICALL Java_com_tidesdb_ValueCodec_nativeCreate(JNIEnv *env, jclass cls,
+                                                                 jbyteArray dictionary,
+                                                                 jint level)
 {
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)handle;
-
-    jsize keyALen = (*env)->GetArrayLength(env, keyA);
-    jsize keyBLen = (*env)->GetArrayLength(env, keyB);
-
-    jbyte *keyABytes = (*env)->GetByteArrayElements(env, keyA, NULL);
-    jbyte *keyBBytes = (*env)->GetByteArrayElements(env, keyB, NULL);
-
-    double cost = 0.0;
-    int result = tidesdb_range_cost(cf, (uint8_t *)keyABytes, keyALen, (uint8_t *)keyBBytes,
-                                    keyBLen, &cost);
-
-    (*env)->ReleaseByteArrayElements(env, keyA, keyABytes, JNI_ABORT);
-    (*env)->ReleaseByteArrayElements(env, keyB, keyBBytes, JNI_ABORT);
+    jsize len = (*env)->GetArrayLength(env, dictionary);
+    jbyte *bytes = (*env)->GetByteArrayElements(env, dictionary, NULL);
+    if (bytes == NULL)
+        return 0;
 
-    if (result != TDB_SUCCESS)
+    uint32_t id = ZDICT_getDictID(bytes, (size_t)len);
+    value_dict_t *d = id != 0 ? (value_dict_t *)calloc(1, sizeof(value_dict_t)) : NULL;
+    if (d != NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
-        return 0.0;
+        d->id = id;
+        d->cdict = ZSTD_createCDict(bytes, (size_t)len, level);
+        d->ddict = ZSTD_createDDict(bytes, (size_t)len);
     }
+    (*env)->ReleaseByteArrayElements(env, dictionary, bytes, JNI_ABORT);
 
-    return (jdouble)cost;
+    if (id == 0)
+    {
+        throwTidesDBException(env, TDB_ERR_INVALID_ARGS, "Not a trained zstd dictionary");
+        return 0;
+    }
+    if (d == NULL || d->cdict == NULL || d->ddict == NULL)
+    {
+        if (d != NULL)
+        {
+            ZSTD_freeCDict(d->cdict);
+            ZSTD_freeDDict(d->ddict);
+            free(d);
+        }
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to load zstd dictionary");
+        return 0;
+    }
+    return (jlong)(uintptr_t)d;
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativeDeleteColumnFamily(JNIEnv *env, jclass cls,
-                                                                          jlong handle,
-                                                                          jlong cfHandle)
+JNIEXPORT jint JNICALL Java_com_tidesdb_ValueCodec_nativeDictId(JNIEnv *env, jclass cls,
+                                                                jlong handle)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
-    tidesdb_column_family_t *cf = (tidesdb_column_family_t *)(uintptr_t)cfHandle;
-
-    int result = tidesdb_delete_column_family(db, cf);
+    return (jint)((value_dict_t *)(uintptr_t)handle)->id;
+}
 
-    if (result != TDB_SUCCESS)
+JNIEXPORT void JNICALL Java_com_tidesdb_ValueCodec_nativeFree(JNIEnv *env, jclass cls,
+                                                              jlong handle)
+{
+    value_dict_t *d = (value_dict_t *)(uintptr_t)handle;
+    if (d != NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        ZSTD_freeCDict(d->cdict);
+        ZSTD_freeDDict(d->ddict);
+        free(d);
     }
 }
 
-JNIEXPORT void JNICALL Java_com_tidesdb_TidesDB_nativePromoteToPrimary(JNIEnv *env, jclass cls,
-                                                                        jlong handle)
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_ValueCodec_nativeEncode(JNIEnv *env, jclass cls,
+                                                                      jlong handle,
+                                                                      jbyteArray value)
 {
-    tidesdb_t *db = (tidesdb_t *)(uintptr_t)handle;
+    value_dict_t *d = (value_dict_t *)(uintptr_t)handle;
+    value_codec_ctx_t *ctx = value_codec_ctx();
+    if (ctx == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate zstd context");
+        return NULL;
+    }
 
-    int result = tidesdb_promote_to_primary(db);
+    jsize len = (*env)->GetArrayLength(env, value);
+    if ((size_t)len > VALUE_CODEC_MAX_SIZE)
+    {
+        throwTidesDBException(env, TDB_ERR_TOO_LARGE, "Value is too large for the value codec");
+        return NULL;
+    }
+    size_t cap = VALUE_CODEC_HEADER + ZSTD_compressBound((size_t)len);
+    uint8_t *out = (uint8_t *)malloc(cap);
+    if (out == NULL)
+    {
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
+    }
 
-    if (result != TDB_SUCCESS)
+    jbyte *src = (*env)->GetByteArrayElements(env, value, NULL);
+    if (src == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        free(out);
+        return NULL;
     }
-}
 
-JNIEXPORT jint JNICALL Java_com_tidesdb_Config_nativeDefaultMaxConcurrentFlushes(JNIEnv *env,
-                                                                                  jclass cls)
-{
-    tidesdb_config_t cfg = tidesdb_default_config();
-    return (jint)cfg.max_concurrent_flushes;
-}
+    ZSTD_CCtx_reset(ctx->cctx, ZSTD_reset_session_and_parameters);
+    ZSTD_CCtx_setParameter(ctx->cctx, ZSTD_c_contentSizeFlag, 1);
+    ZSTD_CCtx_setParameter(ctx->cctx, ZSTD_c_dictIDFlag, 0);
+    ZSTD_CCtx_refCDict(ctx->cctx, d->cdict);
+    size_t n = ZSTD_compress2(ctx->cctx, out + VALUE_CODEC_HEADER, cap - VALUE_CODEC_HEADER, src,
+                              (size_t)len);
 
-JNIEXPORT jdouble JNICALL Java_com_tidesdb_ColumnFamilyConfig_nativeDefaultTombstoneDensityTrigger(
-    JNIEnv *env, jclass cls)
-{
-    tidesdb_column_family_config_t cfg = tidesdb_default_column_family_config();
-    return (jdouble)cfg.tombstone_density_trigger;
-}
+    size_t outLen;
+    if (!ZSTD_isError(n) && VALUE_CODEC_HEADER + n < 1 + (size_t)len)
+    {
+        out[0] = VALUE_CODEC_ZSTD;
+        write_be32(out + 1, d->id);
+        outLen = VALUE_CODEC_HEADER + n;
+    }
+    else
+    {
+        out[0] = VALUE_CODEC_RAW;
+        memcpy(out + 1, src, (size_t)len);
+        outLen = 1 + (size_t)len;
+    }
+    (*env)->ReleaseByteArrayElements(env, value, src, JNI_ABORT);
 
-JNIEXPORT jlong JNICALL Java_com_tidesdb_ColumnFamilyConfig_nativeDefaultTombstoneDensityMinEntries(
-    JNIEnv *env, jclass cls)
-{
-    tidesdb_column_family_config_t cfg = tidesdb_default_column_family_config();
-    return (jlong)cfg.tombstone_density_min_entries;
+    jbyteArray result = (*env)->NewByteArray(env, (jsize)outLen);
+    if (result != NULL)
+        (*env)->SetByteArrayRegion(env, result, 0, (jsize)outLen, (jbyte *)out);
+    free(out);
+    return result;
 }
 
-JNIEXPORT jobject JNICALL Java_com_tidesdb_TidesDBIterator_nativeKeyValue(JNIEnv *env, jclass cls,
-                                                                           jlong handle)
+/**
+ * Decodes a VALUE_CODEC_ZSTD value with the dictionary its header names; Java resolves the
+ * id to the handle.
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_tidesdb_ValueCodec_nativeDecode(JNIEnv *env, jclass cls,
+                                                                      jlong handle,
+                                                                      jbyteArray stored)
 {
-    tidesdb_iter_t *iter = (tidesdb_iter_t *)(uintptr_t)handle;
-    uint8_t *key = NULL;
-    size_t keyLen = 0;
-    uint8_t *value = NULL;
-    size_t valueLen = 0;
-
-    int result = tidesdb_iter_key_value(iter, &key, &keyLen, &value, &valueLen);
-    if (result != TDB_SUCCESS)
+    value_dict_t *d = (value_dict_t *)(uintptr_t)handle;
+    value_codec_ctx_t *ctx = value_codec_ctx();
+    if (ctx == NULL)
     {
-        throwTidesDBException(env, result, getErrorMessage(result));
+        throwTidesDBException(env, TDB_ERR_MEMORY, "Failed to allocate zstd context");
         return NULL;
     }
 
-    jbyteArray jkey = (*env)->NewByteArray(env, keyLen);
-    (*env)->SetByteArrayRegion(env, jkey, 0, keyLen, (jbyte *)key);
+    jsize len = (*env)->GetArrayLength(env, stored);
+    jbyte *src = (*env)->GetByteArrayElements(env, stored, NULL);
+    if (src == NULL)
+        return NULL;
 
-    jbyteArray jvalue = (*env)->NewByteArray(env, valueLen);
-    (*env)->SetByteArrayRegion(env, jvalue, 0, valueLen, (jbyte *)value);
+    const uint8_t *frame = (const uint8_t *)src + VALUE_CODEC_HEADER;
+    size_t frameLen = (size_t)len - VALUE_CODEC_HEADER;
+    unsigned long long size = ZSTD_getFrameContentSize(frame, frameLen);
+    if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN ||
+        size > VALUE_CODEC_MAX_SIZE)
+    {
+        (*env)->ReleaseByteArrayElements(env, stored, src, JNI_ABORT);
+        throwTidesDBException(env, TDB_ERR_CORRUPTION, "Malformed compressed value");
+        return NULL;
+    }
+
+    uint8_t *out = (uint8_t *)malloc(size > 0 ? (size_t)size : 1);
+    if (out == NULL)
+    {
+        (*env)->ReleaseByteArrayElements(env, stored, src, JNI_ABORT);
+        throwTidesDBException(env, TDB_ERR_MEMORY, getErrorMessage(TDB_ERR_MEMORY));
+        return NULL;
+    }
+    size_t n = ZSTD_decompress_usingDDict(ctx->dctx, out, (size_t)size, frame, frameLen,
+                                          d->ddict);
+    (*env)->ReleaseByteArrayElements(env, stored, src, JNI_ABORT);
 
-    jclass kvClass = (*env)->FindClass(env, "com/tidesdb/KeyValue");
-    jmethodID ctor = (*env)->GetMethodID(env, kvClass, "<init>", "([B[B)V");
+    if (ZSTD_isError(n) || n != (size_t)size)
+    {
+        free(out);
+        throwTidesDBException(env, TDB_ERR_CORRUPTION, "Malformed compressed value");
+        return NULL;
+    }
 
-    return (*env)->NewObject(env, kvClass, ctor, jkey, jvalue);
+    jbyteArray result = (*env)->NewByteArray(env, (jsize)n);
+    if (result != NULL)
+        (*env)->SetByteArrayRegion(env, result, 0, (jsize)n, (jbyte *)out);
+    free(out);
+    return result;
 }
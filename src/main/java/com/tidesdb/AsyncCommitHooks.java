@@ -0,0 +1,35 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Entry point the native hook consumer thread calls for asynchronous commit hooks.
+ */
+final class AsyncCommitHooks {
+    
+    private AsyncCommitHooks() {
+    }
+    
+    static void deliver(CommitHook hook, ByteBuffer batch, int length, int commits) {
+        batch.clear().limit(length);
+        hook.onCommitBatch(batch, commits);
+    }
+}
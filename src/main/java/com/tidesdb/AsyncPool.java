@@ -0,0 +1,148 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.locks.ReentrantReadWriteLock;
+
+/**
+ * Bounded pool of native worker threads that runs blocking engine calls off the caller's
+ * thread and completes a {@link CompletableFuture} with the result. Each {@link TidesDB}
+ * creates one lazily on first asynchronous use and shuts it down on close.
+ *
+ * <p>Futures are completed on a pool thread, so non-async dependent stages also run there.
+ * Use the {@code *Async} stage methods with an executor for continuation work that blocks.
+ * Submissions made while the queue is full fail with {@link RejectedExecutionException}.</p>
+ */
+final class AsyncPool {
+
+    static {
+        NativeLibrary.load();
+    }
+
+    private final ReentrantReadWriteLock lifecycle = new ReentrantReadWriteLock();
+    private long nativeHandle;
+    /** Set once shutdown begins, so submissions fail instead of queueing behind the join. */
+    private volatile boolean shuttingDown = false;
+
+    AsyncPool(int numThreads, int queueCapacity) throws TidesDBException {
+        this.nativeHandle = nativeCreate(numThreads, queueCapacity);
+    }
+
+    CompletableFuture<byte[]> get(long txnHandle, long cfHandle, byte[] key, int latencySlot) {
+        CompletableFuture<byte[]> future = new CompletableFuture<>();
+        lifecycle.readLock().lock();
+        try {
+            checkRunning();
+            reject(future, nativeSubmitGet(nativeHandle, txnHandle, cfHandle, key, latencySlot, future));
+        } catch (TidesDBException | IllegalStateException e) {
+            future.completeExceptionally(e);
+        } finally {
+            lifecycle.readLock().unlock();
+        }
+        return future;
+    }
+
+    CompletableFuture<Void> commit(long txnHandle) {
+        CompletableFuture<Void> future = new CompletableFuture<>();
+        lifecycle.readLock().lock();
+        try {
+            checkRunning();
+            reject(future, nativeSubmitCommit(nativeHandle, txnHandle, future));
+        } catch (TidesDBException | IllegalStateException e) {
+            future.completeExceptionally(e);
+        } finally {
+            lifecycle.readLock().unlock();
+        }
+        return future;
+    }
+
+    CompletableFuture<byte[][]> multiGet(long txnHandle, long cfHandle, byte[][] keys, int latencySlot) {
+        CompletableFuture<byte[][]> future = new CompletableFuture<>();
+        lifecycle.readLock().lock();
+        try {
+            checkRunning();
+            reject(future, nativeSubmitMultiGet(nativeHandle, txnHandle, cfHandle, keys, latencySlot,
+                future));
+        } catch (TidesDBException | IllegalStateException e) {
+            future.completeExceptionally(e);
+        } finally {
+            lifecycle.readLock().unlock();
+        }
+        return future;
+    }
+
+    CompletableFuture<Void> backup(long dbHandle, String dir) {
+        CompletableFuture<Void> future = new CompletableFuture<>();
+        lifecycle.readLock().lock();
+        try {
+            checkRunning();
+            reject(future, nativeSubmitBackup(nativeHandle, dbHandle, dir, future));
+        } catch (TidesDBException | IllegalStateException e) {
+            future.completeExceptionally(e);
+        } finally {
+            lifecycle.readLock().unlock();
+        }
+        return future;
+    }
+
+    /**
+     * Stops accepting work, waits for every queued operation to finish and joins the
+     * worker threads. The lock only covers taking the handle: the join runs outside it, so a
+     * continuation on a worker that submits more work fails instead of blocking the join.
+     */
+    void shutdown() {
+        long handle;
+        shuttingDown = true;
+        lifecycle.writeLock().lock();
+        try {
+            handle = nativeHandle;
+            nativeHandle = 0;
+        } finally {
+            lifecycle.writeLock().unlock();
+        }
+        if (handle != 0) {
+            nativeDestroy(handle);
+        }
+    }
+
+    private void checkRunning() {
+        if (shuttingDown || nativeHandle == 0) {
+            throw new IllegalStateException("Async pool has been shut down");
+        }
+    }
+
+    private static void reject(CompletableFuture<?> future, boolean accepted) {
+        if (!accepted) {
+            future.completeExceptionally(new RejectedExecutionException("Async queue is full"));
+        }
+    }
+
+    private static native long nativeCreate(int numThreads, int queueCapacity) throws TidesDBException;
+    private static native void nativeDestroy(long handle);
+    private static native boolean nativeSubmitGet(long handle, long txnHandle, long cfHandle, byte[] key,
+                                                  int latencySlot, CompletableFuture<byte[]> future) throws TidesDBException;
+    private static native boolean nativeSubmitCommit(long handle, long txnHandle,
+                                                     CompletableFuture<Void> future) throws TidesDBException;
+    private static native boolean nativeSubmitMultiGet(long handle, long txnHandle, long cfHandle, byte[][] keys,
+                                                       int latencySlot, CompletableFuture<byte[][]> future) throws TidesDBException;
+    private static native boolean nativeSubmitBackup(long handle, long dbHandle, String dir,
+                                                     CompletableFuture<Void> future) throws TidesDBException;
+}
@@ -0,0 +1,136 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Options for {@link TidesDB#backup(String, BackupOptions)}.
+ *
+ * <p>With {@link Builder#since(String) since} set, the backup is incremental: SSTables are
+ * immutable, so a file whose relative path, size and modification time match the previous
+ * backup's manifest is hard-linked from it (copied if the previous backup is on another
+ * filesystem) instead of copied from the database.
+ */
+public class BackupOptions {
+    
+    /**
+     * Receives progress as files are linked or copied. Calls are serialized but come from
+     * the copy threads, so the listener must not block for long.
+     */
+    @FunctionalInterface
+    public interface ProgressListener {
+        /**
+         * Called after each file.
+         *
+         * @param bytesDone bytes linked or copied so far
+         * @param bytesTotal bytes in the backup
+         * @param filesDone files linked or copied so far
+         * @param filesTotal files in the backup
+         */
+        void onProgress(long bytesDone, long bytesTotal, int filesDone, int filesTotal);
+    }
+    
+    private String since;
+    private int parallelism;
+    private long bytesPerSecond;
+    private ProgressListener progressListener;
+    
+    private BackupOptions(Builder builder) {
+        this.since = builder.since;
+        this.parallelism = builder.parallelism;
+        this.bytesPerSecond = builder.bytesPerSecond;
+        this.progressListener = builder.progressListener;
+    }
+    
+    /**
+     * Creates a new builder for BackupOptions.
+     *
+     * @return a new Builder
+     */
+    public static Builder builder() {
+        return new Builder();
+    }
+    
+    /**
+     * Gets default options: a full backup copied on 4 threads without a bandwidth cap.
+     *
+     * @return default options
+     */
+    public static BackupOptions defaultOptions() {
+        return new Builder().build();
+    }
+    
+    public String getSince() { return since; }
+    public int getParallelism() { return parallelism; }
+    public long getBytesPerSecond() { return bytesPerSecond; }
+    public ProgressListener getProgressListener() { return progressListener; }
+    
+    /**
+     * Builder for BackupOptions.
+     */
+    public static class Builder {
+        private String since;
+        private int parallelism = 4;
+        private long bytesPerSecond = 0;
+        private ProgressListener progressListener;
+        
+        private Builder() {
+        }
+        
+        /**
+         * Makes the backup incremental on top of a previous backup directory written by
+         * {@link TidesDB#backup(String, BackupOptions)}.
+         */
+        public Builder since(String previousDir) {
+            this.since = previousDir;
+            return this;
+        }
+        
+        public Builder parallelism(int parallelism) {
+            this.parallelism = parallelism;
+            return this;
+        }
+        
+        /**
+         * Caps the bytes copied per second across all threads; 0 (the default) means
+         * unlimited. Hard links are not counted.
+         */
+        public Builder bytesPerSecond(long bytesPerSecond) {
+            this.bytesPerSecond = bytesPerSecond;
+            return this;
+        }
+        
+        public Builder progressListener(ProgressListener progressListener) {
+            this.progressListener = progressListener;
+            return this;
+        }
+        
+        public BackupOptions build() {
+            if (parallelism <= 0) {
+                throw new IllegalArgumentException("Parallelism must be positive");
+            }
+            if (bytesPerSecond < 0) {
+                throw new IllegalArgumentException("Bytes per second cannot be negative");
+            }
+            if (since != null && since.isEmpty()) {
+                throw new IllegalArgumentException("Previous backup directory cannot be empty");
+            }
+            return new BackupOptions(this);
+        }
+    }
+}
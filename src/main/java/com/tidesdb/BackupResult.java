@@ -0,0 +1,52 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Summary of a completed {@link TidesDB#backup(String, BackupOptions)}.
+ */
+public final class BackupResult {
+    
+    private final int filesCopied;
+    private final int filesLinked;
+    private final long bytesCopied;
+    private final long bytesLinked;
+    
+    BackupResult(int filesCopied, int filesLinked, long bytesCopied, long bytesLinked) {
+        this.filesCopied = filesCopied;
+        this.filesLinked = filesLinked;
+        this.bytesCopied = bytesCopied;
+        this.bytesLinked = bytesLinked;
+    }
+    
+    public int getFilesCopied() { return filesCopied; }
+    public int getFilesLinked() { return filesLinked; }
+    public long getBytesCopied() { return bytesCopied; }
+    public long getBytesLinked() { return bytesLinked; }
+    
+    @Override
+    public String toString() {
+        return "BackupResult{" +
+            "filesCopied=" + filesCopied +
+            ", filesLinked=" + filesLinked +
+            ", bytesCopied=" + bytesCopied +
+            ", bytesLinked=" + bytesLinked +
+            '}';
+    }
+}
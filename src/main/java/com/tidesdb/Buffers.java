@@ -0,0 +1,59 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Argument checks shared by the direct {@link ByteBuffer} overloads.
+ */
+final class Buffers {
+
+    private Buffers() {
+    }
+
+    /**
+     * Verifies that a buffer passed as a key is direct and has at least one remaining byte.
+     *
+     * @param key the key buffer
+     */
+    static void checkDirectKey(ByteBuffer key) {
+        if (key == null || !key.hasRemaining()) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (!key.isDirect()) {
+            throw new IllegalArgumentException("Key buffer must be a direct ByteBuffer");
+        }
+    }
+
+    /**
+     * Verifies that a buffer is non-null and direct. Remaining bytes may be zero.
+     *
+     * @param buf the buffer
+     * @param what name used in the exception message
+     */
+    static void checkDirect(ByteBuffer buf, String what) {
+        if (buf == null) {
+            throw new IllegalArgumentException(what + " cannot be null");
+        }
+        if (!buf.isDirect()) {
+            throw new IllegalArgumentException(what + " buffer must be a direct ByteBuffer");
+        }
+    }
+}
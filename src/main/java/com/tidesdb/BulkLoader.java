@@ -0,0 +1,268 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+
+/**
+ * Writes a stream of key/value pairs sorted in ascending key order into a column family
+ * through ordinary transactions, batching them to cut per-key overhead. Pairs are packed
+ * into a {@link WriteBatch} and committed one chunk at a time in a single native call, so
+ * a load costs one JNI crossing and one commit per chunk rather than per key.
+ *
+ * <p>This is not SSTable ingestion: every pair still goes through the WAL and the memtable
+ * and is flushed and compacted like any other write, so a load costs roughly what the same
+ * writes cost in large transactions. Sorted input only helps in that memtable flushes
+ * written while nothing else writes to the column family cover ranges that do not overlap
+ * each other.</p>
+ *
+ * <p>A load is not atomic: each chunk becomes visible when it commits. {@link #finish()}
+ * commits the last chunk and flushes the memtable; closing a loader without finishing
+ * discards the chunk that has not been committed yet.
+ *
+ * <p>Files and packed buffers hold records as {@code [int32 keyLen][key][int32 valueLen][value]}
+ * (big-endian), the same layout {@link TidesDBIterator#nextBatch} produces.
+ */
+public final class BulkLoader implements AutoCloseable {
+    
+    static final int DEFAULT_CHUNK_BYTES = 4 * 1024 * 1024;
+    
+    private static final int READ_BUFFER_BYTES = 1024 * 1024;
+    
+    private final TidesDB db;
+    private final ColumnFamily cf;
+    private final int chunkBytes;
+    private final boolean checkOrder;
+    private final WriteBatch batch;
+    private byte[] lastKey = new byte[64];
+    private int lastKeyLength = -1;
+    private long count = 0;
+    private boolean closed = false;
+    
+    BulkLoader(TidesDB db, ColumnFamily cf, int chunkBytes) throws TidesDBException {
+        this.db = db;
+        this.cf = cf;
+        this.chunkBytes = chunkBytes;
+        this.batch = new WriteBatch(chunkBytes + chunkBytes / 4);
+        
+        // only bytewise order can be checked here, other comparators are trusted
+        this.checkOrder = cf.isBytewise();
+    }
+    
+    /**
+     * Adds a key/value pair. Keys must be strictly ascending across all calls.
+     *
+     * @param key the key
+     * @param value the value
+     * @throws TidesDBException if committing a full chunk fails
+     */
+    public void add(byte[] key, byte[] value) throws TidesDBException {
+        if (key == null || key.length == 0) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        add(ByteBuffer.wrap(key), ByteBuffer.wrap(value));
+    }
+    
+    /**
+     * Adds a key/value pair from the remaining bytes of each buffer. Keys must be strictly
+     * ascending across all calls. Buffer positions and limits are not modified.
+     *
+     * @param key the key
+     * @param value the value
+     * @throws TidesDBException if committing a full chunk fails
+     */
+    public void add(ByteBuffer key, ByteBuffer value) throws TidesDBException {
+        checkNotClosed();
+        if (key == null || !key.hasRemaining()) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        if (checkOrder) {
+            rememberKey(key);
+        }
+        batch.put(cf, key, value, -1);
+        count++;
+        if (batch.sizeInBytes() >= chunkBytes) {
+            commitChunk();
+        }
+    }
+    
+    /**
+     * Adds every record packed between the buffer's position and limit. The buffer's
+     * position and limit are not modified.
+     *
+     * @param records packed records
+     * @throws TidesDBException if committing a full chunk fails
+     */
+    public void addPacked(ByteBuffer records) throws TidesDBException {
+        if (records == null) {
+            throw new IllegalArgumentException("Records cannot be null");
+        }
+        ByteBuffer in = records.duplicate();
+        addRecords(in);
+        if (in.hasRemaining()) {
+            throw new IllegalArgumentException("Truncated record at offset " + in.position());
+        }
+    }
+    
+    /**
+     * Adds every record of a file of packed records, reading it sequentially.
+     *
+     * @param path the file
+     * @throws IOException if the file cannot be read
+     * @throws TidesDBException if committing a chunk fails
+     */
+    public void addFile(Path path) throws IOException, TidesDBException {
+        if (path == null) {
+            throw new IllegalArgumentException("Path cannot be null");
+        }
+        checkNotClosed();
+        try (FileChannel channel = FileChannel.open(path, StandardOpenOption.READ)) {
+            ByteBuffer buf = ByteBuffer.allocateDirect(READ_BUFFER_BYTES);
+            boolean eof = false;
+            while (!eof) {
+                eof = channel.read(buf) < 0;
+                buf.flip();
+                addRecords(buf);
+                if (eof) {
+                    if (buf.hasRemaining()) {
+                        throw new IllegalArgumentException("Truncated record at end of " + path);
+                    }
+                } else if (buf.position() == 0 && buf.limit() == buf.capacity()) {
+                    // a single record is larger than the read buffer
+                    ByteBuffer larger = ByteBuffer.allocateDirect(buf.capacity() * 2);
+                    larger.put(buf);
+                    buf = larger;
+                } else {
+                    buf.compact();
+                }
+            }
+        }
+    }
+    
+    /**
+     * Commits the pending chunk and flushes the memtable.
+     *
+     * @return the number of pairs loaded
+     * @throws TidesDBException if the commit or flush fails
+     */
+    public long finish() throws TidesDBException {
+        checkNotClosed();
+        commitChunk();
+        cf.flushMemtable();
+        closed = true;
+        return count;
+    }
+    
+    /**
+     * Gets the number of pairs added so far, committed or not.
+     *
+     * @return the pair count
+     */
+    public long count() {
+        return count;
+    }
+    
+    /**
+     * Closes the loader. Pairs added since the last committed chunk are discarded unless
+     * {@link #finish()} was called.
+     */
+    @Override
+    public void close() {
+        closed = true;
+        batch.clear();
+    }
+    
+    /** Consumes complete records, leaving the position at the first incomplete one. */
+    private void addRecords(ByteBuffer in) throws TidesDBException {
+        while (in.remaining() >= 4) {
+            int pos = in.position();
+            int keyLen = in.getInt(pos);
+            if (keyLen <= 0) {
+                throw new IllegalArgumentException("Invalid key length at offset " + pos);
+            }
+            if (in.remaining() < 8 + keyLen) {
+                return;
+            }
+            int valueLen = in.getInt(pos + 4 + keyLen);
+            if (valueLen < 0) {
+                throw new IllegalArgumentException("Invalid value length at offset " + pos);
+            }
+            if (in.remaining() < 8 + keyLen + valueLen) {
+                return;
+            }
+            ByteBuffer key = in.duplicate();
+            key.position(pos + 4).limit(pos + 4 + keyLen);
+            ByteBuffer value = in.duplicate();
+            value.position(pos + 8 + keyLen).limit(pos + 8 + keyLen + valueLen);
+            add(key, value);
+            in.position(pos + 8 + keyLen + valueLen);
+        }
+    }
+    
+    private void rememberKey(ByteBuffer key) {
+        int len = key.remaining();
+        if (lastKeyLength >= 0 && compare(key, lastKey, lastKeyLength) <= 0) {
+            throw new IllegalArgumentException("Keys must be added in strictly ascending order");
+        }
+        if (lastKey.length < len) {
+            lastKey = new byte[Math.max(len, lastKey.length * 2)];
+        }
+        key.duplicate().get(lastKey, 0, len);
+        lastKeyLength = len;
+    }
+    
+    private static int compare(ByteBuffer key, byte[] other, int otherLength) {
+        int len = key.remaining();
+        int pos = key.position();
+        int n = Math.min(len, otherLength);
+        for (int i = 0; i < n; i++) {
+            int cmp = (key.get(pos + i) & 0xff) - (other[i] & 0xff);
+            if (cmp != 0) {
+                return cmp;
+            }
+        }
+        return len - otherLength;
+    }
+    
+    private void commitChunk() throws TidesDBException {
+        if (batch.count() == 0) {
+            return;
+        }
+        try (Transaction txn = db.beginTransaction()) {
+            txn.writeAndCommit(batch);
+        }
+        batch.clear();
+    }
+    
+    private void checkNotClosed() {
+        if (closed) {
+            throw new IllegalStateException("Bulk loader has been closed");
+        }
+    }
+}
@@ -19,7 +19,10 @@
 package com.tidesdb;
 
 /**
- * Statistics about the block cache.
+ * Statistics about the block cache. The cache is shared by every column family and sized
+ * once at open ({@link Config.Builder#blockCacheSize}); hit and miss counters are
+ * cumulative across all of them. Use {@link #since(CacheStats)} to see how the hit rate
+ * behaves over an interval, e.g. while a scan-heavy job runs.
  */
 public class CacheStats {
     
@@ -104,6 +107,25 @@ public class CacheStats {
         return numPartitions;
     }
     
+    /**
+     * Returns the hits, misses and hit rate accumulated since {@code baseline} was taken.
+     * Entry, byte and partition counts are this snapshot's.
+     *
+     * @param baseline an earlier snapshot of the same cache
+     * @return the statistics for the interval
+     */
+    public CacheStats since(CacheStats baseline) {
+        if (baseline == null) {
+            throw new IllegalArgumentException("Baseline cannot be null");
+        }
+        long intervalHits = Math.max(0, hits - baseline.hits);
+        long intervalMisses = Math.max(0, misses - baseline.misses);
+        long lookups = intervalHits + intervalMisses;
+        double intervalHitRate = lookups == 0 ? 0.0 : (double) intervalHits / lookups;
+        return new CacheStats(enabled, totalEntries, totalBytes, intervalHits, intervalMisses,
+            intervalHitRate, numPartitions);
+    }
+    
     @Override
     public String toString() {
         return "CacheStats{" +
@@ -18,6 +18,14 @@
  */
 package com.tidesdb;
 
+import java.math.BigInteger;
+import java.nio.LongBuffer;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
 /**
  * Represents a column family in TidesDB.
  * Column families are isolated key-value stores with independent configuration.
@@ -29,12 +37,25 @@ public class ColumnFamily {
     }
     
     private final long nativeHandle;
-    private final String name;
+    private volatile String name;
     private long commitHookCtxHandle = 0;
+    private boolean userCommitHook = false;
+    private long expiryIndexHandle = 0;
+    private boolean expiryTracking = false;
+    private double expiredDensityTrigger;
+    private long expiredDensityMinEntries;
+    private long expirySweeps = 0;
+    private final String dbPath;
+    private ValueCodec valueCodec;
+    private boolean valueCodecLoaded = false;
+    private volatile String comparatorName;
+    private boolean sweepsPaused = false;
+    private boolean sweeping = false;
     
-    ColumnFamily(long nativeHandle, String name) {
+    ColumnFamily(long nativeHandle, String name, String dbPath) {
         this.nativeHandle = nativeHandle;
         this.name = name;
+        this.dbPath = dbPath;
     }
     
     /**
@@ -46,6 +67,10 @@ public class ColumnFamily {
         return name;
     }
     
+    void setName(String name) {
+        this.name = name;
+    }
+    
     /**
      * Retrieves statistics about this column family.
      *
@@ -53,7 +78,31 @@ public class ColumnFamily {
      * @throws TidesDBException if the stats cannot be retrieved
      */
     public Stats getStats() throws TidesDBException {
-        return nativeGetStats(nativeHandle);
+        Stats stats = nativeGetStats(nativeHandle);
+        synchronized (this) {
+            if (expiryIndexHandle != 0) {
+                long[] counts = new long[3];
+                nativeExpiryIndexPeek(expiryIndexHandle, System.currentTimeMillis() / 1000, counts);
+                stats.setExpiry(counts[0], counts[1], counts[2], expirySweeps);
+            }
+            if (valueCodec != null) {
+                stats.setValueCodec(valueCodec.getBytesIn(), valueCodec.getBytesOut());
+            }
+        }
+        return stats;
+    }
+    
+    /**
+     * Writes the {@code Metrics.CF_*} slots into {@code out} starting at its position,
+     * without allocating. Cheaper than {@link #getStats()} for periodic scraping.
+     *
+     * @param out a buffer from {@link Metrics#allocate(int)} with at least
+     *            {@link Metrics#CF_SLOTS} remaining slots
+     * @throws TidesDBException if the stats cannot be retrieved
+     */
+    public void fillMetrics(LongBuffer out) throws TidesDBException {
+        Metrics.check(out, Metrics.CF_SLOTS);
+        nativeFillMetrics(nativeHandle, out, out.position());
     }
     
     /**
@@ -186,6 +235,95 @@ public class ColumnFamily {
         return nativeRangeCost(nativeHandle, keyA, keyB);
     }
     
+    /**
+     * Splits [start, end) into up to {@code n} sub-ranges of roughly equal
+     * {@link #rangeCost}. Each split key is found by bisecting the key space between the
+     * previous split and end, treating keys as unsigned big-endian numbers, so only
+     * bytewise-ordered column families can be split. When the range has no measurable cost
+     * it is split evenly by key space instead.
+     *
+     * @param start inclusive start of the range
+     * @param end exclusive end of the range, must sort after start
+     * @param n the number of sub-ranges wanted
+     * @return ascending boundaries starting with start and ending with end; sub-range i is
+     *         [boundaries[i], boundaries[i + 1]). Empty sub-ranges are merged away, so
+     *         fewer than n may be returned
+     * @throws TidesDBException if a cost estimate fails
+     */
+    public List<byte[]> splitRange(byte[] start, byte[] end, int n) throws TidesDBException {
+        if (start == null || start.length == 0) {
+            throw new IllegalArgumentException("Start cannot be null or empty");
+        }
+        if (end == null || end.length == 0) {
+            throw new IllegalArgumentException("End cannot be null or empty");
+        }
+        if (n <= 0) {
+            throw new IllegalArgumentException("Number of ranges must be positive");
+        }
+        if (!isBytewise()) {
+            throw new IllegalArgumentException("Cannot split ranges of column family " + name
+                + " ordered by comparator " + comparatorName());
+        }
+        
+        // one extra byte of precision lets a split fall between adjacent keys
+        int width = Math.max(start.length, end.length) + 1;
+        BigInteger lo = toBigInteger(start, width);
+        BigInteger hi = toBigInteger(end, width);
+        if (lo.compareTo(hi) >= 0) {
+            throw new IllegalArgumentException("End must sort after start");
+        }
+        
+        double total = rangeCost(start, end);
+        List<byte[]> boundaries = new ArrayList<>(n + 1);
+        boundaries.add(start);
+        BigInteger prev = lo;
+        for (int i = 1; i < n; i++) {
+            BigInteger split;
+            if (total <= 0) {
+                split = lo.add(hi.subtract(lo).multiply(BigInteger.valueOf(i))
+                    .divide(BigInteger.valueOf(n)));
+            } else {
+                double target = total * i / n;
+                BigInteger l = prev;
+                BigInteger h = hi;
+                for (int iter = 0; iter < 48 && h.subtract(l).compareTo(BigInteger.ONE) > 0; iter++) {
+                    BigInteger mid = l.add(h).shiftRight(1);
+                    if (rangeCost(start, toKey(mid, width)) < target) {
+                        l = mid;
+                    } else {
+                        h = mid;
+                    }
+                }
+                split = h;
+            }
+            if (split.compareTo(prev) > 0 && split.compareTo(hi) < 0) {
+                boundaries.add(toKey(split, width));
+                prev = split;
+            }
+        }
+        boundaries.add(end);
+        return boundaries;
+    }
+    
+    private static BigInteger toBigInteger(byte[] key, int width) {
+        byte[] padded = new byte[width];
+        System.arraycopy(key, 0, padded, 0, key.length);
+        return new BigInteger(1, padded);
+    }
+    
+    private static byte[] toKey(BigInteger value, int width) {
+        byte[] raw = value.toByteArray();
+        byte[] key = new byte[width];
+        int copy = Math.min(raw.length, width);
+        System.arraycopy(raw, raw.length - copy, key, width - copy, copy);
+        // trailing zero padding only widens the key, drop it but keep at least one byte
+        int len = width;
+        while (len > 1 && key[len - 1] == 0) {
+            len--;
+        }
+        return len == width ? key : Arrays.copyOf(key, len);
+    }
+    
     /**
      * Sets a commit hook (Change Data Capture) for this column family.
      * The hook fires synchronously after every transaction commit, receiving the full
@@ -198,11 +336,13 @@ public class ColumnFamily {
      * @param hook the commit hook callback
      * @throws TidesDBException if the hook cannot be set
      */
-    public void setCommitHook(CommitHook hook) throws TidesDBException {
+    public synchronized void setCommitHook(CommitHook hook) throws TidesDBException {
         if (hook == null) {
             throw new IllegalArgumentException("Hook cannot be null, use clearCommitHook() instead");
         }
-        commitHookCtxHandle = nativeSetCommitHook(nativeHandle, hook, commitHookCtxHandle);
+        commitHookCtxHandle = nativeSetCommitHook(nativeHandle, hook, commitHookCtxHandle,
+            trackedExpiryHandle());
+        userCommitHook = true;
     }
     
     /**
@@ -211,15 +351,319 @@ public class ColumnFamily {
      *
      * @throws TidesDBException if the hook cannot be cleared
      */
-    public void clearCommitHook() throws TidesDBException {
-        commitHookCtxHandle = nativeSetCommitHook(nativeHandle, null, commitHookCtxHandle);
+    public synchronized void clearCommitHook() throws TidesDBException {
+        commitHookCtxHandle = nativeSetCommitHook(nativeHandle, null, commitHookCtxHandle,
+            trackedExpiryHandle());
+        userCommitHook = false;
+    }
+    
+    /**
+     * Sets an asynchronous commit hook for this column family.
+     * Committing threads only copy their operations into a native queue of
+     * {@code queueCapacityBytes} (rounded up to a power of two, at least 64KB); a dedicated
+     * thread delivers them in batches through {@link CommitHook#onCommitBatch}.
+     * Commits are delivered in queue order, and whatever is queued when the hook is replaced
+     * or cleared is delivered first. Return values of {@link CommitHook#onCommit} are ignored.
+     *
+     * @param hook the commit hook callback
+     * @param queueCapacityBytes size of the native queue in bytes
+     * @param policy what committing threads do when the queue is full
+     * @throws TidesDBException if the hook cannot be set
+     */
+    public synchronized void setCommitHook(CommitHook hook, int queueCapacityBytes, CommitHookOverflowPolicy policy)
+            throws TidesDBException {
+        if (hook == null) {
+            throw new IllegalArgumentException("Hook cannot be null, use clearCommitHook() instead");
+        }
+        if (policy == null) {
+            throw new IllegalArgumentException("Policy cannot be null");
+        }
+        if (queueCapacityBytes <= 0) {
+            throw new IllegalArgumentException("Queue capacity must be positive");
+        }
+        commitHookCtxHandle = nativeSetAsyncCommitHook(nativeHandle, hook, commitHookCtxHandle,
+            queueCapacityBytes, policy.getValue(), trackedExpiryHandle());
+        userCommitHook = true;
+    }
+    
+    /**
+     * Gets the number of commits the current asynchronous commit hook could not deliver,
+     * either because the queue was full under {@link CommitHookOverflowPolicy#DROP} or because
+     * a single commit was larger than the queue.
+     *
+     * @return dropped commit count, 0 for synchronous or no hook
+     */
+    public synchronized long getCommitHookDroppedCount() {
+        return nativeCommitHookDropped(commitHookCtxHandle);
+    }
+    
+    /**
+     * Starts tracking TTL writes committed to this column family and compacts it in the
+     * background once expired keys make up {@code expiredDensityTrigger} of its SSTable keys,
+     * the counterpart of {@link ColumnFamilyConfig.Builder#tombstoneDensityTrigger} for TTLs.
+     * Only writes committed after this call are counted. Overwriting, refreshing or deleting a
+     * tracked key before it expires takes the earlier write back out of the count; past about a
+     * million pending keys further writes are counted without being matched, so the expired
+     * count is an upper bound. For bytewise-ordered column families only the range spanned by
+     * the expired keys is compacted.
+     *
+     * <p>Tracking uses the native commit hook slot alongside any {@link CommitHook}; it is
+     * runtime-only and must be re-enabled after a restart.</p>
+     *
+     * @param expiredDensityTrigger fraction of keys, greater than 0 and at most 1
+     * @param expiredDensityMinEntries expired keys required before a sweep
+     * @throws TidesDBException if the tracking hook cannot be installed
+     */
+    public synchronized void enableExpiryTracking(double expiredDensityTrigger,
+            long expiredDensityMinEntries) throws TidesDBException {
+        if (!(expiredDensityTrigger > 0 && expiredDensityTrigger <= 1)) {
+            throw new IllegalArgumentException("Expired density trigger must be in (0, 1]");
+        }
+        if (expiredDensityMinEntries < 0) {
+            throw new IllegalArgumentException("Expired density min entries cannot be negative");
+        }
+        this.expiredDensityTrigger = expiredDensityTrigger;
+        this.expiredDensityMinEntries = expiredDensityMinEntries;
+        if (expiryTracking) {
+            return;
+        }
+        if (expiryIndexHandle == 0) {
+            expiryIndexHandle = nativeExpiryIndexCreate();
+        }
+        if (userCommitHook) {
+            nativeSetCommitHookExpiry(commitHookCtxHandle, expiryIndexHandle);
+        } else {
+            commitHookCtxHandle = nativeSetCommitHook(nativeHandle, null, commitHookCtxHandle,
+                expiryIndexHandle);
+        }
+        expiryTracking = true;
+        ExpirySweeper.register(this);
+    }
+    
+    /**
+     * Stops tracking TTL writes and background expiry sweeps. Counts recorded so far are kept
+     * and resume if tracking is enabled again.
+     *
+     * @throws TidesDBException if the tracking hook cannot be removed
+     */
+    public synchronized void disableExpiryTracking() throws TidesDBException {
+        if (!expiryTracking) {
+            return;
+        }
+        ExpirySweeper.unregister(this);
+        if (userCommitHook) {
+            nativeSetCommitHookExpiry(commitHookCtxHandle, 0);
+        } else {
+            commitHookCtxHandle = nativeSetCommitHook(nativeHandle, null, commitHookCtxHandle, 0);
+        }
+        expiryTracking = false;
+    }
+    
+    public synchronized boolean isExpiryTracking() {
+        return expiryTracking;
     }
     
     long getNativeHandle() {
         return nativeHandle;
     }
     
+    /**
+     * Gets the comparator name from the column family's config. It cannot change, so it is
+     * looked up once.
+     */
+    String comparatorName() throws TidesDBException {
+        String cached = comparatorName;
+        if (cached == null) {
+            ColumnFamilyConfig config = nativeGetStats(nativeHandle).getConfig();
+            cached = config != null && config.getComparatorName() != null
+                ? config.getComparatorName() : "";
+            comparatorName = cached;
+        }
+        return cached;
+    }
+    
+    /**
+     * Whether keys are ordered bytewise, the order key-space arithmetic such as
+     * {@link #splitRange} and prefix successors assumes.
+     */
+    boolean isBytewise() throws TidesDBException {
+        String cmp = comparatorName();
+        return cmp.isEmpty() || cmp.equals("memcmp");
+    }
+    
+    private long trackedExpiryHandle() {
+        return expiryTracking ? expiryIndexHandle : 0;
+    }
+    
+    /**
+     * Compacts the column family if its expired fraction has crossed the trigger. The decision
+     * is made under the monitor and the compaction runs outside it; {@link #pauseSweeps} and
+     * {@link #release()} wait for the sweep to finish, so the handles stay valid meanwhile.
+     */
+    boolean sweepExpired(long now) throws TidesDBException {
+        long[] counts = new long[3];
+        byte[][] range;
+        synchronized (this) {
+            if (!expiryTracking || sweepsPaused || sweeping) {
+                return false;
+            }
+            range = nativeExpiryIndexPeek(expiryIndexHandle, now, counts);
+            long expired = counts[1];
+            if (expired == 0 || expired < expiredDensityMinEntries) {
+                return false;
+            }
+            Stats stats = nativeGetStats(nativeHandle);
+            if ((double) expired / Math.max(1, stats.getTotalKeys()) < expiredDensityTrigger) {
+                return false;
+            }
+            sweeping = true;
+        }
+        boolean compacted = false;
+        try {
+            if (range != null && isBytewise()) {
+                byte[] end = Arrays.copyOf(range[1], range[1].length + 1);
+                compactRange(range[0].length > 0 ? range[0] : null, end);
+            } else {
+                compact();
+            }
+            compacted = true;
+        } finally {
+            finishSweep(compacted, counts[1], counts[2], now);
+        }
+        return true;
+    }
+    
+    private synchronized void finishSweep(boolean compacted, long expired, long bytes, long now) {
+        if (compacted) {
+            nativeExpiryIndexConsume(expiryIndexHandle, expired, bytes, now);
+            expirySweeps++;
+        }
+        sweeping = false;
+        notifyAll();
+    }
+    
+    private void awaitSweep() {
+        boolean interrupted = false;
+        while (sweeping) {
+            try {
+                wait();
+            } catch (InterruptedException e) {
+                interrupted = true;
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+    }
+    
+    /**
+     * Trains a zstd dictionary on sample values and makes it the one
+     * {@link ValueCodec#encode(byte[])} uses. Earlier dictionaries stay available for decoding
+     * values written with them. The dictionary is saved in the column family's directory.
+     *
+     * @param samples representative values, ideally a few thousand
+     * @param dictionarySize maximum dictionary size in bytes, e.g. 16KB-112KB
+     * @param level zstd compression level, e.g. {@link ValueCodec#DEFAULT_LEVEL}
+     * @return this column family's value codec
+     * @throws TidesDBException if training fails or the dictionary cannot be saved
+     */
+    public synchronized ValueCodec trainValueCodec(List<byte[]> samples, int dictionarySize,
+        int level) throws TidesDBException {
+        return setValueDictionary(ValueCodec.train(samples, dictionarySize), level);
+    }
+    
+    /**
+     * Installs a dictionary trained elsewhere, e.g. with {@link ValueCodec#train}, as the
+     * current value dictionary.
+     *
+     * @param dictionary a zstd dictionary
+     * @param level zstd compression level
+     * @return this column family's value codec
+     * @throws TidesDBException if the dictionary is invalid or cannot be saved
+     */
+    public synchronized ValueCodec setValueDictionary(byte[] dictionary, int level)
+        throws TidesDBException {
+        if (dictionary == null) {
+            throw new IllegalArgumentException("Dictionary cannot be null");
+        }
+        ValueCodec codec = getValueCodec();
+        valueCodec = ValueCodec.install(codec, dataDir(), dictionary, level);
+        return valueCodec;
+    }
+    
+    /**
+     * Gets the value codec, loading dictionaries saved by an earlier process on first use.
+     *
+     * @return the value codec, or null if no dictionary has been trained
+     * @throws TidesDBException if the saved dictionaries cannot be loaded
+     */
+    public synchronized ValueCodec getValueCodec() throws TidesDBException {
+        if (!valueCodecLoaded) {
+            valueCodec = ValueCodec.load(dataDir());
+            valueCodecLoaded = true;
+        }
+        return valueCodec;
+    }
+    
+    private Path dataDir() {
+        return Paths.get(dbPath, name);
+    }
+    
+    /**
+     * Holds off expiry sweeps, waiting for one in progress, while the column family is
+     * being dropped.
+     */
+    synchronized void pauseSweeps(boolean paused) {
+        sweepsPaused = paused;
+        if (paused) {
+            awaitSweep();
+        }
+    }
+    
+    /**
+     * Uninstalls the commit hook, if any, and frees its context, the expiry index and the value
+     * dictionaries before the column family itself goes away.
+     */
+    synchronized void release() {
+        release(false);
+    }
+    
+    /**
+     * Frees the same state as {@link #release()} after the engine has dropped the column
+     * family, without touching the native column family.
+     */
+    synchronized void releaseDropped() {
+        release(true);
+    }
+    
+    private void release(boolean dropped) {
+        awaitSweep();
+        if (valueCodec != null) {
+            valueCodec.close();
+            valueCodec = null;
+        }
+        valueCodecLoaded = true;
+        ExpirySweeper.unregister(this);
+        expiryTracking = false;
+        if (commitHookCtxHandle != 0 && dropped) {
+            // the engine went with the column family, so nothing calls the hook any more
+            nativeFreeCommitHook(commitHookCtxHandle);
+            commitHookCtxHandle = 0;
+        } else if (commitHookCtxHandle != 0) {
+            try {
+                clearCommitHook();
+            } catch (TidesDBException e) {
+                // the column family is being torn down regardless
+            }
+        }
+        if (expiryIndexHandle != 0 && commitHookCtxHandle == 0) {
+            nativeExpiryIndexFree(expiryIndexHandle);
+            expiryIndexHandle = 0;
+        }
+    }
+    
     private static native Stats nativeGetStats(long handle) throws TidesDBException;
+    private static native void nativeFillMetrics(long handle, LongBuffer out, int offset) throws TidesDBException;
     private static native void nativeCompact(long handle) throws TidesDBException;
     private static native void nativeCompactRange(long handle, byte[] startKey, byte[] endKey) throws TidesDBException;
     private static native void nativeFlushMemtable(long handle) throws TidesDBException;
@@ -229,7 +673,18 @@ public class ColumnFamily {
         int skipListMaxLevel, float skipListProbability, double bloomFPR, int indexSampleRatio,
         int syncMode, long syncIntervalUs, boolean persistToDisk) throws TidesDBException;
     private static native double nativeRangeCost(long handle, byte[] keyA, byte[] keyB) throws TidesDBException;
-    private static native long nativeSetCommitHook(long handle, CommitHook hook, long oldCtxHandle) throws TidesDBException;
+    private static native long nativeSetCommitHook(long handle, CommitHook hook, long oldCtxHandle,
+        long expiryHandle) throws TidesDBException;
+    private static native long nativeSetAsyncCommitHook(long handle, CommitHook hook, long oldCtxHandle,
+        int capacityBytes, int policy, long expiryHandle) throws TidesDBException;
+    private static native void nativeSetCommitHookExpiry(long ctxHandle, long expiryHandle);
+    private static native void nativeFreeCommitHook(long ctxHandle);
+    private static native long nativeCommitHookDropped(long ctxHandle);
+    private static native long nativeExpiryIndexCreate() throws TidesDBException;
+    private static native void nativeExpiryIndexFree(long handle);
+    private static native byte[][] nativeExpiryIndexPeek(long handle, long now, long[] out);
+    private static native void nativeExpiryIndexConsume(long handle, long count, long bytes,
+        long now);
     private static native void nativePurge(long handle) throws TidesDBException;
     private static native void nativeSyncWal(long handle) throws TidesDBException;
 }
@@ -18,10 +18,16 @@
  */
 package com.tidesdb;
 
+import java.nio.ByteBuffer;
+
 /**
  * Callback interface for commit hooks (Change Data Capture).
  * Invoked synchronously after a transaction commits to a column family.
  * The hook receives the full batch of committed operations atomically.
+ *
+ * <p>Hooks installed with {@link ColumnFamily#setCommitHook(CommitHook, int, CommitHookOverflowPolicy)}
+ * run on a dedicated thread instead and receive many commits at a time through
+ * {@link #onCommitBatch(ByteBuffer, int)}.
  */
 @FunctionalInterface
 public interface CommitHook {
@@ -34,4 +40,36 @@ public interface CommitHook {
      * @return 0 on success, non-zero on failure (logged as warning, does not roll back)
      */
     int onCommit(CommitOp[] ops, long commitSeq);
+    
+    /**
+     * Called on the hook thread of an asynchronous commit hook with one or more commits.
+     * Each commit is packed as {@code [int64 seq][int32 numOps]} followed per op by
+     * {@code [int8 delete][int64 ttl][int32 keyLen][key][int32 valueLen or -1][value]}, all big-endian.
+     * The buffer is reused once this method returns and must not be retained.
+     * The default implementation decodes each commit and calls {@link #onCommit}; its return
+     * value is ignored.
+     *
+     * @param batch packed commits between position and limit
+     * @param commits number of commits in the batch
+     */
+    default void onCommitBatch(ByteBuffer batch, int commits) {
+        for (int c = 0; c < commits; c++) {
+            long commitSeq = batch.getLong();
+            CommitOp[] ops = new CommitOp[batch.getInt()];
+            for (int i = 0; i < ops.length; i++) {
+                boolean delete = batch.get() != 0;
+                long ttl = batch.getLong();
+                byte[] key = new byte[batch.getInt()];
+                batch.get(key);
+                int valueLen = batch.getInt();
+                byte[] value = null;
+                if (valueLen >= 0) {
+                    value = new byte[valueLen];
+                    batch.get(value);
+                }
+                ops[i] = new CommitOp(key, value, ttl, delete);
+            }
+            onCommit(ops, commitSeq);
+        }
+    }
 }
@@ -0,0 +1,48 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * What an asynchronous commit hook does when its native queue is full.
+ */
+public enum CommitHookOverflowPolicy {
+    /** The committing thread waits until the consumer frees space. */
+    BLOCK(0),
+    /** The commit is not delivered and counted in {@link ColumnFamily#getCommitHookDroppedCount()}. */
+    DROP(1);
+    
+    private final int value;
+    
+    CommitHookOverflowPolicy(int value) {
+        this.value = value;
+    }
+    
+    public int getValue() {
+        return value;
+    }
+    
+    public static CommitHookOverflowPolicy fromValue(int value) {
+        for (CommitHookOverflowPolicy policy : values()) {
+            if (policy.value == value) {
+                return policy;
+            }
+        }
+        throw new IllegalArgumentException("Unknown commit hook overflow policy value: " + value);
+    }
+}
@@ -0,0 +1,429 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.LongBuffer;
+import java.time.LocalTime;
+import java.time.ZoneId;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+import java.util.concurrent.PriorityBlockingQueue;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Runs manual compactions in the background under an I/O budget. Tasks are taken highest
+ * priority first (FIFO within a priority) by one daemon thread, which compacts each range
+ * in {@link ColumnFamily#splitRange cost-balanced} slices with
+ * {@link ColumnFamily#compactRange}. Between slices it:
+ * <ul>
+ *   <li>waits while the scheduler is {@link #pause() paused} or outside every configured
+ *       window;</li>
+ *   <li>sleeps long enough to keep the estimated bytes rewritten under
+ *       {@code bytesPerSecond};</li>
+ *   <li>if a foreground p99 target is set, backs off while the p99 of gets against this
+ *       database during the last slice exceeds it. This needs
+ *       {@link Config.Builder#latencyTracking}; gets against other databases in the process
+ *       are not counted.</li>
+ * </ul>
+ *
+ * <p>The engine's own background compactions, triggered by level sizes and
+ * {@code l1FileCountTrigger}, are not controlled by the scheduler. Closing the database
+ * closes its schedulers.
+ */
+public final class CompactionScheduler implements AutoCloseable {
+    
+    private static final long POLL_MS = 100;
+    private static final long MAX_BACKOFF_NANOS = TimeUnit.SECONDS.toNanos(10);
+    
+    private final TidesDB db;
+    private final long bytesPerSecond;
+    private final long foregroundP99Nanos;
+    private final int slicesPerTask;
+    private final List<LocalTime[]> windows;
+    private final ZoneId zone;
+    private final PriorityBlockingQueue<CompactionTask> queue = new PriorityBlockingQueue<>(16,
+        Comparator.comparingInt(CompactionTask::getPriority).reversed()
+            .thenComparingLong(CompactionTask::sequence));
+    private final AtomicLong sequence = new AtomicLong();
+    private final Object lock = new Object();
+    private final Thread worker;
+    private volatile boolean paused = false;
+    private volatile boolean closed = false;
+    private long backoffNanos = 0;
+    
+    private CompactionScheduler(Builder builder) {
+        this.db = builder.db;
+        this.bytesPerSecond = builder.bytesPerSecond;
+        this.foregroundP99Nanos = builder.foregroundP99Nanos;
+        this.slicesPerTask = builder.slicesPerTask;
+        this.windows = Collections.unmodifiableList(new ArrayList<>(builder.windows));
+        this.zone = builder.zone;
+        this.worker = new Thread(this::runWorker, "tidesdb-compaction-scheduler");
+        this.worker.setDaemon(true);
+        db.registerScheduler(this);
+        this.worker.start();
+    }
+    
+    /**
+     * Creates a new builder for a scheduler on {@code db}.
+     *
+     * @param db the database
+     * @return a new Builder
+     */
+    public static Builder builder(TidesDB db) {
+        return new Builder(db);
+    }
+    
+    /**
+     * Queues a compaction of the whole column family.
+     *
+     * @param cf the column family
+     * @param priority higher runs first
+     * @return the queued task
+     */
+    public CompactionTask submit(ColumnFamily cf, int priority) {
+        return submit(cf, null, null, priority);
+    }
+    
+    /**
+     * Queues a compaction of {@code [startKey, endKey)}; null means unbounded on that side.
+     *
+     * @param cf the column family
+     * @param startKey inclusive start, or null
+     * @param endKey exclusive end, or null
+     * @param priority higher runs first
+     * @return the queued task
+     */
+    public CompactionTask submit(ColumnFamily cf, byte[] startKey, byte[] endKey, int priority) {
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (closed) {
+            throw new IllegalStateException("Compaction scheduler has been closed");
+        }
+        CompactionTask task = new CompactionTask(cf, emptyToNull(startKey), emptyToNull(endKey),
+            priority, sequence.getAndIncrement());
+        queue.add(task);
+        return task;
+    }
+    
+    /**
+     * Stops starting new slices until {@link #resume()}. A slice already running finishes.
+     */
+    public void pause() {
+        paused = true;
+    }
+    
+    public void resume() {
+        synchronized (lock) {
+            paused = false;
+            lock.notifyAll();
+        }
+    }
+    
+    public boolean isPaused() {
+        return paused;
+    }
+    
+    /**
+     * Gets the number of tasks waiting to start.
+     *
+     * @return queued task count
+     */
+    public int getQueuedCount() {
+        return queue.size();
+    }
+    
+    /**
+     * Stops the scheduler, cancelling queued tasks and the running one after its current
+     * slice, and waits for the worker thread to exit.
+     */
+    @Override
+    public void close() {
+        synchronized (lock) {
+            closed = true;
+            lock.notifyAll();
+        }
+        worker.interrupt();
+        try {
+            worker.join();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+        CompactionTask task;
+        while ((task = queue.poll()) != null) {
+            task.cancel();
+        }
+        db.forgetScheduler(this);
+    }
+    
+    private void runWorker() {
+        while (!closed) {
+            CompactionTask task;
+            try {
+                task = queue.poll(POLL_MS, TimeUnit.MILLISECONDS);
+            } catch (InterruptedException e) {
+                continue;
+            }
+            if (task != null && !task.isCancelled()) {
+                run(task);
+            }
+        }
+    }
+    
+    private void run(CompactionTask task) {
+        try {
+            if (!awaitRunnable()) {
+                task.cancel();
+                return;
+            }
+            List<byte[]> bounds = plan(task);
+            if (!task.start(Math.max(0, bounds.size() - 1))) {
+                return;
+            }
+            long estimate = estimateSliceBytes(task.getColumnFamily(), bounds.size() - 1);
+            for (int i = 0; i + 1 < bounds.size(); i++) {
+                if (i > 0 && !awaitRunnable()) {
+                    task.cancel();
+                    return;
+                }
+                if (task.isCancelled()) {
+                    return;
+                }
+                LatencyHistogram before = foregroundGets();
+                long began = System.nanoTime();
+                task.getColumnFamily().compactRange(bounds.get(i), bounds.get(i + 1));
+                task.sliceDone();
+                pace(estimate, System.nanoTime() - began, before);
+            }
+            task.complete();
+        } catch (TidesDBException | RuntimeException e) {
+            task.fail(e);
+        }
+    }
+    
+    /**
+     * Resolves the task's range to concrete bounds and splits it. Open ends are replaced
+     * by the column family's first key and the successor of its last key. Ranges of
+     * column families that are not bytewise-ordered cannot be split by key space and run
+     * as one slice.
+     */
+    private List<byte[]> plan(CompactionTask task) throws TidesDBException {
+        ColumnFamily cf = task.getColumnFamily();
+        if (!cf.isBytewise()) {
+            return Arrays.asList(task.startKey(), task.endKey());
+        }
+        byte[] start = task.startKey();
+        byte[] end = task.endKey();
+        if (start == null || end == null) {
+            try (Transaction txn = db.beginTransaction(IsolationLevel.READ_COMMITTED);
+                 TidesDBIterator iter = txn.newIterator(cf)) {
+                if (start == null) {
+                    iter.seekToFirst();
+                    if (!iter.isValid()) {
+                        return Collections.emptyList();
+                    }
+                    start = iter.key();
+                }
+                if (end == null) {
+                    iter.seekToLast();
+                    if (!iter.isValid()) {
+                        return Collections.emptyList();
+                    }
+                    byte[] last = iter.key();
+                    end = new byte[last.length + 1];
+                    System.arraycopy(last, 0, end, 0, last.length);
+                }
+            }
+        }
+        if (Arrays.compareUnsigned(start, end) >= 0) {
+            return Collections.emptyList();
+        }
+        return cf.splitRange(start, end, slicesPerTask);
+    }
+    
+    /**
+     * Each slice covers a similar share of the range's cost, so an even share of the column
+     * family's SSTable bytes bounds what it rewrites. Overestimates for narrow ranges, which
+     * errs on the side of throttling.
+     */
+    private long estimateSliceBytes(ColumnFamily cf, int slices) throws TidesDBException {
+        if (bytesPerSecond <= 0 || slices <= 0) {
+            return 0;
+        }
+        LongBuffer metrics = Metrics.allocate(Metrics.CF_SLOTS);
+        cf.fillMetrics(metrics);
+        return metrics.get(Metrics.CF_LEVEL_BYTES) / slices;
+    }
+    
+    private LatencyHistogram foregroundGets() throws TidesDBException {
+        if (foregroundP99Nanos <= 0) {
+            return null;
+        }
+        return db.dbGetLatency();
+    }
+    
+    private void pace(long sliceBytes, long elapsedNanos, LatencyHistogram before)
+        throws TidesDBException {
+        long delay = 0;
+        if (sliceBytes > 0) {
+            long budgetNanos = (long) (sliceBytes * 1e9 / bytesPerSecond);
+            delay = Math.max(0, budgetNanos - elapsedNanos);
+        }
+        if (before != null) {
+            LatencyHistogram gets = foregroundGets().since(before);
+            if (gets.getCount() > 0 && gets.getValueAtPercentile(99) > foregroundP99Nanos) {
+                backoffNanos = Math.min(MAX_BACKOFF_NANOS,
+                    Math.max(elapsedNanos, backoffNanos * 2));
+            } else {
+                backoffNanos /= 2;
+            }
+            delay += backoffNanos;
+        }
+        if (delay > 0) {
+            synchronized (lock) {
+                long deadline = System.nanoTime() + delay;
+                long remaining;
+                while (!closed && (remaining = deadline - System.nanoTime()) > 0) {
+                    try {
+                        TimeUnit.NANOSECONDS.timedWait(lock, remaining);
+                    } catch (InterruptedException e) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+    
+    /**
+     * Waits until the scheduler is running and inside a window. Returns false if it was
+     * closed meanwhile.
+     */
+    private boolean awaitRunnable() {
+        synchronized (lock) {
+            while (!closed && (paused || !inWindow())) {
+                try {
+                    lock.wait(POLL_MS);
+                } catch (InterruptedException e) {
+                    // close() interrupts; the loop condition sees it
+                }
+            }
+            return !closed;
+        }
+    }
+    
+    private boolean inWindow() {
+        if (windows.isEmpty()) {
+            return true;
+        }
+        LocalTime now = LocalTime.now(zone);
+        for (LocalTime[] window : windows) {
+            LocalTime from = window[0];
+            LocalTime to = window[1];
+            boolean inside = from.isBefore(to)
+                ? !now.isBefore(from) && now.isBefore(to)
+                : !now.isBefore(from) || now.isBefore(to);
+            if (inside) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    private static byte[] emptyToNull(byte[] key) {
+        return key == null || key.length == 0 ? null : key;
+    }
+    
+    /**
+     * Builder for CompactionScheduler.
+     */
+    public static class Builder {
+        private final TidesDB db;
+        private long bytesPerSecond = 0;
+        private long foregroundP99Nanos = 0;
+        private int slicesPerTask = 16;
+        private final List<LocalTime[]> windows = new ArrayList<>();
+        private ZoneId zone = ZoneId.systemDefault();
+        
+        private Builder(TidesDB db) {
+            this.db = db;
+        }
+        
+        /**
+         * Caps the estimated bytes compacted per second; 0 (the default) means unlimited.
+         */
+        public Builder bytesPerSecond(long bytesPerSecond) {
+            this.bytesPerSecond = bytesPerSecond;
+            return this;
+        }
+        
+        /**
+         * Backs off while the p99 of foreground gets exceeds this; 0 (the default) disables it.
+         */
+        public Builder foregroundP99Target(long duration, TimeUnit unit) {
+            this.foregroundP99Nanos = unit.toNanos(duration);
+            return this;
+        }
+        
+        public Builder slicesPerTask(int slicesPerTask) {
+            this.slicesPerTask = slicesPerTask;
+            return this;
+        }
+        
+        /**
+         * Adds a daily window in which slices may start; a window whose end is before its
+         * start wraps past midnight. With no windows, compaction may run at any time.
+         */
+        public Builder window(LocalTime from, LocalTime to) {
+            if (from == null || to == null) {
+                throw new IllegalArgumentException("Window bounds cannot be null");
+            }
+            windows.add(new LocalTime[] {from, to});
+            return this;
+        }
+        
+        public Builder zone(ZoneId zone) {
+            this.zone = zone;
+            return this;
+        }
+        
+        public CompactionScheduler build() {
+            if (db == null) {
+                throw new IllegalArgumentException("Database cannot be null");
+            }
+            if (bytesPerSecond < 0) {
+                throw new IllegalArgumentException("Bytes per second cannot be negative");
+            }
+            if (foregroundP99Nanos < 0) {
+                throw new IllegalArgumentException("Foreground p99 target cannot be negative");
+            }
+            if (slicesPerTask <= 0) {
+                throw new IllegalArgumentException("Slices per task must be positive");
+            }
+            if (zone == null) {
+                throw new IllegalArgumentException("Zone cannot be null");
+            }
+            return new CompactionScheduler(this);
+        }
+    }
+}
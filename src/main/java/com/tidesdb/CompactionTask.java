@@ -0,0 +1,163 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * A compaction queued on a {@link CompactionScheduler}. Its range is compacted in slices,
+ * and progress is the fraction of slices done.
+ */
+public final class CompactionTask {
+    
+    /**
+     * Lifecycle of a task.
+     */
+    public enum State {
+        QUEUED,
+        RUNNING,
+        DONE,
+        FAILED,
+        CANCELLED
+    }
+    
+    private final ColumnFamily cf;
+    private final byte[] startKey;
+    private final byte[] endKey;
+    private final int priority;
+    private final long sequence;
+    private final CompletableFuture<Void> future = new CompletableFuture<>();
+    private final AtomicInteger completedSlices = new AtomicInteger();
+    private volatile int totalSlices = 0;
+    private volatile State state = State.QUEUED;
+    
+    CompactionTask(ColumnFamily cf, byte[] startKey, byte[] endKey, int priority, long sequence) {
+        this.cf = cf;
+        this.startKey = startKey;
+        this.endKey = endKey;
+        this.priority = priority;
+        this.sequence = sequence;
+    }
+    
+    public ColumnFamily getColumnFamily() {
+        return cf;
+    }
+    
+    public int getPriority() {
+        return priority;
+    }
+    
+    public State getState() {
+        return state;
+    }
+    
+    /**
+     * Gets the number of slices the range was split into, 0 until the task starts.
+     *
+     * @return total slices
+     */
+    public int getTotalSlices() {
+        return totalSlices;
+    }
+    
+    public int getCompletedSlices() {
+        return completedSlices.get();
+    }
+    
+    /**
+     * Gets the fraction of the task that has been compacted.
+     *
+     * @return progress between 0.0 and 1.0
+     */
+    public double getProgress() {
+        if (state == State.DONE) {
+            return 1.0;
+        }
+        int total = totalSlices;
+        return total == 0 ? 0.0 : (double) completedSlices.get() / total;
+    }
+    
+    /**
+     * Returns a future completed when the task finishes, fails or is cancelled.
+     *
+     * @return the completion future
+     */
+    public CompletableFuture<Void> toFuture() {
+        return future;
+    }
+    
+    /**
+     * Cancels the task. A queued task never starts; a running one stops after its current
+     * slice.
+     *
+     * @return true if the task had not finished yet
+     */
+    public synchronized boolean cancel() {
+        if (state == State.DONE || state == State.FAILED || state == State.CANCELLED) {
+            return false;
+        }
+        state = State.CANCELLED;
+        future.cancel(false);
+        return true;
+    }
+    
+    boolean isCancelled() {
+        return state == State.CANCELLED;
+    }
+    
+    byte[] startKey() {
+        return startKey;
+    }
+    
+    byte[] endKey() {
+        return endKey;
+    }
+    
+    long sequence() {
+        return sequence;
+    }
+    
+    synchronized boolean start(int slices) {
+        if (state != State.QUEUED) {
+            return false;
+        }
+        totalSlices = slices;
+        state = State.RUNNING;
+        return true;
+    }
+    
+    void sliceDone() {
+        completedSlices.incrementAndGet();
+    }
+    
+    synchronized void complete() {
+        if (state == State.RUNNING) {
+            state = State.DONE;
+            future.complete(null);
+        }
+    }
+    
+    synchronized void fail(Throwable error) {
+        if (state == State.RUNNING || state == State.QUEUED) {
+            state = State.FAILED;
+            future.completeExceptionally(error);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Comparators compiled into the native binding. They are registered with every database on
+ * open, so a column family selects one by passing its name to
+ * {@link ColumnFamilyConfig.Builder#comparatorName(String)}. Comparisons never call into Java.
+ *
+ * <p>The comparator of a column family is fixed once it holds data; reopen it with the same name.
+ * Opening fails if a recovered column family was bound to a different function before these
+ * comparators could be registered.
+ */
+public final class Comparators {
+    
+    /**
+     * 8-byte keys ordered as unsigned big-endian integers. Keys of other widths sort by length,
+     * then bytewise.
+     */
+    public static final String UINT64_BE = "uint64_be";
+    
+    /**
+     * 8-byte keys ordered as signed big-endian (two's complement) integers. Keys of other
+     * widths sort by length, then bytewise.
+     */
+    public static final String INT64_BE = "int64_be";
+    
+    /** Bytewise order reversed, so iteration from the first key runs from largest to smallest. */
+    public static final String REVERSE_BYTEWISE = "reverse_bytewise";
+    
+    /**
+     * Keys built by {@link #prefixTimestampKey(byte[], long)}: the prefix sorts bytewise and,
+     * within a prefix, newer timestamps sort first. Keys shorter than 8 bytes sort before all
+     * others, bytewise among themselves.
+     */
+    public static final String PREFIX_TS_DESC = "prefix_ts_desc";
+    
+    private Comparators() {
+    }
+    
+    /**
+     * Builds a key for {@link #UINT64_BE} or {@link #INT64_BE}.
+     *
+     * @param value the integer key
+     * @return 8 big-endian bytes
+     */
+    public static byte[] int64Key(long value) {
+        byte[] key = new byte[8];
+        putLong(key, 0, value);
+        return key;
+    }
+    
+    /**
+     * Builds a key for {@link #PREFIX_TS_DESC}, for example a series id followed by a timestamp.
+     * The timestamp is stored as is, the comparator takes care of the descending order.
+     *
+     * @param prefix the key prefix
+     * @param timestamp the timestamp, compared as an unsigned value
+     * @return the prefix followed by 8 big-endian timestamp bytes
+     */
+    public static byte[] prefixTimestampKey(byte[] prefix, long timestamp) {
+        if (prefix == null) {
+            throw new IllegalArgumentException("Prefix cannot be null");
+        }
+        byte[] key = new byte[prefix.length + 8];
+        System.arraycopy(prefix, 0, key, 0, prefix.length);
+        putLong(key, prefix.length, timestamp);
+        return key;
+    }
+    
+    private static void putLong(byte[] dst, int offset, long value) {
+        for (int i = 7; i >= 0; i--) {
+            dst[offset + i] = (byte) value;
+            value >>>= 8;
+        }
+    }
+}
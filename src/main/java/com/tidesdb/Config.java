@@ -43,8 +43,14 @@ public class Config {
     private int unifiedMemtableSyncMode;
     private long unifiedMemtableSyncIntervalUs;
     private String objectStoreFsPath;
+    private S3Config objectStoreS3;
     private ObjectStoreConfig objectStoreConfig;
     private int maxConcurrentFlushes;
+    private int asyncThreads;
+    private int asyncQueueCapacity;
+    private long groupCommitWindowUs;
+    private int groupCommitMaxBatch;
+    private boolean latencyTracking;
 
     private Config(Builder builder) {
         this.dbPath = builder.dbPath;
@@ -63,8 +69,14 @@ public class Config {
         this.unifiedMemtableSyncMode = builder.unifiedMemtableSyncMode;
         this.unifiedMemtableSyncIntervalUs = builder.unifiedMemtableSyncIntervalUs;
         this.objectStoreFsPath = builder.objectStoreFsPath;
+        this.objectStoreS3 = builder.objectStoreS3;
         this.objectStoreConfig = builder.objectStoreConfig;
         this.maxConcurrentFlushes = builder.maxConcurrentFlushes;
+        this.asyncThreads = builder.asyncThreads;
+        this.asyncQueueCapacity = builder.asyncQueueCapacity;
+        this.groupCommitWindowUs = builder.groupCommitWindowUs;
+        this.groupCommitMaxBatch = builder.groupCommitMaxBatch;
+        this.latencyTracking = builder.latencyTracking;
     }
 
     /**
@@ -164,6 +176,10 @@ public class Config {
         return objectStoreFsPath;
     }
 
+    public S3Config getObjectStoreS3() {
+        return objectStoreS3;
+    }
+
     public ObjectStoreConfig getObjectStoreConfig() {
         return objectStoreConfig;
     }
@@ -172,6 +188,26 @@ public class Config {
         return maxConcurrentFlushes;
     }
 
+    public int getAsyncThreads() {
+        return asyncThreads;
+    }
+
+    public int getAsyncQueueCapacity() {
+        return asyncQueueCapacity;
+    }
+
+    public long getGroupCommitWindowUs() {
+        return groupCommitWindowUs;
+    }
+
+    public int getGroupCommitMaxBatch() {
+        return groupCommitMaxBatch;
+    }
+
+    public boolean isLatencyTracking() {
+        return latencyTracking;
+    }
+
     /**
      * Builder for Config.
      */
@@ -192,8 +228,14 @@ public class Config {
         private int unifiedMemtableSyncMode = 0;
         private long unifiedMemtableSyncIntervalUs = 0;
         private String objectStoreFsPath = null;
+        private S3Config objectStoreS3 = null;
         private ObjectStoreConfig objectStoreConfig = null;
         private int maxConcurrentFlushes = 0;
+        private int asyncThreads = 4;
+        private int asyncQueueCapacity = 1024;
+        private long groupCommitWindowUs = 0;
+        private int groupCommitMaxBatch = 64;
+        private boolean latencyTracking = false;
 
         public Builder dbPath(String dbPath) {
             this.dbPath = dbPath;
@@ -275,6 +317,15 @@ public class Config {
             return this;
         }
 
+        /**
+         * Stores SSTables in an S3-compatible bucket instead of the filesystem connector
+         * set by {@link #objectStoreFsPath(String)}; the two are mutually exclusive.
+         */
+        public Builder objectStoreS3(S3Config objectStoreS3) {
+            this.objectStoreS3 = objectStoreS3;
+            return this;
+        }
+
         public Builder objectStoreConfig(ObjectStoreConfig objectStoreConfig) {
             this.objectStoreConfig = objectStoreConfig;
             return this;
@@ -285,6 +336,42 @@ public class Config {
             return this;
         }
 
+        public Builder asyncThreads(int asyncThreads) {
+            this.asyncThreads = asyncThreads;
+            return this;
+        }
+
+        public Builder asyncQueueCapacity(int asyncQueueCapacity) {
+            this.asyncQueueCapacity = asyncQueueCapacity;
+            return this;
+        }
+
+        /**
+         * Enables group commit: commits arriving within this many microseconds of each other
+         * share one WAL sync per column family. 0 (the default) disables it. Intended for
+         * column families using {@link SyncMode#SYNC_NONE} or {@link SyncMode#SYNC_INTERVAL}.
+         */
+        public Builder groupCommitWindowUs(long groupCommitWindowUs) {
+            this.groupCommitWindowUs = groupCommitWindowUs;
+            return this;
+        }
+
+        public Builder groupCommitMaxBatch(int groupCommitMaxBatch) {
+            this.groupCommitMaxBatch = groupCommitMaxBatch;
+            return this;
+        }
+
+        /**
+         * Records native latency histograms for puts, gets, commits, iterator steps and commit
+         * hook dispatch, read with {@link TidesDB#getLatencyHistograms()}. Tracking is
+         * process-wide and stays on while any database that enabled it is open;
+         * {@link TidesDB#setLatencyTracking(boolean)} toggles it at runtime.
+         */
+        public Builder latencyTracking(boolean latencyTracking) {
+            this.latencyTracking = latencyTracking;
+            return this;
+        }
+
         public Config build() {
             validate();
             return new Config(this);
@@ -312,6 +399,21 @@ public class Config {
             if (maxOpenSSTables <= 0) {
                 throw new IllegalArgumentException("Max open SSTables must be positive");
             }
+            if (asyncThreads <= 0) {
+                throw new IllegalArgumentException("Number of async threads must be positive");
+            }
+            if (asyncQueueCapacity <= 0) {
+                throw new IllegalArgumentException("Async queue capacity must be positive");
+            }
+            if (groupCommitWindowUs < 0) {
+                throw new IllegalArgumentException("Group commit window cannot be negative");
+            }
+            if (groupCommitMaxBatch <= 0) {
+                throw new IllegalArgumentException("Group commit max batch must be positive");
+            }
+            if (objectStoreFsPath != null && objectStoreS3 != null) {
+                throw new IllegalArgumentException("Only one object store connector can be configured");
+            }
         }
     }
 }
@@ -0,0 +1,85 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * An engine state change observed by the event monitor; see {@link EventType} for what
+ * {@link #getValue()} holds for each kind.
+ */
+public class Event {
+    
+    private final EventType type;
+    private final String columnFamily;
+    private final long value;
+    private final long durationUs;
+    
+    public Event(EventType type, String columnFamily, long value, long durationUs) {
+        this.type = type;
+        this.columnFamily = columnFamily;
+        this.value = value;
+        this.durationUs = durationUs;
+    }
+    
+    /**
+     * Gets the kind of event.
+     *
+     * @return the event type
+     */
+    public EventType getType() {
+        return type;
+    }
+    
+    /**
+     * Gets the column family the event belongs to.
+     *
+     * @return the column family name, or null for database-wide events
+     */
+    public String getColumnFamily() {
+        return columnFamily;
+    }
+    
+    /**
+     * Gets the event's value, such as a byte count or pressure level.
+     *
+     * @return the value
+     */
+    public long getValue() {
+        return value;
+    }
+    
+    /**
+     * Gets how long the flush, compaction or stall lasted, for end events. The monitor
+     * samples state, so durations are accurate to its interval.
+     *
+     * @return duration in microseconds, or 0 for begin events
+     */
+    public long getDurationUs() {
+        return durationUs;
+    }
+    
+    @Override
+    public String toString() {
+        return "Event{" +
+            "type=" + type +
+            ", columnFamily='" + columnFamily + '\'' +
+            ", value=" + value +
+            ", durationUs=" + durationUs +
+            '}';
+    }
+}
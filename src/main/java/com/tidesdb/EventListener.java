@@ -0,0 +1,36 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Receives engine events from {@link TidesDB#setEventListener(EventListener, long)}.
+ * Events are delivered in order on the database's monitor thread, never on engine
+ * threads, so a slow listener only delays later events. Listeners may call into the
+ * database but must not replace the listener or close the database.
+ */
+@FunctionalInterface
+public interface EventListener {
+    
+    /**
+     * Called for each event.
+     *
+     * @param event the event
+     */
+    void onEvent(Event event);
+}
@@ -0,0 +1,48 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Entry point the native event monitor thread calls to deliver events.
+ */
+final class EventListeners {
+    
+    private static final ThreadLocal<Boolean> DELIVERING = new ThreadLocal<>();
+    
+    private EventListeners() {
+    }
+    
+    static void deliver(EventListener listener, int type, String columnFamily, long value, long durationUs) {
+        DELIVERING.set(Boolean.TRUE);
+        try {
+            listener.onEvent(new Event(EventType.fromValue(type), columnFamily, value, durationUs));
+        } finally {
+            DELIVERING.remove();
+        }
+    }
+    
+    /**
+     * Rejects calls that would wait for the monitor thread from the monitor thread itself.
+     */
+    static void checkNotDelivering() {
+        if (DELIVERING.get() != null) {
+            throw new IllegalStateException("Cannot stop the event monitor from an event listener");
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Kinds of {@link Event} reported to an {@link EventListener}.
+ */
+public enum EventType {
+    /** Memory pressure level changed; value is the new level, duration the previous one. */
+    MEMORY_PRESSURE(0),
+    /** Immutable memtables queued for flush reached a column family's {@code l0QueueStallThreshold}. */
+    WRITE_STALL_BEGIN(1),
+    /** The flush queue drained below the stall threshold again. */
+    WRITE_STALL_END(2),
+    /** A column family started flushing a memtable. */
+    FLUSH_BEGIN(3),
+    /** A flush finished; value is the bytes it added to SSTables. */
+    FLUSH_END(4),
+    /** A column family started compacting. */
+    COMPACTION_BEGIN(5),
+    /** A compaction finished; value is the bytes it reclaimed. */
+    COMPACTION_END(6);
+    
+    private final int value;
+    
+    EventType(int value) {
+        this.value = value;
+    }
+    
+    public int getValue() {
+        return value;
+    }
+    
+    public static EventType fromValue(int value) {
+        for (EventType type : values()) {
+            if (type.value == value) {
+                return type;
+            }
+        }
+        throw new IllegalArgumentException("Unknown event type value: " + value);
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+/**
+ * Shared daemon thread that checks every column family with expiry tracking enabled about
+ * once a second and compacts those whose expired fraction has crossed their trigger. Started
+ * with the first tracked column family.
+ */
+final class ExpirySweeper {
+    
+    private static final System.Logger LOG = System.getLogger("com.tidesdb");
+    private static final long INTERVAL_MS = 1000;
+    private static final Set<ColumnFamily> TRACKED = ConcurrentHashMap.newKeySet();
+    private static Thread thread;
+    
+    private ExpirySweeper() {
+    }
+    
+    static synchronized void register(ColumnFamily cf) {
+        TRACKED.add(cf);
+        if (thread == null) {
+            thread = new Thread(ExpirySweeper::run, "tidesdb-expiry-sweeper");
+            thread.setDaemon(true);
+            thread.start();
+        }
+    }
+    
+    static void unregister(ColumnFamily cf) {
+        TRACKED.remove(cf);
+    }
+    
+    private static void run() {
+        for (;;) {
+            try {
+                Thread.sleep(INTERVAL_MS);
+            } catch (InterruptedException e) {
+                return;
+            }
+            long now = System.currentTimeMillis() / 1000;
+            for (ColumnFamily cf : TRACKED) {
+                try {
+                    cf.sweepExpired(now);
+                } catch (TidesDBException e) {
+                    // typically another compaction is running; the next pass retries
+                    LOG.log(System.Logger.Level.DEBUG,
+                        "Expiry sweep of column family " + cf.getName() + " failed: " + e.getMessage());
+                } catch (RuntimeException e) {
+                    LOG.log(System.Logger.Level.WARNING,
+                        "Expiry sweep of column family " + cf.getName() + " failed", e);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * Coalesces the write-ahead log syncs of concurrent commits. Enabled through
+ * {@link Config.Builder#groupCommitWindowUs(long)}.
+ *
+ * <p>Each transaction commits on its own thread first, so conflicts and other commit errors
+ * are reported to exactly the caller they belong to. A committed transaction then joins the
+ * open batch. The first member of a batch becomes its leader: it waits until the window
+ * elapses or the batch reaches its maximum size, closes the batch, and syncs the WAL of every
+ * column family the batch touched once. Every member returns when that sync completes, so
+ * one fsync per column family covers the whole batch.</p>
+ *
+ * <p>This only saves work when the column families do not already fsync on each commit, so
+ * it is meant for column families using {@link SyncMode#SYNC_NONE} or
+ * {@link SyncMode#SYNC_INTERVAL}, with group commit providing per-commit durability.</p>
+ */
+final class GroupCommitter {
+
+    private static final class Batch {
+        final Map<Long, ColumnFamily> columnFamilies = new HashMap<>();
+        int size = 0;
+        boolean done = false;
+        TidesDBException error = null;
+    }
+
+    private final long windowNanos;
+    private final int maxBatch;
+    private final Object lock = new Object();
+    private Batch open = null;
+    private long batches = 0;
+
+    GroupCommitter(long windowUs, int maxBatch) {
+        this.windowNanos = windowUs * 1000L;
+        this.maxBatch = maxBatch;
+    }
+
+    /**
+     * Gets how many batches have been closed, each covered by one WAL sync per column family.
+     */
+    long batchCount() {
+        synchronized (lock) {
+            return batches;
+        }
+    }
+
+    /**
+     * Blocks until the WALs of {@code touched} have been synced as part of a batch.
+     *
+     * @param touched column families written by a transaction that has already committed
+     * @throws TidesDBException if the batch's WAL sync fails
+     */
+    void awaitDurable(List<ColumnFamily> touched) throws TidesDBException {
+        if (touched.isEmpty()) {
+            return;
+        }
+
+        Batch batch;
+        boolean leader;
+        synchronized (lock) {
+            if (open == null) {
+                open = new Batch();
+            }
+            batch = open;
+            leader = batch.size == 0;
+            for (ColumnFamily cf : touched) {
+                batch.columnFamilies.putIfAbsent(cf.getNativeHandle(), cf);
+            }
+            batch.size++;
+
+            if (leader) {
+                long deadline = System.nanoTime() + windowNanos;
+                long remaining = windowNanos;
+                boolean interrupted = false;
+                while (batch.size < maxBatch && remaining > 0) {
+                    try {
+                        lock.wait(remaining / 1_000_000L, (int) (remaining % 1_000_000L));
+                    } catch (InterruptedException e) {
+                        // Followers depend on the leader; finish the batch, restore the flag after
+                        interrupted = true;
+                    }
+                    remaining = deadline - System.nanoTime();
+                }
+                open = null;
+                batches++;
+                if (interrupted) {
+                    Thread.currentThread().interrupt();
+                }
+            } else if (batch.size >= maxBatch) {
+                lock.notifyAll();
+            }
+        }
+
+        if (leader) {
+            // The batch is closed, so its column family set no longer changes
+            TidesDBException error = null;
+            for (ColumnFamily cf : batch.columnFamilies.values()) {
+                try {
+                    cf.syncWal();
+                } catch (TidesDBException e) {
+                    if (error == null) {
+                        error = e;
+                    }
+                }
+            }
+            synchronized (lock) {
+                batch.error = error;
+                batch.done = true;
+                lock.notifyAll();
+            }
+        } else {
+            synchronized (lock) {
+                boolean interrupted = false;
+                while (!batch.done) {
+                    try {
+                        lock.wait();
+                    } catch (InterruptedException e) {
+                        // The transaction is already committed; only durability is pending
+                        interrupted = true;
+                    }
+                }
+                if (interrupted) {
+                    Thread.currentThread().interrupt();
+                }
+            }
+        }
+
+        if (batch.error != null) {
+            throw new TidesDBException("group commit WAL sync failed: " + batch.error.getMessage(),
+                batch.error.getErrorCode(), batch.error);
+        }
+    }
+}
@@ -0,0 +1,334 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.DirectoryStream;
+import java.nio.file.FileAlreadyExistsException;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.nio.file.attribute.FileTime;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.Stream;
+
+/**
+ * Turns a checkpoint into a backup directory. Each file is hard-linked from the previous
+ * backup when its manifest entry matches, otherwise copied from the checkpoint under the
+ * bandwidth cap. The manifest is written last, so a directory without one is not a
+ * complete backup and cannot be used as a base.
+ */
+final class IncrementalBackup {
+    
+    static final String MANIFEST = "BACKUP_MANIFEST";
+    private static final String MANIFEST_HEADER = "tidesdb-backup 1";
+    private static final int CHUNK_SIZE = 1024 * 1024;
+    
+    /**
+     * A file of the backup, identified by its path relative to the backup root.
+     */
+    private static final class Entry {
+        final String path;
+        final long size;
+        final long mtimeMillis;
+        
+        Entry(String path, long size, long mtimeMillis) {
+            this.path = path;
+            this.size = size;
+            this.mtimeMillis = mtimeMillis;
+        }
+        
+        boolean sameFile(Entry other) {
+            return other != null && size == other.size && mtimeMillis == other.mtimeMillis;
+        }
+    }
+    
+    private final Path checkpoint;
+    private final Path target;
+    private final Path previous;
+    private final BackupOptions options;
+    private long nextFreeNanos = 0;
+    private long bytesDone = 0;
+    private int filesDone = 0;
+    private long bytesTotal = 0;
+    private int filesTotal = 0;
+    private final AtomicInteger filesCopied = new AtomicInteger();
+    private final AtomicInteger filesLinked = new AtomicInteger();
+    private long bytesCopied = 0;
+    private long bytesLinked = 0;
+    
+    private IncrementalBackup(Path checkpoint, Path target, BackupOptions options) {
+        this.checkpoint = checkpoint;
+        this.target = target;
+        this.previous = options.getSince() != null ? Path.of(options.getSince()) : null;
+        this.options = options;
+    }
+    
+    /**
+     * Writes the backup of {@code checkpoint} into {@code target}, which must be missing
+     * or empty.
+     */
+    static BackupResult run(Path checkpoint, Path target, BackupOptions options)
+        throws TidesDBException {
+        return new IncrementalBackup(checkpoint, target, options).run();
+    }
+    
+    private BackupResult run() throws TidesDBException {
+        try {
+            prepareTarget();
+            Map<String, Entry> base = previous != null ? readManifest(previous) : new HashMap<>();
+            List<Entry> entries = scan(checkpoint);
+            for (Entry entry : entries) {
+                bytesTotal += entry.size;
+            }
+            filesTotal = entries.size();
+            transfer(entries, base);
+            writeManifest(entries);
+        } catch (IOException e) {
+            throw new TidesDBException("Backup to " + target + " failed: " + e.getMessage(),
+                TidesDBException.ERR_IO, e);
+        }
+        return new BackupResult(filesCopied.get(), filesLinked.get(), bytesCopied, bytesLinked);
+    }
+    
+    private void prepareTarget() throws IOException {
+        if (Files.exists(target)) {
+            try (DirectoryStream<Path> children = Files.newDirectoryStream(target)) {
+                if (children.iterator().hasNext()) {
+                    throw new FileAlreadyExistsException(target.toString(), null,
+                        "backup directory is not empty");
+                }
+            }
+        }
+        Files.createDirectories(target);
+    }
+    
+    private void transfer(List<Entry> entries, Map<String, Entry> base)
+        throws IOException, TidesDBException {
+        int threads = Math.min(options.getParallelism(), Math.max(1, entries.size()));
+        AtomicInteger threadIds = new AtomicInteger();
+        ExecutorService pool = Executors.newFixedThreadPool(threads, r -> {
+            Thread t = new Thread(r, "tidesdb-backup-" + threadIds.incrementAndGet());
+            t.setDaemon(true);
+            return t;
+        });
+        try {
+            List<Future<Void>> futures = new ArrayList<>(entries.size());
+            for (Entry entry : entries) {
+                futures.add(pool.submit(() -> {
+                    transferOne(entry, base.get(entry.path));
+                    return null;
+                }));
+            }
+            for (Future<Void> future : futures) {
+                try {
+                    future.get();
+                } catch (ExecutionException e) {
+                    Throwable cause = e.getCause();
+                    if (cause instanceof IOException) {
+                        throw (IOException) cause;
+                    }
+                    throw new TidesDBException("Backup to " + target + " failed", cause);
+                }
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new TidesDBException("Backup to " + target + " was interrupted",
+                TidesDBException.ERR_IO, e);
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+    
+    private void transferOne(Entry entry, Entry baseEntry)
+        throws IOException, InterruptedException {
+        Path dst = target.resolve(entry.path);
+        Files.createDirectories(dst.getParent());
+        if (entry.sameFile(baseEntry) && link(previous.resolve(entry.path), dst)) {
+            filesLinked.incrementAndGet();
+            advance(entry.size, true);
+            return;
+        }
+        Path src = checkpoint.resolve(entry.path);
+        copy(src, dst);
+        Files.setLastModifiedTime(dst, FileTime.fromMillis(entry.mtimeMillis));
+        filesCopied.incrementAndGet();
+        advance(entry.size, false);
+    }
+    
+    /**
+     * Hard-links {@code dst} to a previous backup's file. Returns false when links are not
+     * possible, e.g. across filesystems, or the previous file is gone.
+     */
+    private static boolean link(Path src, Path dst) {
+        try {
+            Files.createLink(dst, src);
+            return true;
+        } catch (IOException | UnsupportedOperationException | SecurityException e) {
+            return false;
+        }
+    }
+    
+    private void copy(Path src, Path dst) throws IOException, InterruptedException {
+        if (options.getBytesPerSecond() <= 0) {
+            Files.copy(src, dst, StandardCopyOption.REPLACE_EXISTING);
+            return;
+        }
+        ByteBuffer buf = ByteBuffer.allocateDirect(CHUNK_SIZE);
+        try (FileChannel in = FileChannel.open(src, StandardOpenOption.READ);
+             FileChannel out = FileChannel.open(dst, StandardOpenOption.CREATE,
+                 StandardOpenOption.TRUNCATE_EXISTING, StandardOpenOption.WRITE)) {
+            while (in.read(buf) > 0) {
+                buf.flip();
+                throttle(buf.remaining());
+                while (buf.hasRemaining()) {
+                    out.write(buf);
+                }
+                buf.clear();
+            }
+        }
+    }
+    
+    /**
+     * Reserves a share of the bandwidth cap for {@code bytes} and sleeps until it starts.
+     * Reservations are handed out back to back, so concurrent copies share the cap.
+     */
+    private void throttle(int bytes) throws InterruptedException {
+        long cost = (long) (bytes * 1e9 / options.getBytesPerSecond());
+        long wait;
+        synchronized (this) {
+            long now = System.nanoTime();
+            long start = Math.max(now, nextFreeNanos);
+            nextFreeNanos = start + cost;
+            wait = start - now;
+        }
+        if (wait > 0) {
+            Thread.sleep(wait / 1_000_000, (int) (wait % 1_000_000));
+        }
+    }
+    
+    private synchronized void advance(long bytes, boolean linked) {
+        if (linked) {
+            bytesLinked += bytes;
+        } else {
+            bytesCopied += bytes;
+        }
+        bytesDone += bytes;
+        filesDone++;
+        BackupOptions.ProgressListener listener = options.getProgressListener();
+        if (listener != null) {
+            listener.onProgress(bytesDone, bytesTotal, filesDone, filesTotal);
+        }
+    }
+    
+    private static List<Entry> scan(Path root) throws IOException {
+        List<Entry> entries = new ArrayList<>();
+        try (Stream<Path> paths = Files.walk(root)) {
+            for (Path path : (Iterable<Path>) paths::iterator) {
+                BasicFileAttributes attrs = Files.readAttributes(path, BasicFileAttributes.class);
+                if (!attrs.isRegularFile()) {
+                    continue;
+                }
+                String rel = root.relativize(path).toString().replace('\\', '/');
+                if (rel.equals(MANIFEST)) {
+                    continue;
+                }
+                entries.add(new Entry(rel, attrs.size(), attrs.lastModifiedTime().toMillis()));
+            }
+        }
+        // largest first keeps the copy threads busy to the end
+        entries.sort(Comparator.comparingLong((Entry e) -> e.size).reversed());
+        return entries;
+    }
+    
+    private static Map<String, Entry> readManifest(Path dir) throws IOException {
+        Map<String, Entry> entries = new HashMap<>();
+        Path manifest = dir.resolve(MANIFEST);
+        try (BufferedReader reader = Files.newBufferedReader(manifest, StandardCharsets.UTF_8)) {
+            String line = reader.readLine();
+            if (!MANIFEST_HEADER.equals(line)) {
+                throw new IOException(manifest + " is not a backup manifest");
+            }
+            while ((line = reader.readLine()) != null) {
+                String[] fields = line.split(" ", 3);
+                if (fields.length != 3) {
+                    throw new IOException("Malformed line in " + manifest + ": " + line);
+                }
+                try {
+                    entries.put(fields[2], new Entry(fields[2], Long.parseLong(fields[0]),
+                        Long.parseLong(fields[1])));
+                } catch (NumberFormatException e) {
+                    throw new IOException("Malformed line in " + manifest + ": " + line, e);
+                }
+            }
+        } catch (NoSuchFileException e) {
+            throw new IOException(dir + " is not a complete backup (no " + MANIFEST + ")", e);
+        }
+        return entries;
+    }
+    
+    private void writeManifest(List<Entry> entries) throws IOException {
+        Path tmp = target.resolve(MANIFEST + ".tmp");
+        try (BufferedWriter writer = Files.newBufferedWriter(tmp, StandardCharsets.UTF_8)) {
+            writer.write(MANIFEST_HEADER);
+            writer.newLine();
+            for (Entry entry : entries) {
+                writer.write(entry.size + " " + entry.mtimeMillis + " " + entry.path);
+                writer.newLine();
+            }
+        }
+        try (FileChannel channel = FileChannel.open(tmp, StandardOpenOption.WRITE)) {
+            channel.force(true);
+        }
+        Files.move(tmp, target.resolve(MANIFEST), StandardCopyOption.ATOMIC_MOVE);
+    }
+    
+    /**
+     * Removes a directory tree, ignoring files that are already gone.
+     */
+    static void deleteTree(Path root) throws IOException {
+        if (!Files.exists(root)) {
+            return;
+        }
+        try (Stream<Path> paths = Files.walk(root)) {
+            List<Path> all = new ArrayList<>();
+            paths.forEach(all::add);
+            for (int i = all.size() - 1; i >= 0; i--) {
+                Files.deleteIfExists(all.get(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.Arrays;
+
+/**
+ * Snapshot of a native latency histogram for one operation. Latencies are counted in
+ * log-linear buckets (8 linear buckets below 8ns, then 8 per power of two), so reported
+ * values are bucket upper bounds within 12.5% of the recorded latency.
+ */
+public final class LatencyHistogram {
+    
+    /**
+     * Operations with a histogram.
+     */
+    public enum Operation {
+        PUT,
+        GET,
+        COMMIT,
+        ITERATOR_NEXT,
+        COMMIT_HOOK
+    }
+    
+    private static final int SUB_BITS = 3;
+    private static final int SUB = 1 << SUB_BITS;
+    static final int BUCKETS = (64 - SUB_BITS + 1) * SUB;
+    
+    private final Operation operation;
+    private final long[] counts;
+    private final long count;
+    
+    LatencyHistogram(Operation operation, long[] counts) {
+        this.operation = operation;
+        this.counts = counts;
+        long total = 0;
+        for (long c : counts) {
+            total += c;
+        }
+        this.count = total;
+    }
+    
+    public Operation getOperation() {
+        return operation;
+    }
+    
+    /**
+     * Gets the number of recorded operations.
+     *
+     * @return the sample count
+     */
+    public long getCount() {
+        return count;
+    }
+    
+    /**
+     * Gets the latency at a percentile.
+     *
+     * @param percentile between 0 and 100, e.g. 99.9
+     * @return the latency in nanoseconds, 0 if nothing was recorded
+     */
+    public long getValueAtPercentile(double percentile) {
+        if (percentile < 0 || percentile > 100) {
+            throw new IllegalArgumentException("Percentile must be between 0 and 100");
+        }
+        if (count == 0) {
+            return 0;
+        }
+        long rank = Math.max(1, (long) Math.ceil(percentile / 100.0 * count));
+        long seen = 0;
+        for (int i = 0; i < counts.length; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return bucketUpperBound(i);
+            }
+        }
+        return bucketUpperBound(counts.length - 1);
+    }
+    
+    /**
+     * Gets the upper bound of the highest non-empty bucket.
+     *
+     * @return the maximum latency in nanoseconds, 0 if nothing was recorded
+     */
+    public long getMaxValue() {
+        for (int i = counts.length - 1; i >= 0; i--) {
+            if (counts[i] != 0) {
+                return bucketUpperBound(i);
+            }
+        }
+        return 0;
+    }
+    
+    /**
+     * Gets the raw bucket counts, see {@link #bucketUpperBound(int)} for their ranges.
+     *
+     * @return a copy of the bucket counts
+     */
+    public long[] getCounts() {
+        return Arrays.copyOf(counts, counts.length);
+    }
+    
+    /**
+     * Returns the latencies recorded since {@code baseline} was taken.
+     *
+     * @param baseline an earlier snapshot of the same operation's histogram
+     * @return the histogram for the interval
+     */
+    public LatencyHistogram since(LatencyHistogram baseline) {
+        if (baseline == null) {
+            throw new IllegalArgumentException("Baseline cannot be null");
+        }
+        long[] interval = new long[counts.length];
+        for (int i = 0; i < counts.length; i++) {
+            interval[i] = Math.max(0, counts[i] - baseline.counts[i]);
+        }
+        return new LatencyHistogram(operation, interval);
+    }
+    
+    /**
+     * Gets the largest latency, in nanoseconds, that falls into a bucket.
+     *
+     * @param bucket the bucket index
+     * @return the inclusive upper bound in nanoseconds
+     */
+    public static long bucketUpperBound(int bucket) {
+        if (bucket < SUB) {
+            return bucket;
+        }
+        int shift = bucket / SUB - 1;
+        long mantissa = SUB + bucket % SUB + 1;
+        if (mantissa > (Long.MAX_VALUE >> shift)) {
+            return Long.MAX_VALUE;
+        }
+        return (mantissa << shift) - 1;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.LongBuffer;
+
+/**
+ * Allocation-free metrics. The native layer writes counters and gauges into a caller-owned
+ * direct {@link LongBuffer} at fixed slot offsets, starting at the buffer's position, so a
+ * scraper can allocate one buffer per source with {@link #allocate(int)} and refill it on
+ * every scrape. Buffer positions and limits are not modified.
+ *
+ * <p>Column family slots are filled by {@link ColumnFamily#fillMetrics}, database slots by
+ * {@link TidesDB#fillMetrics} and binding slots, which are process-wide and cumulative, by
+ * {@link #fillBinding}.
+ */
+public final class Metrics {
+    
+    static {
+        NativeLibrary.load();
+    }
+    
+    /* Column family slots */
+    public static final int CF_MEMTABLE_BYTES = 0;
+    public static final int CF_NUM_LEVELS = 1;
+    public static final int CF_TOTAL_KEYS = 2;
+    public static final int CF_DATA_BYTES = 3;
+    public static final int CF_TOMBSTONES = 4;
+    public static final int CF_SSTABLES = 5;
+    public static final int CF_LEVEL_BYTES = 6;
+    public static final int CF_SLOTS = 7;
+    
+    /* Database slots */
+    public static final int DB_COLUMN_FAMILIES = 0;
+    public static final int DB_MEMORY_PRESSURE = 1;
+    public static final int DB_FLUSH_PENDING = 2;
+    public static final int DB_MEMTABLE_BYTES = 3;
+    public static final int DB_IMMUTABLES = 4;
+    public static final int DB_SSTABLES = 5;
+    public static final int DB_DATA_BYTES = 6;
+    public static final int DB_OPEN_SSTABLES = 7;
+    public static final int DB_GLOBAL_SEQ = 8;
+    public static final int DB_TXN_MEMORY_BYTES = 9;
+    public static final int DB_COMPACTION_QUEUE = 10;
+    public static final int DB_FLUSH_QUEUE = 11;
+    public static final int DB_CACHE_ENTRIES = 12;
+    public static final int DB_CACHE_BYTES = 13;
+    public static final int DB_CACHE_HITS = 14;
+    public static final int DB_CACHE_MISSES = 15;
+    public static final int DB_SLOTS = 16;
+    
+    /* Binding slots: calls into the engine and bytes copied across JNI */
+    public static final int BINDING_READS = 0;
+    public static final int BINDING_WRITES = 1;
+    public static final int BINDING_COMMITS = 2;
+    public static final int BINDING_ITERATOR_STEPS = 3;
+    public static final int BINDING_BYTES_IN = 4;
+    public static final int BINDING_BYTES_OUT = 5;
+    /** First of the per-error-code exception counters, see {@link #exceptionSlot(int)}. */
+    public static final int BINDING_EXCEPTIONS = 6;
+    static final int EXCEPTION_CODES = 14;
+    public static final int BINDING_SLOTS = BINDING_EXCEPTIONS + EXCEPTION_CODES;
+    
+    private Metrics() {
+    }
+    
+    /**
+     * Allocates a direct buffer in native byte order that the fill methods accept.
+     *
+     * @param slots the number of slots, e.g. {@link #CF_SLOTS}
+     * @return a new buffer
+     */
+    public static LongBuffer allocate(int slots) {
+        if (slots <= 0) {
+            throw new IllegalArgumentException("Slot count must be positive");
+        }
+        return ByteBuffer.allocateDirect(slots * Long.BYTES).order(ByteOrder.nativeOrder()).asLongBuffer();
+    }
+    
+    /**
+     * Gets the binding slot counting exceptions raised with an error code, e.g.
+     * {@link TidesDBException#getErrorCode()}. Unknown codes share slot {@link #BINDING_EXCEPTIONS}.
+     *
+     * @param errorCode the TidesDB error code
+     * @return the slot index
+     */
+    public static int exceptionSlot(int errorCode) {
+        return errorCode < 0 && -errorCode < EXCEPTION_CODES ? BINDING_EXCEPTIONS - errorCode : BINDING_EXCEPTIONS;
+    }
+    
+    /**
+     * Fills the binding slots. Counters cover every database opened in this process.
+     *
+     * @param out a buffer with at least {@link #BINDING_SLOTS} remaining slots
+     */
+    public static void fillBinding(LongBuffer out) {
+        check(out, BINDING_SLOTS);
+        nativeFillBinding(out, out.position());
+    }
+    
+    static void check(LongBuffer out, int slots) {
+        if (out == null) {
+            throw new IllegalArgumentException("Buffer cannot be null");
+        }
+        if (!out.isDirect() || out.order() != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException("Buffer must be direct and in native byte order");
+        }
+        if (out.remaining() < slots) {
+            throw new IllegalArgumentException("Buffer needs " + slots + " slots remaining");
+        }
+    }
+    
+    private static native void nativeFillBinding(LongBuffer out, int offset);
+}
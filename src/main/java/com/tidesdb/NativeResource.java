@@ -0,0 +1,258 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.lang.ref.Cleaner;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.LongConsumer;
+
+/**
+ * Safety net for a native handle owned by a Java object. The handle is freed exactly
+ * once: by {@link #release()} when the owner is closed, by a shared {@link Cleaner}
+ * once the owner has become unreachable without being closed, or by its database's
+ * {@link Registry} when the database closes first. An unclosed owner is a leak; it
+ * is counted and logged as a warning to the {@code com.tidesdb} logger. Setting
+ * {@code -Dtidesdb.trackLeaks=true} also records where the leaked object was created,
+ * at the cost of a stack trace per allocation.
+ *
+ * <p>A resource can depend on a parent, as an iterator depends on its transaction. The
+ * parent's handle is then kept until every child has been freed, whichever order they are
+ * closed or collected in. A collected child is not freed from the cleaner thread while its
+ * parent may still be in use elsewhere; it is freed together with the parent instead.</p>
+ */
+final class NativeResource implements Runnable {
+    
+    private static final Cleaner CLEANER = Cleaner.create();
+    private static final boolean TRACK_LEAKS = Boolean.getBoolean("tidesdb.trackLeaks");
+    private static final System.Logger LOG = System.getLogger("com.tidesdb");
+    private static final AtomicLong LEAKED = new AtomicLong();
+    
+    /**
+     * The live resources of one database. {@link #close()} frees whatever is still open,
+     * children first, before the database handle itself goes away, so nothing can be freed
+     * against a closed database afterwards.
+     */
+    static final class Registry {
+        private final Set<NativeResource> live = ConcurrentHashMap.newKeySet();
+        private volatile boolean closed = false;
+        
+        boolean isClosed() {
+            return closed;
+        }
+        
+        int size() {
+            return live.size();
+        }
+        
+        void close() {
+            closed = true;
+            List<NativeResource> parents = new ArrayList<>();
+            for (NativeResource resource : live) {
+                if (resource.parent != null) {
+                    resource.freeHandle(false);
+                } else {
+                    parents.add(resource);
+                }
+            }
+            for (NativeResource resource : parents) {
+                resource.freeHandle(false);
+            }
+            live.clear();
+        }
+    }
+    
+    private final String kind;
+    private final long handle;
+    private final LongConsumer free;
+    private final NativeResource parent;
+    private final Registry registry;
+    private final Throwable allocationSite;
+    private volatile boolean released = false;
+    private Cleaner.Cleanable cleanable;
+    private int children = 0;
+    private boolean ownerGone = false;
+    private volatile boolean freed = false;
+    private List<NativeResource> orphans = Collections.emptyList();
+    
+    private NativeResource(String kind, long handle, LongConsumer free, NativeResource parent,
+            Registry registry) {
+        this.kind = kind;
+        this.handle = handle;
+        this.free = free;
+        this.parent = parent;
+        this.registry = registry;
+        this.allocationSite = TRACK_LEAKS ? new Throwable(kind + " allocated here") : null;
+    }
+    
+    /**
+     * Registers {@code handle} to be freed with {@code free} when {@code owner} is
+     * released or collected. The free function must not reference the owner.
+     */
+    static NativeResource register(Object owner, String kind, long handle, LongConsumer free) {
+        return register(owner, kind, handle, free, null, null);
+    }
+    
+    /**
+     * Registers a handle that belongs to a database, to be freed before {@code parent}'s
+     * if there is one, and by {@code registry} if the database closes first.
+     */
+    static NativeResource register(Object owner, String kind, long handle, LongConsumer free,
+            NativeResource parent, Registry registry) {
+        NativeResource resource = new NativeResource(kind, handle, free, parent, registry);
+        if (parent != null) {
+            parent.retain();
+        }
+        if (registry != null) {
+            registry.live.add(resource);
+        }
+        resource.cleanable = CLEANER.register(owner, resource);
+        return resource;
+    }
+    
+    /**
+     * Frees the handle now, or once its last child is freed, and unregisters it from the
+     * cleaner.
+     */
+    void release() {
+        released = true;
+        cleanable.clean();
+    }
+    
+    /**
+     * Hands the handle to a new owner instead of freeing it, as a transaction pool does
+     * with a closed transaction: the resource is unregistered from the cleaner and its
+     * registry and reports itself freed to the old owner. Only for resources without a
+     * parent. Returns false, leaving the resource untouched, if the handle is already gone
+     * or children still depend on it.
+     */
+    boolean detach() {
+        synchronized (this) {
+            if (freed || children > 0 || !orphans.isEmpty()) {
+                return false;
+            }
+            freed = true;
+        }
+        released = true;
+        if (registry != null) {
+            registry.live.remove(this);
+        }
+        cleanable.clean();
+        return true;
+    }
+    
+    /**
+     * Whether the handle is gone, for instance because its database was closed while the
+     * owner was still open. Owners check this before passing the handle to native code.
+     */
+    boolean isFreed() {
+        return freed;
+    }
+    
+    static long leakedCount() {
+        return LEAKED.get();
+    }
+    
+    @Override
+    public void run() {
+        if (registry != null && registry.isClosed()) {
+            // the registry freed the handle along with the database
+            return;
+        }
+        if (!released) {
+            LEAKED.incrementAndGet();
+            if (allocationSite != null) {
+                LOG.log(System.Logger.Level.WARNING,
+                    kind + " was not closed and has been freed by the cleaner", allocationSite);
+            } else {
+                LOG.log(System.Logger.Level.WARNING, kind + " was not closed and has been freed by the cleaner;"
+                    + " run with -Dtidesdb.trackLeaks=true to see where it was created");
+            }
+            if (parent != null && parent.adoptOrphan(this)) {
+                return;
+            }
+        }
+        List<NativeResource> adopted;
+        synchronized (this) {
+            ownerGone = true;
+            adopted = orphans;
+            orphans = Collections.emptyList();
+            children -= adopted.size();
+        }
+        // the owner is closed or unreachable, so nothing else uses the handle right now
+        for (NativeResource orphan : adopted) {
+            orphan.freeHandle(false);
+        }
+        synchronized (this) {
+            if (children > 0) {
+                return;
+            }
+        }
+        freeHandle(true);
+    }
+    
+    private synchronized void retain() {
+        children++;
+    }
+    
+    /**
+     * Takes over freeing a collected child while this resource's owner is still alive and
+     * may be in use on another thread. Returns false if the owner is already gone, in which
+     * case the child can be freed right away.
+     */
+    private synchronized boolean adoptOrphan(NativeResource child) {
+        if (ownerGone) {
+            return false;
+        }
+        if (orphans.isEmpty()) {
+            orphans = new ArrayList<>();
+        }
+        orphans.add(child);
+        return true;
+    }
+    
+    private void releaseChild() {
+        synchronized (this) {
+            if (--children > 0 || !ownerGone) {
+                return;
+            }
+        }
+        freeHandle(true);
+    }
+    
+    private void freeHandle(boolean notifyParent) {
+        synchronized (this) {
+            if (freed) {
+                return;
+            }
+            freed = true;
+        }
+        free.accept(handle);
+        if (registry != null) {
+            registry.live.remove(this);
+        }
+        if (notifyParent && parent != null) {
+            parent.releaseChild();
+        }
+    }
+}
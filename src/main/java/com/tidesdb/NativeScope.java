@@ -0,0 +1,92 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.ArrayDeque;
+
+/**
+ * Closes a group of native resources together. Transactions, iterators, snapshots and
+ * pools registered with a scope are closed in reverse registration order when the scope
+ * closes, so short-lived iterators can be released deterministically in bulk:
+ *
+ * <pre>{@code
+ * try (NativeScope scope = new NativeScope()) {
+ *     Transaction txn = scope.register(db.beginTransaction());
+ *     TidesDBIterator a = scope.register(txn.newIterator(cfA));
+ *     TidesDBIterator b = scope.register(txn.newIterator(cfB));
+ *     ...
+ * } // b, a, then txn are closed
+ * }</pre>
+ *
+ * <p>A scope is owned by a single thread. Resources may still be closed individually
+ * before the scope closes; closing them again is a no-op.
+ */
+public final class NativeScope implements AutoCloseable {
+    
+    private final ArrayDeque<AutoCloseable> resources = new ArrayDeque<>();
+    private boolean closed = false;
+    
+    /**
+     * Registers a resource to be closed with this scope.
+     *
+     * @param resource the resource
+     * @param <T> the resource type
+     * @return {@code resource}
+     */
+    public <T extends AutoCloseable> T register(T resource) {
+        if (resource == null) {
+            throw new IllegalArgumentException("Resource cannot be null");
+        }
+        if (closed) {
+            throw new IllegalStateException("Scope has been closed");
+        }
+        resources.push(resource);
+        return resource;
+    }
+    
+    /**
+     * Closes every registered resource, most recent first. If any close fails, the rest
+     * are still closed and the first failure is rethrown with later ones suppressed.
+     */
+    @Override
+    public void close() {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        RuntimeException failure = null;
+        AutoCloseable resource;
+        while ((resource = resources.poll()) != null) {
+            try {
+                resource.close();
+            } catch (Exception e) {
+                RuntimeException wrapped = e instanceof RuntimeException
+                    ? (RuntimeException) e : new IllegalStateException("Failed to close resource", e);
+                if (failure == null) {
+                    failure = wrapped;
+                } else {
+                    failure.addSuppressed(wrapped);
+                }
+            }
+        }
+        if (failure != null) {
+            throw failure;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Thrown by {@link ReplicaReader} when a replica is further behind its primary than a
+ * read allows.
+ */
+public class ReplicaLagException extends TidesDBException {
+    
+    private final long lag;
+    
+    public ReplicaLagException(String message, long lag) {
+        super(message);
+        this.lag = lag;
+    }
+    
+    /**
+     * Gets how many sequence numbers the replica was behind when the read gave up.
+     *
+     * @return the replication lag
+     */
+    public long getLag() {
+        return lag;
+    }
+}
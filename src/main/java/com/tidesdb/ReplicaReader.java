@@ -0,0 +1,188 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.LongBuffer;
+import java.util.concurrent.TimeUnit;
+import java.util.function.LongSupplier;
+
+/**
+ * Lag-bounded reads from a replica opened with {@link ObjectStoreConfig.Builder#replicaMode}.
+ * Staleness is measured in sequence numbers: the replica's applied sequence is its
+ * {@link DbStats#getGlobalSeq()}, and the primary's latest comes from a caller-supplied
+ * source, typically the primary publishing its own {@code getGlobalSeq()} through
+ * whatever channel the deployment already has. A read with {@code maxLag} proceeds once
+ * {@code primary - applied <= maxLag}; otherwise it waits for the replica's next sync or
+ * fails, according to {@link StalePolicy}.
+ *
+ * <p>The applied sequence only grows, so once a read has seen the replica catch up to a
+ * target, later reads for the same or an older target skip the stats call entirely.
+ * Reads use pooled read-only transactions. The reader is thread-safe; close it before
+ * closing the database.
+ */
+public final class ReplicaReader implements AutoCloseable {
+    
+    /**
+     * What a read does when the replica is further behind than allowed.
+     */
+    public enum StalePolicy {
+        /** Poll until the replica catches up or the timeout expires, then fail. */
+        WAIT,
+        /** Fail immediately with {@link ReplicaLagException}. */
+        FAIL
+    }
+    
+    static final long DEFAULT_POLL_INTERVAL_MS = 10;
+    
+    private final TidesDB db;
+    private final LongSupplier primarySequence;
+    private final long pollIntervalMs;
+    private final TransactionPool pool;
+    private final LongBuffer metrics = Metrics.allocate(Metrics.DB_SLOTS);
+    private volatile long appliedSequence = -1;
+    
+    ReplicaReader(TidesDB db, LongSupplier primarySequence, long pollIntervalMs) {
+        this.db = db;
+        this.primarySequence = primarySequence;
+        this.pollIntervalMs = pollIntervalMs;
+        this.pool = db.newTransactionPool(Math.max(1, Runtime.getRuntime().availableProcessors()));
+    }
+    
+    /**
+     * Reads the replica's current applied sequence.
+     *
+     * @return the applied sequence
+     * @throws TidesDBException if the stats cannot be retrieved
+     */
+    public long getAppliedSequence() throws TidesDBException {
+        return refresh();
+    }
+    
+    /**
+     * Gets the latest sequence reported for the primary.
+     *
+     * @return the primary's sequence
+     */
+    public long getPrimarySequence() {
+        return primarySequence.getAsLong();
+    }
+    
+    /**
+     * Gets how many sequence numbers the replica is behind the primary, or 0 if it has
+     * caught up.
+     *
+     * @return the replication lag
+     * @throws TidesDBException if the stats cannot be retrieved
+     */
+    public long getLag() throws TidesDBException {
+        long primary = primarySequence.getAsLong();
+        return Math.max(0, primary - refresh());
+    }
+    
+    /**
+     * Blocks until the replica is at most {@code maxLag} sequence numbers behind the
+     * primary as of this call.
+     *
+     * @param maxLag the allowed lag
+     * @param timeout how long to wait
+     * @param unit the timeout unit
+     * @throws ReplicaLagException if the replica does not catch up in time
+     * @throws TidesDBException if the stats cannot be retrieved
+     */
+    public void awaitLag(long maxLag, long timeout, TimeUnit unit) throws TidesDBException {
+        if (unit == null) {
+            throw new IllegalArgumentException("Time unit cannot be null");
+        }
+        await(primaryFor(maxLag), maxLag, StalePolicy.WAIT, unit.toNanos(timeout));
+    }
+    
+    /**
+     * Retrieves a value once the replica is within {@code maxLag} of the primary.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param maxLag the allowed lag in sequence numbers; 0 requires a fully caught-up replica
+     * @param policy whether to wait for the replica or fail straight away
+     * @param timeout how long {@link StalePolicy#WAIT} waits
+     * @param unit the timeout unit
+     * @return the value
+     * @throws ReplicaLagException if the replica is too far behind
+     * @throws TidesDBException if the key does not exist or the read fails
+     */
+    public byte[] get(ColumnFamily cf, byte[] key, long maxLag, StalePolicy policy, long timeout, TimeUnit unit)
+            throws TidesDBException {
+        if (policy == null) {
+            throw new IllegalArgumentException("Policy cannot be null");
+        }
+        if (unit == null) {
+            throw new IllegalArgumentException("Time unit cannot be null");
+        }
+        await(primaryFor(maxLag), maxLag, policy, unit.toNanos(timeout));
+        try (Transaction txn = pool.acquireReadOnly()) {
+            return txn.get(cf, key);
+        }
+    }
+    
+    /**
+     * Closes the reader's pooled transactions.
+     */
+    @Override
+    public void close() {
+        pool.close();
+    }
+    
+    private long primaryFor(long maxLag) {
+        if (maxLag < 0) {
+            throw new IllegalArgumentException("Max lag cannot be negative");
+        }
+        return primarySequence.getAsLong();
+    }
+    
+    private void await(long primary, long maxLag, StalePolicy policy, long timeoutNanos)
+            throws TidesDBException {
+        long target = primary - maxLag;
+        if (appliedSequence >= target) {
+            return;
+        }
+        long deadline = System.nanoTime() + timeoutNanos;
+        long applied;
+        while ((applied = refresh()) < target) {
+            if (policy == StalePolicy.FAIL || System.nanoTime() - deadline >= 0) {
+                long lag = primary - applied;
+                throw new ReplicaLagException("Replica is " + lag
+                    + " sequence numbers behind the primary, more than the allowed " + maxLag, lag);
+            }
+            try {
+                Thread.sleep(pollIntervalMs);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new TidesDBException("Interrupted while waiting for replica", e);
+            }
+        }
+    }
+    
+    private synchronized long refresh() throws TidesDBException {
+        db.fillMetrics(metrics);
+        long applied = metrics.get(Metrics.DB_GLOBAL_SEQ);
+        if (applied > appliedSequence) {
+            appliedSequence = applied;
+        }
+        return appliedSequence;
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * Connection settings for the S3-compatible object store connector (AWS S3, MinIO,
+ * Ceph RGW, R2 and similar). Transfer behavior such as multipart thresholds,
+ * concurrency limits and the local cache comes from {@link ObjectStoreConfig}.
+ *
+ * <p>The connector must be compiled into the native library; see the
+ * {@code TIDESDB_WITH_S3} CMake option.
+ */
+public class S3Config {
+
+    private String endpoint;
+    private String bucket;
+    private String prefix;
+    private String accessKey;
+    private String secretKey;
+    private String region;
+    private boolean useSsl;
+    private boolean usePathStyle;
+
+    private S3Config(Builder builder) {
+        this.endpoint = builder.endpoint;
+        this.bucket = builder.bucket;
+        this.prefix = builder.prefix;
+        this.accessKey = builder.accessKey;
+        this.secretKey = builder.secretKey;
+        this.region = builder.region;
+        this.useSsl = builder.useSsl;
+        this.usePathStyle = builder.usePathStyle;
+    }
+
+    /**
+     * Creates a new builder for S3Config.
+     *
+     * @param endpoint host and optional port, e.g. {@code s3.us-east-1.amazonaws.com}
+     * @param bucket the bucket name
+     * @return a new Builder
+     */
+    public static Builder builder(String endpoint, String bucket) {
+        return new Builder(endpoint, bucket);
+    }
+
+    public String getEndpoint() { return endpoint; }
+    public String getBucket() { return bucket; }
+    public String getPrefix() { return prefix; }
+    public String getAccessKey() { return accessKey; }
+    public String getSecretKey() { return secretKey; }
+    public String getRegion() { return region; }
+    public boolean isUseSsl() { return useSsl; }
+    public boolean isUsePathStyle() { return usePathStyle; }
+
+    @Override
+    public String toString() {
+        return "S3Config{" +
+            "endpoint='" + endpoint + '\'' +
+            ", bucket='" + bucket + '\'' +
+            ", prefix='" + prefix + '\'' +
+            ", region='" + region + '\'' +
+            ", useSsl=" + useSsl +
+            ", usePathStyle=" + usePathStyle +
+            '}';
+    }
+
+    /**
+     * Builder for S3Config.
+     */
+    public static class Builder {
+        private final String endpoint;
+        private final String bucket;
+        private String prefix = null;
+        private String accessKey = null;
+        private String secretKey = null;
+        private String region = "us-east-1";
+        private boolean useSsl = true;
+        private boolean usePathStyle = false;
+
+        private Builder(String endpoint, String bucket) {
+            this.endpoint = endpoint;
+            this.bucket = bucket;
+        }
+
+        public Builder prefix(String prefix) {
+            this.prefix = prefix;
+            return this;
+        }
+
+        public Builder credentials(String accessKey, String secretKey) {
+            this.accessKey = accessKey;
+            this.secretKey = secretKey;
+            return this;
+        }
+
+        public Builder region(String region) {
+            this.region = region;
+            return this;
+        }
+
+        public Builder useSsl(boolean useSsl) {
+            this.useSsl = useSsl;
+            return this;
+        }
+
+        public Builder usePathStyle(boolean usePathStyle) {
+            this.usePathStyle = usePathStyle;
+            return this;
+        }
+
+        public S3Config build() {
+            if (endpoint == null || endpoint.isEmpty()) {
+                throw new IllegalArgumentException("Endpoint cannot be null or empty");
+            }
+            if (bucket == null || bucket.isEmpty()) {
+                throw new IllegalArgumentException("Bucket cannot be null or empty");
+            }
+            if ((accessKey == null) != (secretKey == null)) {
+                throw new IllegalArgumentException("Access key and secret key must be set together");
+            }
+            return new S3Config(this);
+        }
+    }
+}
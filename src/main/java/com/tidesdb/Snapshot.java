@@ -0,0 +1,135 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+/**
+ * A read-only, point-in-time view of the database. Every read through a snapshot sees
+ * the data committed before {@link TidesDB#getSnapshot()} returned, regardless of
+ * writes that commit later, so one snapshot can back a consistent set of reads across
+ * several column families.
+ *
+ * <p>A snapshot is a thin wrapper over one snapshot-isolation transaction that never
+ * stages a write. The engine still records each key read in that transaction's read set,
+ * so memory grows with the number of reads; keep snapshots short-lived rather than
+ * holding one open for a long scan of point reads.</p>
+ *
+ * <p>A snapshot may be handed between threads, but its reads do not run in parallel:
+ * every method holds the snapshot's monitor for the duration of its native call, so
+ * threads sharing one snapshot take turns. The engine cannot start a second transaction
+ * at an earlier sequence, so there is no way to give each thread its own handle on the
+ * same view; for parallel reads, open one snapshot per thread and accept that each sees
+ * its own point in time. Iterators read through the snapshot's transaction without taking
+ * its monitor, so use a snapshot and its iterators from one thread at a time, and close
+ * all iterators before closing the snapshot.</p>
+ */
+public final class Snapshot implements AutoCloseable {
+    
+    private final Transaction txn;
+    private boolean closed = false;
+    
+    Snapshot(Transaction txn) {
+        this.txn = txn;
+    }
+    
+    /**
+     * Retrieves a value as of the snapshot.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return the value
+     * @throws TidesDBException if the key does not exist or the read fails
+     */
+    public synchronized byte[] get(ColumnFamily cf, byte[] key) throws TidesDBException {
+        checkNotClosed();
+        return txn.get(cf, key);
+    }
+    
+    /**
+     * Retrieves several values as of the snapshot in a single native call; see
+     * {@link Transaction#multiGet(ColumnFamily, byte[][])}.
+     *
+     * @param cf the column family
+     * @param keys the keys
+     * @return the values, with null for keys that do not exist
+     * @throws TidesDBException if the read fails
+     */
+    public synchronized byte[][] multiGet(ColumnFamily cf, byte[][] keys) throws TidesDBException {
+        checkNotClosed();
+        return txn.multiGet(cf, keys);
+    }
+    
+    /**
+     * Creates an iterator over the column family as of the snapshot.
+     *
+     * @param cf the column family
+     * @return a new iterator
+     * @throws TidesDBException if the iterator cannot be created
+     */
+    public synchronized TidesDBIterator newIterator(ColumnFamily cf) throws TidesDBException {
+        checkNotClosed();
+        return txn.newIterator(cf);
+    }
+    
+    /**
+     * Creates an iterator restricted to keys in {@code [lowerBound, upperBound)}; see
+     * {@link Transaction#newIterator(ColumnFamily, byte[], byte[])}.
+     *
+     * @param cf the column family
+     * @param lowerBound inclusive lower bound, or null for unbounded
+     * @param upperBound exclusive upper bound, or null for unbounded
+     * @return a new iterator
+     * @throws TidesDBException if the iterator cannot be created
+     */
+    public synchronized TidesDBIterator newIterator(ColumnFamily cf, byte[] lowerBound, byte[] upperBound)
+            throws TidesDBException {
+        checkNotClosed();
+        return txn.newIterator(cf, lowerBound, upperBound);
+    }
+    
+    /**
+     * Creates an iterator over the keys that start with {@code prefix}; see
+     * {@link Transaction#newPrefixIterator(ColumnFamily, byte[])}.
+     *
+     * @param cf the column family
+     * @param prefix the key prefix
+     * @return a new iterator
+     * @throws TidesDBException if the iterator cannot be created
+     */
+    public synchronized TidesDBIterator newPrefixIterator(ColumnFamily cf, byte[] prefix) throws TidesDBException {
+        checkNotClosed();
+        return txn.newPrefixIterator(cf, prefix);
+    }
+    
+    /**
+     * Releases the snapshot, letting compaction reclaim versions only it could see.
+     */
+    @Override
+    public synchronized void close() {
+        if (!closed) {
+            closed = true;
+            txn.free();
+        }
+    }
+    
+    private void checkNotClosed() {
+        if (closed) {
+            throw new IllegalStateException("Snapshot has been closed");
+        }
+    }
+}
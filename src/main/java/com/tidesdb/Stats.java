@@ -44,6 +44,12 @@ public class Stats {
     private final long[] levelTombstoneCounts;
     private final double maxSstDensity;
     private final int maxSstDensityLevel;
+    private long expiryTrackedKeys;
+    private long expiredKeys;
+    private long expiredBytes;
+    private long expirySweeps;
+    private long valueBytesIn;
+    private long valueBytesOut;
 
     public Stats(int numLevels, long memtableSize, long[] levelSizes, int[] levelNumSSTables,
                  ColumnFamilyConfig config, long totalKeys, long totalDataSize,
@@ -271,6 +277,93 @@ public class Stats {
         return maxSstDensityLevel;
     }
 
+    void setExpiry(long trackedKeys, long expiredKeys, long expiredBytes, long sweeps) {
+        this.expiryTrackedKeys = trackedKeys;
+        this.expiredKeys = expiredKeys;
+        this.expiredBytes = expiredBytes;
+        this.expirySweeps = sweeps;
+    }
+
+    /**
+     * Gets the number of tracked TTL keys that have not expired yet. Zero unless
+     * {@link ColumnFamily#enableExpiryTracking} has been called.
+     *
+     * @return tracked live TTL keys
+     */
+    public long getExpiryTrackedKeys() {
+        return expiryTrackedKeys;
+    }
+
+    /**
+     * Gets the number of tracked keys that have expired and not yet been compacted away by an
+     * expiry sweep. An upper bound, since overwrites and deletes are not subtracted.
+     *
+     * @return expired keys still on disk
+     */
+    public long getExpiredKeys() {
+        return expiredKeys;
+    }
+
+    /**
+     * Gets the key and value bytes of {@link #getExpiredKeys()}.
+     *
+     * @return expired bytes still on disk
+     */
+    public long getExpiredBytes() {
+        return expiredBytes;
+    }
+
+    /**
+     * Gets the expired fraction of the column family's SSTable keys, the value compared
+     * against the expiry trigger.
+     *
+     * @return expired keys divided by total keys, 0 when there are no keys
+     */
+    public double getExpiredRatio() {
+        return totalKeys > 0 ? (double) expiredKeys / totalKeys : 0.0;
+    }
+
+    /**
+     * Gets the number of compactions expiry sweeps have run since tracking was enabled.
+     *
+     * @return expiry sweep count
+     */
+    public long getExpirySweeps() {
+        return expirySweeps;
+    }
+
+    void setValueCodec(long bytesIn, long bytesOut) {
+        this.valueBytesIn = bytesIn;
+        this.valueBytesOut = bytesOut;
+    }
+
+    /**
+     * Gets the value bytes this process passed to the column family's {@link ValueCodec}.
+     *
+     * @return uncompressed value bytes encoded
+     */
+    public long getValueBytesIn() {
+        return valueBytesIn;
+    }
+
+    /**
+     * Gets the bytes the column family's {@link ValueCodec} produced in this process.
+     *
+     * @return encoded value bytes
+     */
+    public long getValueBytesOut() {
+        return valueBytesOut;
+    }
+
+    /**
+     * Gets the value compression ratio achieved by the column family's {@link ValueCodec}.
+     *
+     * @return uncompressed bytes divided by encoded bytes, 1.0 when nothing was encoded
+     */
+    public double getValueCompressionRatio() {
+        return valueBytesOut > 0 ? (double) valueBytesIn / valueBytesOut : 1.0;
+    }
+
     @Override
     public String toString() {
         StringBuilder sb = new StringBuilder();
@@ -292,6 +385,16 @@ public class Stats {
         sb.append(", tombstoneRatio=").append(tombstoneRatio);
         sb.append(", maxSstDensity=").append(maxSstDensity);
         sb.append(", maxSstDensityLevel=").append(maxSstDensityLevel);
+        if (expiryTrackedKeys > 0 || expiredKeys > 0 || expirySweeps > 0) {
+            sb.append(", expiryTrackedKeys=").append(expiryTrackedKeys);
+            sb.append(", expiredKeys=").append(expiredKeys);
+            sb.append(", expiredBytes=").append(expiredBytes);
+            sb.append(", expirySweeps=").append(expirySweeps);
+        }
+        if (valueBytesOut > 0) {
+            sb.append(", valueBytesIn=").append(valueBytesIn);
+            sb.append(", valueBytesOut=").append(valueBytesOut);
+        }
         if (levelSizes != null) {
             sb.append(", levelSizes=[");
             for (int i = 0; i < levelSizes.length; i++) {
@@ -19,6 +19,26 @@
 package com.tidesdb;
 
 import java.io.Closeable;
+import java.io.IOException;
+import java.nio.LongBuffer;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.EnumMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.function.BiConsumer;
+import java.util.function.LongSupplier;
 
 /**
  * TidesDB is the main database class providing access to TidesDB functionality.
@@ -26,15 +46,46 @@ import java.io.Closeable;
  */
 public class TidesDB implements Closeable {
     
+    /** Keys deleted per committed transaction by {@link #deleteRange}. */
+    public static final int DELETE_RANGE_CHUNK = 10_000;
+    
     static {
         NativeLibrary.load();
     }
     
+    /** Open databases that asked for latency tracking; guarded by TidesDB.class. */
+    private static int latencyTrackers = 0;
+    /** Whether the native histograms are recording; guarded by TidesDB.class. */
+    private static boolean latencyTrackingOn = false;
+    
     private long nativeHandle;
     private boolean closed = false;
+    private final int asyncThreads;
+    private final int asyncQueueCapacity;
+    private AsyncPool asyncPool;
+    private final GroupCommitter groupCommitter;
+    private final Map<String, ColumnFamily> columnFamilies = new ConcurrentHashMap<>();
+    private long eventMonitorHandle = 0;
+    private final String dbPath;
+    private final NativeResource.Registry resources = new NativeResource.Registry();
+    private final Set<TransactionPool> pools = ConcurrentHashMap.newKeySet();
+    private final Set<CompactionScheduler> schedulers = ConcurrentHashMap.newKeySet();
+    private final boolean latencyTracking;
+    private final int latencySlot;
     
-    private TidesDB(long nativeHandle) {
+    private TidesDB(long nativeHandle, Config config) {
         this.nativeHandle = nativeHandle;
+        this.dbPath = config.getDbPath();
+        this.asyncThreads = config.getAsyncThreads();
+        this.asyncQueueCapacity = config.getAsyncQueueCapacity();
+        this.groupCommitter = config.getGroupCommitWindowUs() > 0
+            ? new GroupCommitter(config.getGroupCommitWindowUs(), config.getGroupCommitMaxBatch())
+            : null;
+        this.latencyTracking = config.isLatencyTracking();
+        this.latencySlot = latencyTracking ? nativeAcquireLatencySlot() : -1;
+        if (latencyTracking) {
+            trackLatency(1);
+        }
     }
     
     /**
@@ -53,6 +104,7 @@ public class TidesDB implements Closeable {
         }
         
         ObjectStoreConfig osc = config.getObjectStoreConfig();
+        S3Config s3 = config.getObjectStoreS3();
 
         long handle = nativeOpen(
             config.getDbPath(),
@@ -71,6 +123,14 @@ public class TidesDB implements Closeable {
             config.getUnifiedMemtableSyncMode(),
             config.getUnifiedMemtableSyncIntervalUs(),
             config.getObjectStoreFsPath(),
+            s3 != null ? s3.getEndpoint() : null,
+            s3 != null ? s3.getBucket() : null,
+            s3 != null ? s3.getPrefix() : null,
+            s3 != null ? s3.getAccessKey() : null,
+            s3 != null ? s3.getSecretKey() : null,
+            s3 != null ? s3.getRegion() : null,
+            s3 != null && s3.isUseSsl(),
+            s3 != null && s3.isUsePathStyle(),
             osc != null ? osc.getLocalCachePath() : null,
             osc != null ? osc.getLocalCacheMaxBytes() : 0,
             osc != null ? osc.isCacheOnRead() : true,
@@ -90,7 +150,7 @@ public class TidesDB implements Closeable {
             config.getMaxConcurrentFlushes()
         );
 
-        return new TidesDB(handle);
+        return new TidesDB(handle, config);
     }
     
     /**
@@ -99,9 +159,40 @@ public class TidesDB implements Closeable {
     @Override
     public void close() {
         if (!closed && nativeHandle != 0) {
+            long monitor;
+            AsyncPool pool;
+            synchronized (this) {
+                monitor = detachEventMonitor();
+                closed = true;
+                pool = asyncPool;
+                asyncPool = null;
+            }
+            if (pool != null) {
+                // Queued operations still reference the database; drain them first. Outside
+                // the lock, so a continuation on a worker that calls back in fails fast.
+                pool.shutdown();
+            }
+            // joined outside the lock, a listener blocked on it can finish its call
+            nativeStopEventMonitor(monitor);
+            for (CompactionScheduler scheduler : schedulers) {
+                scheduler.close();
+            }
+            for (ColumnFamily cf : columnFamilies.values()) {
+                cf.release();
+            }
+            columnFamilies.clear();
+            // idle pooled handles belong to no wrapper, so the registry cannot see them
+            for (TransactionPool pool : pools) {
+                pool.close();
+            }
+            // transactions and iterators still open must not outlive the engine
+            resources.close();
             nativeClose(nativeHandle);
             nativeHandle = 0;
-            closed = true;
+            nativeReleaseLatencySlot(latencySlot);
+            if (latencyTracking) {
+                trackLatency(-1);
+            }
         }
     }
     
@@ -161,11 +252,13 @@ public class TidesDB implements Closeable {
         if (name == null || name.isEmpty()) {
             throw new IllegalArgumentException("Column family name cannot be null or empty");
         }
-        nativeDropColumnFamily(nativeHandle, name);
+        drop(name, 0);
     }
     
     /**
-     * Retrieves a column family by name.
+     * Retrieves a column family by name. Repeated lookups return the same object, so a
+     * commit hook set through one reference is replaced or cleared through any other, and
+     * hooks still installed are cleared when the database closes.
      *
      * @param name the column family name
      * @return the column family
@@ -176,8 +269,54 @@ public class TidesDB implements Closeable {
         if (name == null || name.isEmpty()) {
             throw new IllegalArgumentException("Column family name cannot be null or empty");
         }
+        ColumnFamily cf = columnFamilies.get(name);
+        if (cf != null) {
+            return cf;
+        }
         long cfHandle = nativeGetColumnFamily(nativeHandle, name);
-        return new ColumnFamily(cfHandle, name);
+        cf = new ColumnFamily(cfHandle, name, dbPath);
+        ColumnFamily existing = columnFamilies.putIfAbsent(name, cf);
+        return existing != null ? existing : cf;
+    }
+    
+    /**
+     * Drops a column family by handle, or by name when {@code cfHandle} is 0. Expiry sweeps
+     * and the event monitor are kept off it during the drop. The cached object is forgotten
+     * and its native state freed only once the drop succeeded; if it fails, the column
+     * family carries on as before.
+     */
+    private void drop(String name, long cfHandle) throws TidesDBException {
+        ColumnFamily cf = columnFamilies.get(name);
+        if (cf != null) {
+            cf.pauseSweeps(true);
+        }
+        boolean dropped = false;
+        try {
+            synchronized (this) {
+                checkNotClosed();
+                // keep the event monitor off the column family while it is freed
+                nativePauseEventMonitor(eventMonitorHandle, true);
+                try {
+                    if (cfHandle != 0) {
+                        nativeDeleteColumnFamily(nativeHandle, cfHandle);
+                    } else {
+                        nativeDropColumnFamily(nativeHandle, name);
+                    }
+                } finally {
+                    nativePauseEventMonitor(eventMonitorHandle, false);
+                }
+            }
+            dropped = true;
+        } finally {
+            if (cf != null) {
+                if (dropped) {
+                    columnFamilies.remove(name, cf);
+                    cf.releaseDropped();
+                } else {
+                    cf.pauseSweeps(false);
+                }
+            }
+        }
     }
     
     /**
@@ -200,7 +339,7 @@ public class TidesDB implements Closeable {
     public Transaction beginTransaction() throws TidesDBException {
         checkNotClosed();
         long txnHandle = nativeBeginTransaction(nativeHandle);
-        return new Transaction(txnHandle);
+        return new Transaction(txnHandle, this);
     }
     
     /**
@@ -216,7 +355,241 @@ public class TidesDB implements Closeable {
             throw new IllegalArgumentException("Isolation level cannot be null");
         }
         long txnHandle = nativeBeginTransactionWithIsolation(nativeHandle, isolationLevel.getValue());
-        return new Transaction(txnHandle);
+        return new Transaction(txnHandle, this);
+    }
+    
+    /**
+     * Opens a read-only snapshot of the database as of now; see {@link Snapshot}. Reads
+     * through one snapshot are serialized, so give each reader thread its own.
+     *
+     * @return a new snapshot
+     * @throws TidesDBException if the snapshot cannot be created
+     */
+    public Snapshot getSnapshot() throws TidesDBException {
+        return new Snapshot(beginTransaction(IsolationLevel.SNAPSHOT));
+    }
+    
+    /**
+     * Creates a pool that recycles transactions instead of freeing them; see
+     * {@link TransactionPool}.
+     *
+     * @param maxIdle the maximum number of idle transactions to keep
+     * @return a new transaction pool
+     */
+    public TransactionPool newTransactionPool(int maxIdle) {
+        checkNotClosed();
+        if (maxIdle <= 0) {
+            throw new IllegalArgumentException("Max idle must be positive");
+        }
+        TransactionPool pool = new TransactionPool(this, maxIdle);
+        pools.add(pool);
+        return pool;
+    }
+    
+    void forgetPool(TransactionPool pool) {
+        pools.remove(pool);
+    }
+    
+    /**
+     * Tracks a compaction scheduler so {@link #close()} stops it before the column families
+     * it compacts are released.
+     */
+    void registerScheduler(CompactionScheduler scheduler) {
+        checkNotClosed();
+        schedulers.add(scheduler);
+    }
+    
+    void forgetScheduler(CompactionScheduler scheduler) {
+        schedulers.remove(scheduler);
+    }
+    
+    /**
+     * Creates a loader that writes pre-sorted data in 4MB write-batch chunks; see
+     * {@link BulkLoader}.
+     *
+     * @param cf the column family to load
+     * @return a new bulk loader
+     * @throws TidesDBException if the column family configuration cannot be read
+     */
+    public BulkLoader newBulkLoader(ColumnFamily cf) throws TidesDBException {
+        return newBulkLoader(cf, BulkLoader.DEFAULT_CHUNK_BYTES);
+    }
+    
+    /**
+     * Creates a loader that writes pre-sorted data in write-batch chunks; see
+     * {@link BulkLoader}.
+     *
+     * @param cf the column family to load
+     * @param chunkBytes serialized size at which a chunk is committed
+     * @return a new bulk loader
+     * @throws TidesDBException if the column family configuration cannot be read
+     */
+    public BulkLoader newBulkLoader(ColumnFamily cf, int chunkBytes) throws TidesDBException {
+        checkNotClosed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (chunkBytes <= 0) {
+            throw new IllegalArgumentException("Chunk size must be positive");
+        }
+        return new BulkLoader(this, cf, chunkBytes);
+    }
+    
+    /**
+     * Deletes every key in {@code [startKey, endKey)}, committing every
+     * {@value #DELETE_RANGE_CHUNK} keys so memory stays bounded however large the range is.
+     * Unlike {@link Transaction#deleteRange} this is not atomic: if a chunk fails, the
+     * chunks before it stay deleted, and readers can see the range partly deleted while it
+     * runs. Rerunning the call after a failure finishes the job.
+     *
+     * <p>Follow with {@link ColumnFamily#compactRange(byte[], byte[])} over the same range to
+     * drop the covered data and tombstones in one merge.</p>
+     *
+     * @param cf the column family
+     * @param startKey inclusive start key, or null for the first key
+     * @param endKey exclusive end key, or null for no upper bound
+     * @return the number of keys deleted
+     * @throws TidesDBException if a delete or commit fails
+     */
+    public long deleteRange(ColumnFamily cf, byte[] startKey, byte[] endKey)
+        throws TidesDBException {
+        checkNotClosed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        long total = 0;
+        byte[][] lastKey = new byte[1][];
+        byte[] from = startKey;
+        while (true) {
+            long deleted;
+            try (Transaction txn = beginTransaction()) {
+                deleted = txn.deleteRange(cf, from, endKey, DELETE_RANGE_CHUNK, lastKey);
+                if (deleted > 0) {
+                    txn.commit();
+                }
+            }
+            total += deleted;
+            if (deleted < DELETE_RANGE_CHUNK) {
+                return total;
+            }
+            // the last key is deleted now, so starting from it resumes right after it
+            from = lastKey[0];
+        }
+    }
+    
+    /**
+     * Scans [start, end) of a column family with several threads. The range is split with
+     * {@link ColumnFamily#splitRange} and every sub-range is read by its own bounded iterator
+     * on its own thread. A transaction and its iterators are not safe to read from several
+     * threads at once, so each sub-range gets its own snapshot-isolation transaction. They are
+     * all begun back to back before any reading starts: every sub-range is a consistent view on
+     * its own, but a write committed while they are being begun may be visible in some
+     * sub-ranges and not in others. Run the scan while writes to the range are quiesced if
+     * the sub-ranges must agree.
+     *
+     * <p>The consumer is called concurrently from the scan threads; within one sub-range keys
+     * arrive in order. If the consumer or an iterator fails, the remaining sub-ranges stop
+     * early and the first failure is rethrown.
+     *
+     * @param cf the column family to scan
+     * @param start inclusive start of the range
+     * @param end exclusive end of the range
+     * @param parallelism the number of sub-ranges and threads
+     * @param consumer receives every key and value in the range
+     * @return the number of entries scanned
+     * @throws TidesDBException if the split, the transaction or an iterator fails
+     */
+    public long parallelScan(ColumnFamily cf, byte[] start, byte[] end, int parallelism,
+                             BiConsumer<byte[], byte[]> consumer) throws TidesDBException {
+        checkNotClosed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (consumer == null) {
+            throw new IllegalArgumentException("Consumer cannot be null");
+        }
+        List<byte[]> bounds = cf.splitRange(start, end, parallelism);
+        int partitions = bounds.size() - 1;
+        
+        AtomicBoolean cancelled = new AtomicBoolean();
+        ExecutorService workers = Executors.newFixedThreadPool(partitions, r -> {
+            Thread t = new Thread(r, "tidesdb-scan");
+            t.setDaemon(true);
+            return t;
+        });
+        List<Transaction> txns = new ArrayList<>(partitions);
+        try {
+            for (int i = 0; i < partitions; i++) {
+                txns.add(beginTransaction(IsolationLevel.SNAPSHOT));
+            }
+            // each transaction and its iterator are then used only by their worker
+            List<Future<Long>> futures = new ArrayList<>(partitions);
+            for (int i = 0; i < partitions; i++) {
+                Transaction txn = txns.get(i);
+                byte[] lower = bounds.get(i);
+                byte[] upper = bounds.get(i + 1);
+                futures.add(workers.submit(() -> {
+                    long scanned = 0;
+                    try (TidesDBIterator iter = txn.newIterator(cf, lower, upper)) {
+                        for (iter.seekToFirst(); iter.isValid() && !cancelled.get(); iter.next()) {
+                            consumer.accept(iter.key(), iter.value());
+                            scanned++;
+                        }
+                    }
+                    return scanned;
+                }));
+            }
+            return awaitScan(futures, cancelled);
+        } finally {
+            for (Transaction txn : txns) {
+                txn.close();
+            }
+            workers.shutdown();
+        }
+    }
+    
+    /**
+     * Waits for every partition, even after a failure, since the transactions are freed as
+     * soon as this returns.
+     */
+    private static long awaitScan(List<Future<Long>> futures, AtomicBoolean cancelled)
+            throws TidesDBException {
+        long total = 0;
+        Throwable failure = null;
+        boolean interrupted = false;
+        for (Future<Long> future : futures) {
+            while (true) {
+                try {
+                    total += future.get();
+                    break;
+                } catch (InterruptedException e) {
+                    interrupted = true;
+                    cancelled.set(true);
+                } catch (ExecutionException e) {
+                    cancelled.set(true);
+                    if (failure == null) {
+                        failure = e.getCause();
+                    }
+                    break;
+                }
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+        if (failure instanceof TidesDBException) {
+            throw (TidesDBException) failure;
+        }
+        if (failure instanceof RuntimeException) {
+            throw (RuntimeException) failure;
+        }
+        if (failure instanceof Error) {
+            throw (Error) failure;
+        }
+        if (interrupted) {
+            throw new IllegalStateException("Parallel scan was interrupted");
+        }
+        return total;
     }
     
     /**
@@ -230,6 +603,20 @@ public class TidesDB implements Closeable {
         return nativeGetCacheStats(nativeHandle);
     }
     
+    /**
+     * Writes the {@code Metrics.DB_*} slots, including block cache counters, into {@code out}
+     * starting at its position, without allocating.
+     *
+     * @param out a buffer from {@link Metrics#allocate(int)} with at least
+     *            {@link Metrics#DB_SLOTS} remaining slots
+     * @throws TidesDBException if the stats cannot be retrieved
+     */
+    public void fillMetrics(LongBuffer out) throws TidesDBException {
+        checkNotClosed();
+        Metrics.check(out, Metrics.DB_SLOTS);
+        nativeFillMetrics(nativeHandle, out, out.position());
+    }
+    
     /**
      * Registers a custom comparator with the database.
      *
@@ -257,6 +644,37 @@ public class TidesDB implements Closeable {
             throw new IllegalArgumentException("Backup directory cannot be null or empty");
         }
         nativeBackup(nativeHandle, dir);
+        copyValueDictionaries(Paths.get(dir));
+    }
+    
+    /**
+     * Creates an on-disk snapshot of the database on the asynchronous worker pool.
+     * The returned future completes once the backup has been written.
+     *
+     * @param dir the backup directory (must be non-existent or empty)
+     * @return a future completed when the backup finishes, or exceptionally with a
+     *         {@link TidesDBException} if it fails
+     */
+    public CompletableFuture<Void> backupAsync(String dir) {
+        checkNotClosed();
+        if (dir == null || dir.isEmpty()) {
+            throw new IllegalArgumentException("Backup directory cannot be null or empty");
+        }
+        AsyncPool pool;
+        try {
+            pool = asyncPool();
+        } catch (TidesDBException e) {
+            CompletableFuture<Void> failed = new CompletableFuture<>();
+            failed.completeExceptionally(e);
+            return failed;
+        }
+        return pool.backup(nativeHandle, dir).thenRun(() -> {
+            try {
+                copyValueDictionaries(Paths.get(dir));
+            } catch (TidesDBException e) {
+                throw new CompletionException(e);
+            }
+        });
     }
     
     /**
@@ -272,6 +690,50 @@ public class TidesDB implements Closeable {
             throw new IllegalArgumentException("Checkpoint directory cannot be null or empty");
         }
         nativeCheckpoint(nativeHandle, dir);
+        copyValueDictionaries(Paths.get(dir));
+    }
+    
+    /**
+     * Backs up the database with per-file progress, parallel copies and an optional
+     * bandwidth cap. A checkpoint is taken next to the database directory, so it can hard-link
+     * SSTables, and is then copied into {@code dir}. With {@link BackupOptions.Builder#since}
+     * set, files unchanged since that backup are hard-linked from it instead of copied.
+     * Reads and writes continue while the files are copied.
+     *
+     * @param dir the backup directory (must be non-existent or empty)
+     * @param options parallelism, bandwidth cap, progress listener and base backup
+     * @return counts of copied and linked files
+     * @throws TidesDBException if the checkpoint or a copy fails
+     */
+    public BackupResult backup(String dir, BackupOptions options) throws TidesDBException {
+        checkNotClosed();
+        if (dir == null || dir.isEmpty()) {
+            throw new IllegalArgumentException("Backup directory cannot be null or empty");
+        }
+        if (options == null) {
+            throw new IllegalArgumentException("Backup options cannot be null");
+        }
+        Path db = Paths.get(dbPath).toAbsolutePath().normalize();
+        Path staging = db.resolveSibling(db.getFileName() + ".backup-" + System.nanoTime());
+        try {
+            nativeCheckpoint(nativeHandle, staging.toString());
+            copyValueDictionaries(staging);
+            return IncrementalBackup.run(staging, Paths.get(dir), options);
+        } finally {
+            try {
+                IncrementalBackup.deleteTree(staging);
+            } catch (IOException e) {
+                // a leftover checkpoint only costs disk space
+            }
+        }
+    }
+    
+    /**
+     * Value dictionaries live in binding files the engine does not copy; a checkpoint or
+     * backup without them would hold values no codec can decode.
+     */
+    private void copyValueDictionaries(Path target) throws TidesDBException {
+        ValueCodec.copyDictionaries(Paths.get(dbPath), target);
     }
     
     /**
@@ -291,6 +753,11 @@ public class TidesDB implements Closeable {
             throw new IllegalArgumentException("New column family name cannot be null or empty");
         }
         nativeRenameColumnFamily(nativeHandle, oldName, newName);
+        ColumnFamily cf = columnFamilies.remove(oldName);
+        if (cf != null) {
+            cf.setName(newName);
+            columnFamilies.put(newName, cf);
+        }
     }
     
     /**
@@ -311,6 +778,12 @@ public class TidesDB implements Closeable {
             throw new IllegalArgumentException("Destination column family name cannot be null or empty");
         }
         nativeCloneColumnFamily(nativeHandle, sourceName, destName);
+        try {
+            ValueCodec.copyColumnFamily(Paths.get(dbPath, sourceName), Paths.get(dbPath, destName));
+        } catch (IOException e) {
+            throw new TidesDBException("Failed to copy value dictionaries to " + destName + ": "
+                + e, TidesDBException.ERR_IO, e);
+        }
     }
     
     /**
@@ -338,9 +811,96 @@ public class TidesDB implements Closeable {
         if (cf == null) {
             throw new IllegalArgumentException("Column family cannot be null");
         }
-        nativeDeleteColumnFamily(nativeHandle, cf.getNativeHandle());
+        drop(cf.getName(), cf.getNativeHandle());
     }
 
+    /**
+     * Creates a reader for lag-bounded reads from this replica; see {@link ReplicaReader}.
+     * The replica's applied sequence is polled every 10ms while a read waits.
+     *
+     * @param primarySequence supplies the primary's latest global sequence
+     * @return a new replica reader
+     */
+    public ReplicaReader newReplicaReader(LongSupplier primarySequence) {
+        return newReplicaReader(primarySequence, ReplicaReader.DEFAULT_POLL_INTERVAL_MS);
+    }
+    
+    /**
+     * Creates a reader for lag-bounded reads from this replica with a custom poll interval.
+     *
+     * @param primarySequence supplies the primary's latest global sequence
+     * @param pollIntervalMs how often a waiting read re-checks the applied sequence
+     * @return a new replica reader
+     */
+    public ReplicaReader newReplicaReader(LongSupplier primarySequence, long pollIntervalMs) {
+        checkNotClosed();
+        if (primarySequence == null) {
+            throw new IllegalArgumentException("Primary sequence supplier cannot be null");
+        }
+        if (pollIntervalMs <= 0) {
+            throw new IllegalArgumentException("Poll interval must be positive");
+        }
+        return new ReplicaReader(this, primarySequence, pollIntervalMs);
+    }
+    
+    /**
+     * Starts reporting engine events to {@code listener}: memory pressure changes, write
+     * stall begin/end, and per column family flush and compaction begin/end with bytes and
+     * duration. The engine has no event callbacks, so a native monitor thread samples its
+     * state every {@code intervalMs} and only calls Java when something changed; events
+     * shorter than the interval can be missed. Replaces any previous listener.
+     *
+     * @param listener the listener
+     * @param intervalMs how often engine state is sampled
+     * @throws TidesDBException if the monitor cannot be started
+     */
+    public void setEventListener(EventListener listener, long intervalMs) throws TidesDBException {
+        checkNotClosed();
+        if (listener == null) {
+            throw new IllegalArgumentException("Listener cannot be null, use clearEventListener() instead");
+        }
+        if (intervalMs <= 0) {
+            throw new IllegalArgumentException("Interval must be positive");
+        }
+        long previous = 0;
+        try {
+            synchronized (this) {
+                checkNotClosed();
+                previous = detachEventMonitor();
+                eventMonitorHandle = nativeStartEventMonitor(nativeHandle, listener, intervalMs * 1000);
+            }
+        } finally {
+            nativeStopEventMonitor(previous);
+        }
+    }
+    
+    /**
+     * Stops the event monitor. Events already sampled are delivered first.
+     */
+    public void clearEventListener() {
+        long monitor;
+        synchronized (this) {
+            monitor = detachEventMonitor();
+        }
+        nativeStopEventMonitor(monitor);
+    }
+    
+    /**
+     * Takes the event monitor out of reach of {@link #drop} and pauses it, so it samples
+     * nothing more. The caller must hold this lock and stop the returned monitor after
+     * releasing it: stopping joins the monitor thread, and a listener that is calling back
+     * into this database may be waiting for the lock.
+     */
+    private long detachEventMonitor() {
+        long monitor = eventMonitorHandle;
+        if (monitor != 0) {
+            EventListeners.checkNotDelivering();
+            nativePauseEventMonitor(monitor, true);
+            eventMonitorHandle = 0;
+        }
+        return monitor;
+    }
+    
     /**
      * Switches a read-only replica database to primary mode.
      *
@@ -351,6 +911,74 @@ public class TidesDB implements Closeable {
         nativePromoteToPrimary(nativeHandle);
     }
 
+    /**
+     * Snapshots the native latency histograms. They are process-wide, cumulative since the
+     * library was loaded, and only record while tracking is on (see
+     * {@link Config.Builder#latencyTracking(boolean)}).
+     *
+     * @return one histogram per operation
+     * @throws TidesDBException if the snapshot cannot be allocated
+     */
+    public Map<LatencyHistogram.Operation, LatencyHistogram> getLatencyHistograms() throws TidesDBException {
+        checkNotClosed();
+        long[] all = nativeLatencySnapshot();
+        Map<LatencyHistogram.Operation, LatencyHistogram> histograms = new EnumMap<>(LatencyHistogram.Operation.class);
+        for (LatencyHistogram.Operation op : LatencyHistogram.Operation.values()) {
+            int from = op.ordinal() * LatencyHistogram.BUCKETS;
+            histograms.put(op, new LatencyHistogram(op, Arrays.copyOfRange(all, from, from + LatencyHistogram.BUCKETS)));
+        }
+        return histograms;
+    }
+
+    /**
+     * Turns the process-wide latency histograms on or off, e.g. to sample latencies for a while
+     * without reopening. Opening or closing a database configured with
+     * {@link Config.Builder#latencyTracking(boolean)} sets tracking again, on while any such
+     * database is open. Counts already recorded are kept.
+     *
+     * @param enabled whether operations are timed
+     */
+    public static synchronized void setLatencyTracking(boolean enabled) {
+        latencyTrackingOn = enabled;
+        nativeSetLatencyTracking(enabled);
+    }
+    
+    /**
+     * Reports whether the process-wide latency histograms are currently recording.
+     *
+     * @return true if operations are timed
+     */
+    public static synchronized boolean isLatencyTracking() {
+        return latencyTrackingOn;
+    }
+    
+    private static synchronized void trackLatency(int delta) {
+        latencyTrackers += delta;
+        setLatencyTracking(latencyTrackers > 0);
+    }
+    
+    /**
+     * Gets the latency of gets against this database alone, cumulative since it was opened.
+     * Only databases opened with {@link Config.Builder#latencyTracking(boolean)} are counted
+     * separately, and only the first eight open at once; for any other database this falls
+     * back to the process-wide histogram.
+     */
+    LatencyHistogram dbGetLatency() throws TidesDBException {
+        if (latencySlot < 0) {
+            return getLatencyHistograms().get(LatencyHistogram.Operation.GET);
+        }
+        checkNotClosed();
+        return new LatencyHistogram(LatencyHistogram.Operation.GET,
+            nativeDbGetLatencySnapshot(latencySlot));
+    }
+    
+    /**
+     * Gets the latency slot this database's gets are recorded against, or -1 if none.
+     */
+    int latencySlot() {
+        return latencySlot;
+    }
+
     /**
      * Retrieves aggregate statistics across the entire database instance.
      *
@@ -362,6 +990,18 @@ public class TidesDB implements Closeable {
         return nativeGetDbStats(nativeHandle);
     }
     
+    /**
+     * Returns how many transactions and iterators were garbage collected without being
+     * closed, across all databases in this process. Each one is also logged as a warning
+     * to the {@code com.tidesdb} logger; run with {@code -Dtidesdb.trackLeaks=true} to
+     * include where it was created.
+     *
+     * @return the number of leaked native handles freed by the cleaner
+     */
+    public static long getLeakedHandleCount() {
+        return NativeResource.leakedCount();
+    }
+    
     private void checkNotClosed() {
         if (closed) {
             throw new IllegalStateException("TidesDB instance is closed");
@@ -371,6 +1011,31 @@ public class TidesDB implements Closeable {
     long getNativeHandle() {
         return nativeHandle;
     }
+
+    /**
+     * Returns the registry of transactions and iterators freed when the database closes.
+     */
+    NativeResource.Registry resources() {
+        return resources;
+    }
+    
+    /**
+     * Returns the group commit coordinator, or null when group commit is disabled.
+     */
+    GroupCommitter groupCommitter() {
+        return groupCommitter;
+    }
+
+    /**
+     * Returns the asynchronous worker pool, starting it on first use.
+     */
+    synchronized AsyncPool asyncPool() throws TidesDBException {
+        checkNotClosed();
+        if (asyncPool == null) {
+            asyncPool = new AsyncPool(asyncThreads, asyncQueueCapacity);
+        }
+        return asyncPool;
+    }
     
     private static native long nativeOpen(String dbPath, int numFlushThreads, int numCompactionThreads,
                                           int logLevel, long blockCacheSize, long maxOpenSSTables,
@@ -382,6 +1047,9 @@ public class TidesDB implements Closeable {
                                           int unifiedMemtableSyncMode,
                                           long unifiedMemtableSyncIntervalUs,
                                           String objectStoreFsPath,
+                                          String s3Endpoint, String s3Bucket, String s3Prefix,
+                                          String s3AccessKey, String s3SecretKey, String s3Region,
+                                          boolean s3UseSsl, boolean s3UsePathStyle,
                                           String oscLocalCachePath, long oscLocalCacheMaxBytes,
                                           boolean oscCacheOnRead, boolean oscCacheOnWrite,
                                           int oscMaxConcurrentUploads, int oscMaxConcurrentDownloads,
@@ -419,6 +1087,12 @@ public class TidesDB implements Closeable {
     
     private static native CacheStats nativeGetCacheStats(long handle) throws TidesDBException;
     
+    private static native void nativeFillMetrics(long handle, LongBuffer out, int offset) throws TidesDBException;
+    private static native void nativeSetLatencyTracking(boolean enabled);
+    private static native long[] nativeLatencySnapshot() throws TidesDBException;
+    private static native int nativeAcquireLatencySlot();
+    private static native void nativeReleaseLatencySlot(int slot);
+    private static native long[] nativeDbGetLatencySnapshot(int slot);
     private static native void nativeRegisterComparator(long handle, String name, String context) throws TidesDBException;
     
     private static native void nativeBackup(long handle, String dir) throws TidesDBException;
@@ -436,4 +1110,10 @@ public class TidesDB implements Closeable {
     private static native void nativeDeleteColumnFamily(long handle, long cfHandle) throws TidesDBException;
 
     private static native void nativePromoteToPrimary(long handle) throws TidesDBException;
+
+    private static native long nativeStartEventMonitor(long handle, EventListener listener, long intervalUs) throws TidesDBException;
+
+    private static native void nativeStopEventMonitor(long monitorHandle);
+
+    private static native void nativePauseEventMonitor(long monitorHandle, boolean paused);
 }
@@ -19,6 +19,8 @@
 package com.tidesdb;
 
 import java.io.Closeable;
+import java.nio.ByteBuffer;
+import java.util.UUID;
 
 /**
  * Iterator for traversing key-value pairs in a column family.
@@ -32,9 +34,12 @@ public class TidesDBIterator implements Closeable {
     
     private long nativeHandle;
     private boolean freed = false;
+    private final NativeResource resource;
     
-    TidesDBIterator(long nativeHandle) {
+    TidesDBIterator(long nativeHandle, Transaction txn) {
         this.nativeHandle = nativeHandle;
+        this.resource = NativeResource.register(this, "Iterator", nativeHandle, TidesDBIterator::nativeFree,
+            txn.resource(), txn.db().resources());
     }
     
     /**
@@ -85,13 +90,94 @@ public class TidesDBIterator implements Closeable {
         nativeSeekForPrev(nativeHandle, key);
     }
     
+    /**
+     * Positions the iterator at the first key >= the 8-byte big-endian encoding of
+     * {@code key}, without allocating a key array.
+     *
+     * @param key the target key
+     * @throws TidesDBException if the seek fails
+     */
+    public void seek(long key) throws TidesDBException {
+        checkNotFreed();
+        nativeSeekLong(nativeHandle, key, false);
+    }
+    
+    /**
+     * Positions the iterator at the last key <= the 8-byte big-endian encoding of
+     * {@code key}, without allocating a key array.
+     *
+     * @param key the target key
+     * @throws TidesDBException if the seek fails
+     */
+    public void seekForPrev(long key) throws TidesDBException {
+        checkNotFreed();
+        nativeSeekLong(nativeHandle, key, true);
+    }
+    
+    /**
+     * Positions the iterator at the first key >= the 16-byte encoding of {@code key} used
+     * by {@link Transaction#put(ColumnFamily, UUID, byte[], long)}.
+     *
+     * @param key the target key
+     * @throws TidesDBException if the seek fails
+     */
+    public void seek(UUID key) throws TidesDBException {
+        checkNotFreed();
+        if (key == null) {
+            throw new IllegalArgumentException("Key cannot be null");
+        }
+        nativeSeekUuid(nativeHandle, key.getMostSignificantBits(), key.getLeastSignificantBits(), false);
+    }
+    
+    /**
+     * Positions the iterator at the last key <= the 16-byte encoding of {@code key}.
+     *
+     * @param key the target key
+     * @throws TidesDBException if the seek fails
+     */
+    public void seekForPrev(UUID key) throws TidesDBException {
+        checkNotFreed();
+        if (key == null) {
+            throw new IllegalArgumentException("Key cannot be null");
+        }
+        nativeSeekUuid(nativeHandle, key.getMostSignificantBits(), key.getLeastSignificantBits(), true);
+    }
+    
+    /**
+     * Positions the iterator at the first key >= target key, reading the target
+     * directly from off-heap memory. The bytes between the buffer's position and limit
+     * are used; its position and limit are not modified.
+     *
+     * @param key the target key (must be a direct buffer)
+     * @throws TidesDBException if the seek fails
+     */
+    public void seek(ByteBuffer key) throws TidesDBException {
+        checkNotFreed();
+        Buffers.checkDirectKey(key);
+        nativeSeekDirect(nativeHandle, key, key.position(), key.remaining());
+    }
+
+    /**
+     * Positions the iterator at the last key <= target key, reading the target
+     * directly from off-heap memory. The bytes between the buffer's position and limit
+     * are used; its position and limit are not modified.
+     *
+     * @param key the target key (must be a direct buffer)
+     * @throws TidesDBException if the seek fails
+     */
+    public void seekForPrev(ByteBuffer key) throws TidesDBException {
+        checkNotFreed();
+        Buffers.checkDirectKey(key);
+        nativeSeekForPrevDirect(nativeHandle, key, key.position(), key.remaining());
+    }
+
     /**
      * Returns true if the iterator is positioned at a valid entry.
      *
      * @return true if valid
      */
     public boolean isValid() {
-        if (freed) {
+        if (freed || resource.isFreed()) {
             return false;
         }
         return nativeValid(nativeHandle);
@@ -152,12 +238,43 @@ public class TidesDBIterator implements Closeable {
         return nativeKeyValue(nativeHandle);
     }
 
+    /**
+     * Copies entries starting at the current position into {@code out} and advances
+     * the iterator past each one copied, all in a single native call.
+     *
+     * <p>Entries are written starting at the buffer's position, each as a 4-byte
+     * big-endian key length, the key bytes, a 4-byte big-endian value length and the
+     * value bytes. The buffer's position and limit are not modified. Copying stops after
+     * {@code maxEntries} entries, when the next entry would exceed {@code maxBytes} or
+     * the buffer's remaining space, or when the iterator runs out of entries.</p>
+     *
+     * @param out direct buffer receiving the entries
+     * @param maxEntries maximum number of entries to copy
+     * @param maxBytes maximum number of bytes to write
+     * @return the number of entries written; 0 if the iterator is not valid; or, if not
+     *         even the current entry fits, the negated number of bytes it needs (the
+     *         iterator is then not advanced)
+     * @throws TidesDBException if reading or advancing the iterator fails
+     */
+    public int nextBatch(ByteBuffer out, int maxEntries, int maxBytes) throws TidesDBException {
+        checkNotFreed();
+        Buffers.checkDirect(out, "Output");
+        if (maxEntries <= 0) {
+            throw new IllegalArgumentException("Max entries must be positive");
+        }
+        if (maxBytes <= 0) {
+            throw new IllegalArgumentException("Max bytes must be positive");
+        }
+        return nativeNextBatch(nativeHandle, out, out.position(),
+            Math.min(out.remaining(), maxBytes), maxEntries);
+    }
+
     /**
      * Frees the iterator resources.
      */
     public void free() {
         if (!freed && nativeHandle != 0) {
-            nativeFree(nativeHandle);
+            resource.release();
             nativeHandle = 0;
             freed = true;
         }
@@ -172,7 +289,7 @@ public class TidesDBIterator implements Closeable {
     }
     
     private void checkNotFreed() {
-        if (freed) {
+        if (freed || resource.isFreed()) {
             throw new IllegalStateException("Iterator has been freed");
         }
     }
@@ -180,12 +297,18 @@ public class TidesDBIterator implements Closeable {
     private static native void nativeSeekToFirst(long handle) throws TidesDBException;
     private static native void nativeSeekToLast(long handle) throws TidesDBException;
     private static native void nativeSeek(long handle, byte[] key) throws TidesDBException;
+    private static native void nativeSeekLong(long handle, long key, boolean forPrev) throws TidesDBException;
+    private static native void nativeSeekUuid(long handle, long msb, long lsb, boolean forPrev)
+        throws TidesDBException;
     private static native void nativeSeekForPrev(long handle, byte[] key) throws TidesDBException;
+    private static native void nativeSeekDirect(long handle, ByteBuffer key, int keyOffset, int keyLength) throws TidesDBException;
+    private static native void nativeSeekForPrevDirect(long handle, ByteBuffer key, int keyOffset, int keyLength) throws TidesDBException;
     private static native boolean nativeValid(long handle);
     private static native void nativeNext(long handle) throws TidesDBException;
     private static native void nativePrev(long handle) throws TidesDBException;
     private static native byte[] nativeKey(long handle) throws TidesDBException;
     private static native byte[] nativeValue(long handle) throws TidesDBException;
     private static native KeyValue nativeKeyValue(long handle) throws TidesDBException;
+    private static native int nativeNextBatch(long handle, ByteBuffer out, int outOffset, int outLength, int maxEntries) throws TidesDBException;
     private static native void nativeFree(long handle);
 }
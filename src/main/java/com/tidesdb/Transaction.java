@@ -19,6 +19,17 @@
 package com.tidesdb;
 
 import java.io.Closeable;
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.Function;
 
 /**
  * Represents a transaction in TidesDB.
@@ -30,11 +41,31 @@ public class Transaction implements Closeable {
         NativeLibrary.load();
     }
     
+    /**
+     * Length written in place of a value in packed {@link #multiGet(ColumnFamily, ByteBuffer, int, ByteBuffer)}
+     * output when the key does not exist.
+     */
+    public static final int MULTI_GET_NOT_FOUND = -1;
+
     private long nativeHandle;
     private boolean freed = false;
+    private final TidesDB db;
+    private final AtomicInteger pendingAsync = new AtomicInteger();
+    private final GroupCommitter groupCommitter;
+    private final int latencySlot;
+    private final List<ColumnFamily> touched = new ArrayList<>();
+    private long lastTouchedCf = 0;
+    private TransactionPool pool;
+    private boolean readOnly = false;
+    private final NativeResource resource;
     
-    Transaction(long nativeHandle) {
+    Transaction(long nativeHandle, TidesDB db) {
         this.nativeHandle = nativeHandle;
+        this.resource = NativeResource.register(this, "Transaction", nativeHandle, Transaction::nativeFree,
+            null, db.resources());
+        this.db = db;
+        this.groupCommitter = db.groupCommitter();
+        this.latencySlot = db.latencySlot();
     }
     
     /**
@@ -57,7 +88,9 @@ public class Transaction implements Closeable {
         if (value == null) {
             throw new IllegalArgumentException("Value cannot be null");
         }
+        checkWritable();
         nativePut(nativeHandle, cf.getNativeHandle(), key, value, ttl);
+        touch(cf);
     }
     
     /**
@@ -72,6 +105,42 @@ public class Transaction implements Closeable {
         put(cf, key, value, -1);
     }
     
+    /**
+     * Adds a key-value pair to the transaction, reading key and value directly from
+     * off-heap memory. The bytes between each buffer's position and limit are used;
+     * buffer positions and limits are not modified.
+     *
+     * @param cf the column family
+     * @param key the key (must be a direct buffer)
+     * @param value the value (must be a direct buffer)
+     * @param ttl Unix timestamp (seconds since epoch) for expiration, or -1 for no expiration
+     * @throws TidesDBException if the put fails
+     */
+    public void put(ColumnFamily cf, ByteBuffer key, ByteBuffer value, long ttl) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        checkWritable();
+        Buffers.checkDirectKey(key);
+        Buffers.checkDirect(value, "Value");
+        nativePutDirect(nativeHandle, cf.getNativeHandle(), key, key.position(), key.remaining(),
+            value, value.position(), value.remaining(), ttl);
+        touch(cf);
+    }
+
+    /**
+     * Adds a key-value pair from direct buffers to the transaction with no expiration.
+     *
+     * @param cf the column family
+     * @param key the key (must be a direct buffer)
+     * @param value the value (must be a direct buffer)
+     * @throws TidesDBException if the put fails
+     */
+    public void put(ColumnFamily cf, ByteBuffer key, ByteBuffer value) throws TidesDBException {
+        put(cf, key, value, -1);
+    }
+
     /**
      * Retrieves a value from the transaction.
      *
@@ -88,9 +157,348 @@ public class Transaction implements Closeable {
         if (key == null || key.length == 0) {
             throw new IllegalArgumentException("Key cannot be null or empty");
         }
-        return nativeGet(nativeHandle, cf.getNativeHandle(), key);
+        return nativeGet(nativeHandle, cf.getNativeHandle(), key, latencySlot);
+    }
+
+    /**
+     * Retrieves a value into a caller-supplied array instead of allocating a new one.
+     * If the value does not fit in {@code dst.length - off} bytes nothing is written
+     * and the negated value length is returned, so the caller can retry with a larger
+     * array.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param dst destination array
+     * @param off offset in {@code dst} at which to write the value
+     * @return the value length if it was written, or {@code -length} if {@code dst} is too small
+     * @throws TidesDBException if the get fails (including when the key is not found)
+     */
+    public int get(ColumnFamily cf, byte[] key, byte[] dst, int off) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null || key.length == 0) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (dst == null) {
+            throw new IllegalArgumentException("Destination cannot be null");
+        }
+        if (off < 0 || off > dst.length) {
+            throw new IndexOutOfBoundsException("Offset " + off + " out of bounds for length " + dst.length);
+        }
+        return nativeGetInto(nativeHandle, cf.getNativeHandle(), key, dst, off, dst.length - off,
+            latencySlot);
+    }
+
+    /**
+     * Retrieves a value into a caller-supplied buffer instead of allocating a new array.
+     * The value is written starting at {@code dst.position()}; the buffer's position and
+     * limit are not modified. If the value does not fit in {@code dst.remaining()} bytes
+     * nothing is written and the negated value length is returned.
+     *
+     * <p>Direct buffers are filled with a single native copy. Heap buffers are filled
+     * through their backing array.</p>
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param dst destination buffer
+     * @return the value length if it was written, or {@code -length} if {@code dst} is too small
+     * @throws TidesDBException if the get fails (including when the key is not found)
+     */
+    public int get(ColumnFamily cf, byte[] key, ByteBuffer dst) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null || key.length == 0) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (dst == null) {
+            throw new IllegalArgumentException("Destination cannot be null");
+        }
+        if (dst.isReadOnly()) {
+            throw new ReadOnlyBufferException();
+        }
+        if (dst.isDirect()) {
+            return nativeGetIntoDirect(nativeHandle, cf.getNativeHandle(), key,
+                dst, dst.position(), dst.remaining(), latencySlot);
+        }
+        return nativeGetInto(nativeHandle, cf.getNativeHandle(), key,
+            dst.array(), dst.arrayOffset() + dst.position(), dst.remaining(), latencySlot);
+    }
+
+    /**
+     * Retrieves a value from the transaction using a key held in off-heap memory.
+     * The bytes between the key buffer's position and limit are used; its position
+     * and limit are not modified.
+     *
+     * @param cf the column family
+     * @param key the key (must be a direct buffer)
+     * @return the value
+     * @throws TidesDBException if the get fails
+     */
+    public byte[] get(ColumnFamily cf, ByteBuffer key) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        Buffers.checkDirectKey(key);
+        return nativeGetDirect(nativeHandle, cf.getNativeHandle(), key, key.position(), key.remaining(),
+            latencySlot);
     }
     
+    /**
+     * Retrieves several keys in one native call. The batch is resolved under this
+     * transaction's snapshot; keys are looked up in sorted order internally to keep
+     * block cache and SSTable access sequential, but results are returned in the
+     * order of {@code keys}.
+     *
+     * @param cf the column family
+     * @param keys the keys to look up
+     * @return an array parallel to {@code keys}; entries for missing keys are null
+     * @throws TidesDBException if any lookup fails for a reason other than the key not existing
+     */
+    public byte[][] multiGet(ColumnFamily cf, byte[][] keys) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (keys == null) {
+            throw new IllegalArgumentException("Keys cannot be null");
+        }
+        for (byte[] key : keys) {
+            if (key == null || key.length == 0) {
+                throw new IllegalArgumentException("Key cannot be null or empty");
+            }
+        }
+        return nativeMultiGet(nativeHandle, cf.getNativeHandle(), keys, latencySlot);
+    }
+
+    /**
+     * Adds a value under an 8-byte key. The key is encoded big-endian on the native
+     * stack, so no key array is allocated or pinned; it equals
+     * {@link Comparators#int64Key(long)} and sorts as an unsigned integer in bytewise and
+     * {@link Comparators#UINT64_BE} column families, or signed under {@link Comparators#INT64_BE}.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param value the value
+     * @param ttl Unix timestamp (seconds since epoch) for expiration, or -1 for no expiration
+     * @throws TidesDBException if the put fails
+     */
+    public void put(ColumnFamily cf, long key, byte[] value, long ttl) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        checkWritable();
+        nativePutLong(nativeHandle, cf.getNativeHandle(), key, value, ttl);
+        touch(cf);
+    }
+
+    public void put(ColumnFamily cf, long key, byte[] value) throws TidesDBException {
+        put(cf, key, value, -1);
+    }
+
+    /**
+     * Retrieves the value of an 8-byte key written by {@link #put(ColumnFamily, long, byte[], long)}
+     * or as {@link Comparators#int64Key(long)}.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return the value
+     * @throws TidesDBException if the get fails (including when the key is not found)
+     */
+    public byte[] get(ColumnFamily cf, long key) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        return nativeGetLong(nativeHandle, cf.getNativeHandle(), key, latencySlot);
+    }
+
+    public void delete(ColumnFamily cf, long key) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        checkWritable();
+        nativeDeleteLong(nativeHandle, cf.getNativeHandle(), key);
+        touch(cf);
+    }
+
+    /**
+     * Retrieves several 8-byte keys in one native call, like {@link #multiGet(ColumnFamily, byte[][])}
+     * but without a key array per lookup.
+     *
+     * @param cf the column family
+     * @param keys the keys to look up
+     * @return an array parallel to {@code keys}; entries for missing keys are null
+     * @throws TidesDBException if any lookup fails for a reason other than the key not existing
+     */
+    public byte[][] multiGet(ColumnFamily cf, long[] keys) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (keys == null) {
+            throw new IllegalArgumentException("Keys cannot be null");
+        }
+        return nativeMultiGetLongs(nativeHandle, cf.getNativeHandle(), keys, latencySlot);
+    }
+
+    /**
+     * Adds a value under a 16-byte UUID key: the most significant half followed by the
+     * least significant half, each big-endian, encoded on the native stack.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param value the value
+     * @param ttl Unix timestamp (seconds since epoch) for expiration, or -1 for no expiration
+     * @throws TidesDBException if the put fails
+     */
+    public void put(ColumnFamily cf, UUID key, byte[] value, long ttl) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null) {
+            throw new IllegalArgumentException("Key cannot be null");
+        }
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        checkWritable();
+        nativePutUuid(nativeHandle, cf.getNativeHandle(), key.getMostSignificantBits(),
+            key.getLeastSignificantBits(), value, ttl);
+        touch(cf);
+    }
+
+    public void put(ColumnFamily cf, UUID key, byte[] value) throws TidesDBException {
+        put(cf, key, value, -1);
+    }
+
+    /**
+     * Retrieves the value of a UUID key written by {@link #put(ColumnFamily, UUID, byte[], long)}.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return the value
+     * @throws TidesDBException if the get fails (including when the key is not found)
+     */
+    public byte[] get(ColumnFamily cf, UUID key) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null) {
+            throw new IllegalArgumentException("Key cannot be null");
+        }
+        return nativeGetUuid(nativeHandle, cf.getNativeHandle(), key.getMostSignificantBits(),
+            key.getLeastSignificantBits(), latencySlot);
+    }
+
+    public void delete(ColumnFamily cf, UUID key) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null) {
+            throw new IllegalArgumentException("Key cannot be null");
+        }
+        checkWritable();
+        nativeDeleteUuid(nativeHandle, cf.getNativeHandle(), key.getMostSignificantBits(),
+            key.getLeastSignificantBits());
+        touch(cf);
+    }
+
+    /**
+     * Retrieves several keys in one native call using packed off-heap buffers.
+     *
+     * <p>{@code keys} holds {@code count} entries between its position and limit, each
+     * encoded as a 4-byte big-endian length followed by the key bytes. Results are
+     * written to {@code out} starting at its position, in request order, each as a
+     * 4-byte big-endian length followed by the value bytes; a length of
+     * {@link #MULTI_GET_NOT_FOUND} marks a missing key and is followed by no bytes.
+     * Buffer positions and limits are not modified.</p>
+     *
+     * <p>If {@code out} fills up, the results that fit are written and their number is
+     * returned. The caller can re-issue the remaining keys with a fresh buffer.</p>
+     *
+     * @param cf the column family
+     * @param keys direct buffer of length-prefixed keys
+     * @param count number of keys in {@code keys}
+     * @param out direct buffer receiving length-prefixed values
+     * @return the number of results written to {@code out}
+     * @throws TidesDBException if the key buffer is malformed or a lookup fails
+     */
+    public int multiGet(ColumnFamily cf, ByteBuffer keys, int count, ByteBuffer out) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        Buffers.checkDirect(keys, "Keys");
+        Buffers.checkDirect(out, "Output");
+        if (count < 0) {
+            throw new IllegalArgumentException("Count cannot be negative");
+        }
+        return nativeMultiGetPacked(nativeHandle, cf.getNativeHandle(),
+            keys, keys.position(), keys.remaining(), count,
+            out, out.position(), out.remaining(), latencySlot);
+    }
+
+    /**
+     * Retrieves a value on the database's asynchronous worker pool instead of the calling
+     * thread. The transaction must not be used from other threads, committed or freed
+     * until the returned future completes.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return a future completed with the value, or exceptionally with a
+     *         {@link TidesDBException} (for example when the key is not found)
+     */
+    public CompletableFuture<byte[]> getAsync(ColumnFamily cf, byte[] key) {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null || key.length == 0) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        long cfHandle = cf.getNativeHandle();
+        return submitAsync(pool -> pool.get(nativeHandle, cfHandle, key, latencySlot));
+    }
+
+    /**
+     * Retrieves several keys on the database's asynchronous worker pool. Same semantics
+     * as {@link #multiGet(ColumnFamily, byte[][])}; the same threading rules as
+     * {@link #getAsync(ColumnFamily, byte[])} apply.
+     *
+     * @param cf the column family
+     * @param keys the keys to look up
+     * @return a future completed with one value per key (null when not found)
+     */
+    public CompletableFuture<byte[][]> multiGetAsync(ColumnFamily cf, byte[][] keys) {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (keys == null) {
+            throw new IllegalArgumentException("Keys cannot be null");
+        }
+        for (byte[] key : keys) {
+            if (key == null || key.length == 0) {
+                throw new IllegalArgumentException("Key cannot be null or empty");
+            }
+        }
+        long cfHandle = cf.getNativeHandle();
+        return submitAsync(pool -> pool.multiGet(nativeHandle, cfHandle, keys, latencySlot));
+    }
+
     /**
      * Removes a key-value pair from the transaction.
      *
@@ -106,7 +514,57 @@ public class Transaction implements Closeable {
         if (key == null || key.length == 0) {
             throw new IllegalArgumentException("Key cannot be null");
         }
+        checkWritable();
         nativeDelete(nativeHandle, cf.getNativeHandle(), key);
+        touch(cf);
+    }
+
+    /**
+     * Deletes every key in {@code [startKey, endKey)} in a single native call. The keys are
+     * found and tombstoned inside the native layer, in batches, so no key crosses into Java.
+     * A {@code null} or empty endpoint means unbounded on that side.
+     *
+     * <p>The range covers the keys visible to this transaction; keys another transaction
+     * commits into it afterwards are not affected. Bounds are compared in the column
+     * family's key order, with the same comparator support as
+     * {@link #newIterator(ColumnFamily, byte[], byte[])}.</p>
+     *
+     * <p>The engine has no range tombstone, so each key gets its own tombstone, buffered in
+     * this transaction until commit: memory grows with the number of keys in the range.
+     * For ranges of more than a few hundred thousand keys use
+     * {@link TidesDB#deleteRange(ColumnFamily, byte[], byte[])}, which commits in chunks.
+     * Either way, {@link ColumnFamily#compactRange(byte[], byte[])} over the same range after
+     * commit drops the covered data and tombstones in one merge.</p>
+     *
+     * @param cf the column family
+     * @param startKey inclusive start key, or null for the first key
+     * @param endKey exclusive end key, or null for no upper bound
+     * @return the number of keys deleted
+     * @throws TidesDBException if a delete fails; keys already deleted stay in the
+     *         transaction until it is rolled back
+     */
+    public long deleteRange(ColumnFamily cf, byte[] startKey, byte[] endKey)
+        throws TidesDBException {
+        return deleteRange(cf, startKey, endKey, Long.MAX_VALUE, null);
+    }
+
+    /**
+     * Deletes up to {@code limit} keys of the range, storing the last one deleted in
+     * {@code lastKey[0]} when given.
+     */
+    long deleteRange(ColumnFamily cf, byte[] startKey, byte[] endKey, long limit,
+        byte[][] lastKey) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        checkWritable();
+        long deleted = nativeDeleteRange(nativeHandle, cf.getNativeHandle(),
+            emptyToNull(startKey), emptyToNull(endKey), cf.comparatorName(), limit, lastKey);
+        if (deleted > 0) {
+            touch(cf);
+        }
+        return deleted;
     }
 
     /**
@@ -132,19 +590,85 @@ public class Transaction implements Closeable {
         if (key == null || key.length == 0) {
             throw new IllegalArgumentException("Key cannot be null");
         }
+        checkWritable();
         nativeSingleDelete(nativeHandle, cf.getNativeHandle(), key);
+        touch(cf);
+    }
+
+    /**
+     * Applies every operation in a write batch to this transaction in a single native call.
+     * If an operation fails, the ones before it remain staged in the transaction; roll
+     * back to discard them.
+     *
+     * @param batch the batch to apply
+     * @throws TidesDBException if any operation fails
+     */
+    public void write(WriteBatch batch) throws TidesDBException {
+        checkNotFreed();
+        if (batch == null) {
+            throw new IllegalArgumentException("Batch cannot be null");
+        }
+        checkWritable();
+        nativeWriteBatch(nativeHandle, batch.buffer(), batch.sizeInBytes(), batch.count(), false);
+        touchAll(batch);
     }
 
     /**
-     * Commits the transaction.
+     * Applies a write batch and commits the transaction within the same native call.
+     *
+     * @param batch the batch to apply
+     * @throws TidesDBException if any operation or the commit fails
+     */
+    public void writeAndCommit(WriteBatch batch) throws TidesDBException {
+        checkNotFreed();
+        if (batch == null) {
+            throw new IllegalArgumentException("Batch cannot be null");
+        }
+        checkWritable();
+        touchAll(batch);
+        List<ColumnFamily> cfs = takeTouched();
+        nativeWriteBatch(nativeHandle, batch.buffer(), batch.sizeInBytes(), batch.count(), true);
+        awaitGroupCommit(cfs);
+    }
+
+    /**
+     * Commits the transaction. When group commit is enabled in {@link Config}, returns once
+     * the WAL sync shared with concurrent commits has completed.
      *
      * @throws TidesDBException if the commit fails
      */
     public void commit() throws TidesDBException {
         checkNotFreed();
+        // taken first so a failed commit does not leave its column families behind
+        List<ColumnFamily> cfs = takeTouched();
         nativeCommit(nativeHandle);
+        awaitGroupCommit(cfs);
     }
     
+    /**
+     * Commits the transaction on the database's asynchronous worker pool, keeping the
+     * write-ahead log sync of durable column families off the calling thread. The
+     * transaction must not be used until the returned future completes.
+     *
+     * @return a future completed when the commit is durable per the column families'
+     *         sync mode, or exceptionally with a {@link TidesDBException}
+     */
+    public CompletableFuture<Void> commitAsync() {
+        checkNotFreed();
+        List<ColumnFamily> cfs = takeTouched();
+        CompletableFuture<Void> commit = submitAsync(pool -> pool.commit(nativeHandle));
+        if (groupCommitter == null) {
+            return commit;
+        }
+        return commit.thenRun(() -> {
+            try {
+                groupCommitter.awaitDurable(cfs);
+            } catch (TidesDBException e) {
+                throw new CompletionException(e);
+            }
+        });
+    }
+
     /**
      * Rolls back the transaction.
      *
@@ -152,6 +676,7 @@ public class Transaction implements Closeable {
      */
     public void rollback() throws TidesDBException {
         checkNotFreed();
+        takeTouched();
         nativeRollback(nativeHandle);
     }
     
@@ -210,7 +735,86 @@ public class Transaction implements Closeable {
             throw new IllegalArgumentException("Column family cannot be null");
         }
         long iterHandle = nativeNewIterator(nativeHandle, cf.getNativeHandle());
-        return new TidesDBIterator(iterHandle);
+        return new TidesDBIterator(iterHandle, this);
+    }
+
+    /**
+     * Creates an iterator restricted to keys in {@code [lowerBound, upperBound)}.
+     * The bounds are enforced natively: seeks are clamped to the range, and the iterator
+     * becomes invalid as soon as it moves past either bound, so no key outside the range
+     * is ever copied into Java. Seeking to the first key starts at the lower bound, which
+     * lets the engine skip SSTables and blocks before the range via its block index.
+     *
+     * <p>Bounds are compared in the column family's key order, which the binding knows for
+     * the default comparator and those in {@link Comparators}. Bounds on a column family
+     * using a comparator registered by name are rejected; use
+     * {@link #newIterator(ColumnFamily)} there.</p>
+     *
+     * @param cf the column family
+     * @param lowerBound inclusive lower bound, or null for unbounded
+     * @param upperBound exclusive upper bound, or null for unbounded
+     * @return a new iterator
+     * @throws TidesDBException if the iterator cannot be created
+     */
+    public TidesDBIterator newIterator(ColumnFamily cf, byte[] lowerBound, byte[] upperBound) throws TidesDBException {
+        checkNotFreed();
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        byte[] lower = emptyToNull(lowerBound);
+        byte[] upper = emptyToNull(upperBound);
+        String comparator = lower != null || upper != null ? cf.comparatorName() : null;
+        long iterHandle = nativeNewBoundedIterator(nativeHandle, cf.getNativeHandle(),
+            lower, upper, comparator);
+        return new TidesDBIterator(iterHandle, this);
+    }
+
+    /**
+     * Creates an iterator over the keys that start with {@code prefix}. This is a
+     * bounded iterator whose upper bound is the smallest key greater than every key with
+     * the prefix; see {@link #newIterator(ColumnFamily, byte[], byte[])}. Column
+     * families configured with a matching {@code blockIndexPrefixLen} benefit most,
+     * since their block index is keyed on the same prefix.
+     *
+     * <p>Only bytewise-ordered column families keep the keys sharing a prefix together, so
+     * other comparators are rejected.</p>
+     *
+     * @param cf the column family
+     * @param prefix the key prefix
+     * @return a new iterator
+     * @throws TidesDBException if the iterator cannot be created
+     */
+    public TidesDBIterator newPrefixIterator(ColumnFamily cf, byte[] prefix) throws TidesDBException {
+        if (prefix == null || prefix.length == 0) {
+            throw new IllegalArgumentException("Prefix cannot be null or empty");
+        }
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (!cf.isBytewise()) {
+            throw new IllegalArgumentException("Prefix iteration needs a bytewise-ordered "
+                + "column family, " + cf.getName() + " uses " + cf.comparatorName());
+        }
+        return newIterator(cf, prefix, prefixSuccessor(prefix));
+    }
+
+    /**
+     * Returns the smallest key greater than every key starting with {@code prefix}, or
+     * null if there is none (the prefix is all 0xFF bytes).
+     */
+    static byte[] prefixSuccessor(byte[] prefix) {
+        for (int i = prefix.length - 1; i >= 0; i--) {
+            if (prefix[i] != (byte) 0xFF) {
+                byte[] upper = Arrays.copyOf(prefix, i + 1);
+                upper[i]++;
+                return upper;
+            }
+        }
+        return null;
+    }
+
+    private static byte[] emptyToNull(byte[] bound) {
+        return bound == null || bound.length == 0 ? null : bound;
     }
     
     /**
@@ -225,48 +829,225 @@ public class Transaction implements Closeable {
         if (isolation == null) {
             throw new IllegalArgumentException("Isolation level cannot be null");
         }
+        takeTouched();
         nativeReset(nativeHandle, isolation.getValue());
     }
     
     /**
-     * Frees the transaction resources.
+     * Frees the transaction resources, first waiting for any asynchronous operation still
+     * running against it.
      */
     public void free() {
+        awaitAsync();
         if (!freed && nativeHandle != 0) {
-            nativeFree(nativeHandle);
+            resource.release();
             nativeHandle = 0;
             freed = true;
         }
     }
     
     /**
-     * Closes the transaction (same as free).
+     * Closes the transaction. A transaction acquired from a {@link TransactionPool} is
+     * handed back to the pool for reuse and must not be touched afterwards; any other
+     * transaction is freed. Either way, asynchronous operations still running against it
+     * are waited for first.
      */
     @Override
     public void close() {
+        if (pool != null && !freed) {
+            awaitAsync();
+            freed = true;
+            // the handle moves to the pool; this wrapper stays freed for good. With
+            // iterators still open it cannot move, and is freed once they are.
+            if (resource.detach()) {
+                pool.release(nativeHandle);
+            } else {
+                resource.release();
+            }
+            nativeHandle = 0;
+            return;
+        }
         free();
     }
+
+    /**
+     * Returns true if this transaction was acquired with
+     * {@link TransactionPool#acquireReadOnly()} and rejects writes.
+     *
+     * @return true if the transaction is read-only
+     */
+    public boolean isReadOnly() {
+        return readOnly;
+    }
     
     private void checkNotFreed() {
-        if (freed) {
+        if (freed || resource.isFreed()) {
             throw new IllegalStateException("Transaction has been freed");
         }
     }
+
+    private void checkWritable() {
+        if (readOnly) {
+            throw new IllegalStateException("Transaction is read-only");
+        }
+    }
+
+    void attachToPool(TransactionPool pool, boolean readOnly) {
+        this.pool = pool;
+        this.readOnly = readOnly;
+    }
+
+    /**
+     * Prepares an idle pooled handle for its next owner: rolls back whatever the previous
+     * owner left uncommitted and resets it with a fresh snapshot. Returns false if the
+     * handle could not be reset, in which case the pool frees it.
+     */
+    static boolean recycle(long handle, IsolationLevel isolation) {
+        return nativeRecycle(handle, isolation.getValue());
+    }
+
+    /**
+     * Frees an idle pooled handle that no wrapper owns.
+     */
+    static void freeIdle(long handle) {
+        nativeFree(handle);
+    }
     
     long getNativeHandle() {
         return nativeHandle;
     }
+
+    NativeResource resource() {
+        return resource;
+    }
+
+    TidesDB db() {
+        return db;
+    }
+
+    /**
+     * Records a column family written by this transaction so group commit knows which
+     * WALs to sync. A no-op when group commit is disabled.
+     */
+    private void touch(ColumnFamily cf) {
+        if (groupCommitter != null && cf.getNativeHandle() != lastTouchedCf) {
+            lastTouchedCf = cf.getNativeHandle();
+            touched.add(cf);
+        }
+    }
+
+    private void touchAll(WriteBatch batch) {
+        if (groupCommitter != null) {
+            for (ColumnFamily cf : batch.columnFamilies()) {
+                touch(cf);
+            }
+        }
+    }
+
+    private List<ColumnFamily> takeTouched() {
+        if (touched.isEmpty()) {
+            return Collections.emptyList();
+        }
+        List<ColumnFamily> cfs = new ArrayList<>(touched);
+        touched.clear();
+        lastTouchedCf = 0;
+        return cfs;
+    }
+
+    /**
+     * After a successful commit, waits for the group commit batch to make the column
+     * families it wrote durable.
+     */
+    private void awaitGroupCommit(List<ColumnFamily> cfs) throws TidesDBException {
+        if (groupCommitter != null) {
+            groupCommitter.awaitDurable(cfs);
+        }
+    }
+
+    /**
+     * Runs an operation on the database's async pool and counts it as pending until it
+     * completes. The returned stage completes only after the count is dropped, so a caller
+     * that joins it can free the transaction straight away.
+     */
+    private <T> CompletableFuture<T> submitAsync(Function<AsyncPool, CompletableFuture<T>> op) {
+        AsyncPool pool;
+        try {
+            pool = db.asyncPool();
+        } catch (TidesDBException | IllegalStateException e) {
+            CompletableFuture<T> failed = new CompletableFuture<>();
+            failed.completeExceptionally(e);
+            return failed;
+        }
+        pendingAsync.incrementAndGet();
+        return op.apply(pool).whenComplete((result, error) -> {
+            if (pendingAsync.decrementAndGet() == 0) {
+                synchronized (pendingAsync) {
+                    pendingAsync.notifyAll();
+                }
+            }
+        });
+    }
+
+    /**
+     * Blocks until no asynchronous operation is using the native handle. Every submitted
+     * operation completes, successfully or not, even while the pool shuts down, so this
+     * always returns.
+     */
+    private void awaitAsync() {
+        if (pendingAsync.get() == 0) {
+            return;
+        }
+        boolean interrupted = false;
+        synchronized (pendingAsync) {
+            while (pendingAsync.get() > 0) {
+                try {
+                    pendingAsync.wait();
+                } catch (InterruptedException e) {
+                    // the handle must not be freed under a running operation; finish waiting
+                    interrupted = true;
+                }
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+    }
     
     private static native void nativePut(long handle, long cfHandle, byte[] key, byte[] value, long ttl) throws TidesDBException;
-    private static native byte[] nativeGet(long handle, long cfHandle, byte[] key) throws TidesDBException;
+    private static native byte[] nativeGet(long handle, long cfHandle, byte[] key, int latencySlot) throws TidesDBException;
+    private static native void nativePutLong(long handle, long cfHandle, long key, byte[] value, long ttl) throws TidesDBException;
+    private static native void nativePutUuid(long handle, long cfHandle, long msb, long lsb, byte[] value,
+        long ttl) throws TidesDBException;
+    private static native byte[] nativeGetLong(long handle, long cfHandle, long key, int latencySlot) throws TidesDBException;
+    private static native byte[] nativeGetUuid(long handle, long cfHandle, long msb, long lsb,
+        int latencySlot) throws TidesDBException;
+    private static native void nativeDeleteLong(long handle, long cfHandle, long key) throws TidesDBException;
+    private static native void nativeDeleteUuid(long handle, long cfHandle, long msb, long lsb) throws TidesDBException;
+    private static native byte[][] nativeMultiGetLongs(long handle, long cfHandle, long[] keys, int latencySlot) throws TidesDBException;
+    private static native void nativePutDirect(long handle, long cfHandle, ByteBuffer key, int keyOffset, int keyLength,
+                                               ByteBuffer value, int valueOffset, int valueLength, long ttl) throws TidesDBException;
+    private static native int nativeGetInto(long handle, long cfHandle, byte[] key, byte[] dst, int dstOffset, int dstLength,
+        int latencySlot) throws TidesDBException;
+    private static native int nativeGetIntoDirect(long handle, long cfHandle, byte[] key, ByteBuffer dst, int dstOffset,
+        int dstLength, int latencySlot) throws TidesDBException;
+    private static native byte[] nativeGetDirect(long handle, long cfHandle, ByteBuffer key, int keyOffset, int keyLength,
+        int latencySlot) throws TidesDBException;
+    private static native byte[][] nativeMultiGet(long handle, long cfHandle, byte[][] keys, int latencySlot) throws TidesDBException;
+    private static native int nativeMultiGetPacked(long handle, long cfHandle, ByteBuffer keys, int keysOffset, int keysLength,
+                                                   int count, ByteBuffer out, int outOffset, int outLength, int latencySlot) throws TidesDBException;
     private static native void nativeDelete(long handle, long cfHandle, byte[] key) throws TidesDBException;
     private static native void nativeSingleDelete(long handle, long cfHandle, byte[] key) throws TidesDBException;
+    private static native long nativeDeleteRange(long handle, long cfHandle, byte[] startKey, byte[] endKey,
+        String comparatorName, long limit, byte[][] lastKey) throws TidesDBException;
+    private static native void nativeWriteBatch(long handle, ByteBuffer batch, int length, int count, boolean commit) throws TidesDBException;
     private static native void nativeCommit(long handle) throws TidesDBException;
     private static native void nativeRollback(long handle) throws TidesDBException;
     private static native void nativeSavepoint(long handle, String name) throws TidesDBException;
     private static native void nativeRollbackToSavepoint(long handle, String name) throws TidesDBException;
     private static native void nativeReleaseSavepoint(long handle, String name) throws TidesDBException;
     private static native long nativeNewIterator(long handle, long cfHandle) throws TidesDBException;
+    private static native long nativeNewBoundedIterator(long handle, long cfHandle, byte[] lowerBound, byte[] upperBound, String comparatorName) throws TidesDBException;
     private static native void nativeReset(long handle, int isolationLevel) throws TidesDBException;
+    private static native boolean nativeRecycle(long handle, int isolationLevel);
     private static native void nativeFree(long handle);
 }
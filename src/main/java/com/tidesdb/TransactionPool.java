@@ -0,0 +1,164 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.util.concurrent.ConcurrentLinkedDeque;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Recycles native transactions so hot paths do not pay for a begin and free per
+ * request. {@link #acquire()} hands out an idle native transaction reset with a fresh
+ * snapshot, or begins a new one when none is idle; closing the transaction returns its
+ * native handle here instead of freeing it. At most {@code maxIdle} handles are kept, and
+ * the most recently returned one is reused first so its memory is still warm.
+ *
+ * <p>Every acquire returns a new {@link Transaction} object, so a stale reference to a
+ * transaction that was closed stays closed even after its handle has been handed to
+ * someone else. A pooled transaction is owned by one thread at a time, exactly like any
+ * other transaction; the pool itself is thread-safe. A transaction closed without
+ * committing is rolled back before its handle is handed out again. Closing the database
+ * closes its pools.</p>
+ */
+public final class TransactionPool implements AutoCloseable {
+    
+    private final TidesDB db;
+    private final int maxIdle;
+    private final ConcurrentLinkedDeque<Long> idle = new ConcurrentLinkedDeque<>();
+    private final AtomicInteger idleCount = new AtomicInteger();
+    private volatile boolean closed = false;
+    
+    TransactionPool(TidesDB db, int maxIdle) {
+        this.db = db;
+        this.maxIdle = maxIdle;
+    }
+    
+    /**
+     * Acquires a read-committed transaction.
+     *
+     * @return a transaction that returns to the pool when closed
+     * @throws TidesDBException if a new transaction cannot be started
+     */
+    public Transaction acquire() throws TidesDBException {
+        return acquire(IsolationLevel.READ_COMMITTED, false);
+    }
+    
+    /**
+     * Acquires a transaction with the given isolation level.
+     *
+     * @param isolation the isolation level
+     * @return a transaction that returns to the pool when closed
+     * @throws TidesDBException if a new transaction cannot be started
+     */
+    public Transaction acquire(IsolationLevel isolation) throws TidesDBException {
+        return acquire(isolation, false);
+    }
+    
+    /**
+     * Acquires a read-committed transaction that rejects puts, deletes and batch writes
+     * with {@link IllegalStateException}. Since it never stages a write, it has nothing
+     * to roll back when it is recycled.
+     *
+     * @return a read-only transaction that returns to the pool when closed
+     * @throws TidesDBException if a new transaction cannot be started
+     */
+    public Transaction acquireReadOnly() throws TidesDBException {
+        return acquire(IsolationLevel.READ_COMMITTED, true);
+    }
+    
+    /**
+     * Acquires a read-only transaction with the given isolation level.
+     *
+     * @param isolation the isolation level
+     * @return a read-only transaction that returns to the pool when closed
+     * @throws TidesDBException if a new transaction cannot be started
+     */
+    public Transaction acquireReadOnly(IsolationLevel isolation) throws TidesDBException {
+        return acquire(isolation, true);
+    }
+    
+    /**
+     * Returns the number of idle transactions held by the pool.
+     *
+     * @return the idle count
+     */
+    public int getIdleCount() {
+        return idleCount.get();
+    }
+    
+    /**
+     * Frees every idle transaction. Transactions still in use are freed when they are
+     * closed.
+     */
+    @Override
+    public void close() {
+        closed = true;
+        drain();
+        db.forgetPool(this);
+    }
+    
+    private Transaction acquire(IsolationLevel isolation, boolean readOnly) throws TidesDBException {
+        if (isolation == null) {
+            throw new IllegalArgumentException("Isolation level cannot be null");
+        }
+        if (closed) {
+            throw new IllegalStateException("Transaction pool has been closed");
+        }
+        Transaction txn = null;
+        Long handle;
+        while (txn == null && (handle = idle.pollFirst()) != null) {
+            idleCount.decrementAndGet();
+            if (Transaction.recycle(handle, isolation)) {
+                txn = new Transaction(handle, db);
+            } else {
+                Transaction.freeIdle(handle);
+            }
+        }
+        if (txn == null) {
+            txn = db.beginTransaction(isolation);
+        }
+        txn.attachToPool(this, readOnly);
+        return txn;
+    }
+    
+    /**
+     * Takes back the native handle of a closed pooled transaction.
+     */
+    void release(long handle) {
+        if (closed || idleCount.incrementAndGet() > maxIdle) {
+            if (!closed) {
+                idleCount.decrementAndGet();
+            }
+            Transaction.freeIdle(handle);
+            return;
+        }
+        idle.offerFirst(handle);
+        if (closed) {
+            // close() may have drained before this offer landed
+            drain();
+        }
+    }
+    
+    private void drain() {
+        Long handle;
+        while ((handle = idle.pollFirst()) != null) {
+            idleCount.decrementAndGet();
+            Transaction.freeIdle(handle);
+        }
+    }
+}
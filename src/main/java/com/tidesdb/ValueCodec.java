@@ -0,0 +1,385 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.DirectoryStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.LongAdder;
+import java.util.concurrent.locks.ReentrantReadWriteLock;
+
+/**
+ * zstd dictionary compression for the values of one column family, obtained from
+ * {@link ColumnFamily#trainValueCodec} or {@link ColumnFamily#getValueCodec()}. Values are
+ * compressed before they reach the engine, so SSTables, the vlog and the block cache all hold
+ * the compressed form; small, similar records that block compression handles poorly typically
+ * shrink 2-3x.
+ *
+ * <p>Encoding is explicit: write {@code codec.encode(value)} and read back with
+ * {@link #decode(byte[])}. Each encoded value names its dictionary, and retraining keeps the
+ * older dictionaries, so values written before a retrain stay readable. Values that would not
+ * shrink are stored with a one-byte header. Dictionaries are saved in the column family's
+ * directory and reloaded on reopen.</p>
+ */
+public final class ValueCodec {
+    
+    /** Default zstd compression level. */
+    public static final int DEFAULT_LEVEL = 3;
+    
+    static final String DIRECTORY = "value_dictionaries";
+    private static final String CURRENT = "CURRENT";
+    private static final String SUFFIX = ".zdict";
+    private static final byte TAG_RAW = 0;
+    private static final byte TAG_ZSTD = 1;
+    private static final int HEADER = 5;
+    
+    /**
+     * A loaded dictionary; the native handle holds both the compression and decompression
+     * form.
+     */
+    private static final class Dictionary {
+        final long handle;
+        final NativeResource resource;
+        
+        Dictionary(ValueCodec owner, long handle) {
+            this.handle = handle;
+            this.resource = NativeResource.register(owner, "ValueCodec dictionary", handle,
+                ValueCodec::nativeFree);
+        }
+    }
+    
+    private final Map<Integer, Dictionary> dictionaries = new ConcurrentHashMap<>();
+    private volatile Dictionary current;
+    private volatile int currentId;
+    private volatile int level;
+    private final LongAdder bytesIn = new LongAdder();
+    private final LongAdder bytesOut = new LongAdder();
+    private volatile boolean closed = false;
+    
+    // encode/decode hold the read lock while they use a native handle, so a replaced
+    // dictionary or a closed codec is only freed once no call is still compressing with it
+    private final ReentrantReadWriteLock handleLock = new ReentrantReadWriteLock();
+    
+    private ValueCodec() {
+    }
+    
+    /**
+     * Trains a dictionary from sample values. A few thousand samples covering the typical
+     * record shapes work best; zstd rejects sample sets that are too small or too uniform.
+     *
+     * @param samples sample values
+     * @param dictionarySize maximum dictionary size in bytes, e.g. 16KB-112KB
+     * @return the trained dictionary
+     * @throws TidesDBException if training fails
+     */
+    public static byte[] train(List<byte[]> samples, int dictionarySize) throws TidesDBException {
+        if (samples == null || samples.isEmpty()) {
+            throw new IllegalArgumentException("Samples cannot be null or empty");
+        }
+        if (dictionarySize <= 0) {
+            throw new IllegalArgumentException("Dictionary size must be positive");
+        }
+        byte[][] arr = samples.toArray(new byte[0][]);
+        for (byte[] sample : arr) {
+            if (sample == null) {
+                throw new IllegalArgumentException("Sample cannot be null");
+            }
+        }
+        return nativeTrain(arr, dictionarySize);
+    }
+    
+    /**
+     * Compresses a value with the current dictionary.
+     *
+     * @param value the value
+     * @return the encoded value to store
+     * @throws TidesDBException if the codec has been released
+     */
+    public byte[] encode(byte[] value) throws TidesDBException {
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        byte[] encoded;
+        handleLock.readLock().lock();
+        try {
+            checkNotClosed();
+            encoded = nativeEncode(current.handle, value);
+        } finally {
+            handleLock.readLock().unlock();
+        }
+        bytesIn.add(value.length);
+        bytesOut.add(encoded.length);
+        return encoded;
+    }
+    
+    /**
+     * Restores a value written by {@link #encode(byte[])} with any of this column family's
+     * dictionaries.
+     *
+     * @param stored the stored value
+     * @return the original value
+     * @throws TidesDBException if the value was not encoded by this codec or is corrupt
+     */
+    public byte[] decode(byte[] stored) throws TidesDBException {
+        if (stored == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        if (stored.length >= 1 && stored[0] == TAG_RAW) {
+            byte[] value = new byte[stored.length - 1];
+            System.arraycopy(stored, 1, value, 0, value.length);
+            return value;
+        }
+        if (stored.length < HEADER || stored[0] != TAG_ZSTD) {
+            throw new TidesDBException("Value was not written by a ValueCodec",
+                TidesDBException.ERR_CORRUPTION);
+        }
+        int id = ((stored[1] & 0xff) << 24) | ((stored[2] & 0xff) << 16)
+            | ((stored[3] & 0xff) << 8) | (stored[4] & 0xff);
+        handleLock.readLock().lock();
+        try {
+            checkNotClosed();
+            Dictionary dict = dictionaries.get(id);
+            if (dict == null) {
+                throw new TidesDBException("Unknown value dictionary "
+                    + Integer.toUnsignedString(id), TidesDBException.ERR_NOT_FOUND);
+            }
+            return nativeDecode(dict.handle, stored);
+        } finally {
+            handleLock.readLock().unlock();
+        }
+    }
+    
+    /**
+     * Gets the zstd id of the dictionary new values are encoded with.
+     *
+     * @return the current dictionary id
+     */
+    public int getDictionaryId() {
+        return currentId;
+    }
+    
+    public int getLevel() {
+        return level;
+    }
+    
+    public int getDictionaryCount() {
+        return dictionaries.size();
+    }
+    
+    /**
+     * Gets the value bytes passed to {@link #encode(byte[])} in this process.
+     *
+     * @return uncompressed bytes encoded
+     */
+    public long getBytesIn() {
+        return bytesIn.sum();
+    }
+    
+    /**
+     * Gets the bytes {@link #encode(byte[])} produced in this process.
+     *
+     * @return encoded bytes
+     */
+    public long getBytesOut() {
+        return bytesOut.sum();
+    }
+    
+    /**
+     * Gets the compression ratio of values encoded in this process.
+     *
+     * @return uncompressed bytes divided by encoded bytes, 1.0 before anything was encoded
+     */
+    public double getCompressionRatio() {
+        long out = bytesOut.sum();
+        return out == 0 ? 1.0 : (double) bytesIn.sum() / out;
+    }
+    
+    /**
+     * Loads the dictionaries saved in {@code cfDir}, or returns null if there are none.
+     */
+    static ValueCodec load(Path cfDir) throws TidesDBException {
+        Path dir = cfDir.resolve(DIRECTORY);
+        Path currentFile = dir.resolve(CURRENT);
+        if (!Files.exists(currentFile)) {
+            return null;
+        }
+        ValueCodec codec = new ValueCodec();
+        try {
+            String[] fields = new String(Files.readAllBytes(currentFile), StandardCharsets.UTF_8)
+                .trim().split(" ");
+            int currentId = Integer.parseUnsignedInt(fields[0]);
+            int level = Integer.parseInt(fields[1]);
+            try (DirectoryStream<Path> files = Files.newDirectoryStream(dir, "*" + SUFFIX)) {
+                for (Path file : files) {
+                    codec.add(Files.readAllBytes(file), level, false);
+                }
+            }
+            Dictionary current = codec.dictionaries.get(currentId);
+            if (current == null) {
+                throw new TidesDBException("Current value dictionary "
+                    + Integer.toUnsignedString(currentId) + " is missing from " + dir,
+                    TidesDBException.ERR_CORRUPTION);
+            }
+            codec.current = current;
+            codec.currentId = currentId;
+            codec.level = level;
+        } catch (IOException | RuntimeException e) {
+            codec.close();
+            throw new TidesDBException("Failed to load value dictionaries from " + dir + ": " + e,
+                TidesDBException.ERR_IO, e);
+        } catch (TidesDBException e) {
+            codec.close();
+            throw e;
+        }
+        return codec;
+    }
+    
+    /**
+     * Saves {@code dictionary} in {@code cfDir} and makes it current for {@code codec}, or for
+     * a new codec if {@code codec} is null.
+     */
+    static ValueCodec install(ValueCodec codec, Path cfDir, byte[] dictionary, int level)
+        throws TidesDBException {
+        ValueCodec target = codec != null ? codec : new ValueCodec();
+        int id = target.add(dictionary, level, true);
+        Path dir = cfDir.resolve(DIRECTORY);
+        try {
+            Files.createDirectories(dir);
+            writeAtomically(dir.resolve(Integer.toUnsignedString(id) + SUFFIX), dictionary);
+            String current = Integer.toUnsignedString(id) + " " + level + "\n";
+            writeAtomically(dir.resolve(CURRENT), current.getBytes(StandardCharsets.UTF_8));
+        } catch (IOException e) {
+            if (codec == null) {
+                target.close();
+            }
+            throw new TidesDBException("Failed to save value dictionary to " + dir + ": " + e,
+                TidesDBException.ERR_IO, e);
+        }
+        return target;
+    }
+    
+    private static void writeAtomically(Path file, byte[] data) throws IOException {
+        Path tmp = file.resolveSibling(file.getFileName() + ".tmp");
+        Files.write(tmp, data);
+        Files.move(tmp, file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+    }
+    
+    private int add(byte[] dictionary, int level, boolean makeCurrent)
+        throws TidesDBException {
+        handleLock.writeLock().lock();
+        try {
+            checkNotClosed();
+            long handle = nativeCreate(dictionary, level);
+            int id = nativeDictId(handle);
+            Dictionary dict = new Dictionary(this, handle);
+            Dictionary old = dictionaries.put(id, dict);
+            if (old != null) {
+                // same dictionary retrained or reloaded at a new level; the new handle replaces it
+                old.resource.release();
+            }
+            if (makeCurrent || (old != null && old == current)) {
+                current = dict;
+                currentId = id;
+                this.level = level;
+            }
+            return id;
+        } finally {
+            handleLock.writeLock().unlock();
+        }
+    }
+    
+    private void checkNotClosed() throws TidesDBException {
+        if (closed) {
+            throw new TidesDBException("Value codec has been released with its column family",
+                TidesDBException.ERR_INVALID_ARGS);
+        }
+    }
+    
+    void close() {
+        handleLock.writeLock().lock();
+        try {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            for (Dictionary dict : dictionaries.values()) {
+                dict.resource.release();
+            }
+            dictionaries.clear();
+        } finally {
+            handleLock.writeLock().unlock();
+        }
+    }
+    
+    /**
+     * Copies the saved dictionaries of every column family under {@code dbDir} into the same
+     * place under {@code targetDir}, so checkpoints and backups of encoded values stay
+     * decodable. Column families without dictionaries, or not present in the target, are
+     * skipped.
+     */
+    static void copyDictionaries(Path dbDir, Path targetDir) throws TidesDBException {
+        try (DirectoryStream<Path> cfs = Files.newDirectoryStream(dbDir, Files::isDirectory)) {
+            for (Path cfDir : cfs) {
+                Path target = targetDir.resolve(cfDir.getFileName());
+                if (Files.isDirectory(target)) {
+                    copyColumnFamily(cfDir, target);
+                }
+            }
+        } catch (IOException e) {
+            throw new TidesDBException("Failed to copy value dictionaries to " + targetDir
+                + ": " + e, TidesDBException.ERR_IO, e);
+        }
+    }
+    
+    /**
+     * Copies the saved dictionaries of one column family directory to another.
+     */
+    static void copyColumnFamily(Path cfDir, Path targetCfDir) throws IOException {
+        Path dir = cfDir.resolve(DIRECTORY);
+        if (!Files.isDirectory(dir)) {
+            return;
+        }
+        Path target = targetCfDir.resolve(DIRECTORY);
+        Files.createDirectories(target);
+        try (DirectoryStream<Path> files = Files.newDirectoryStream(dir, "*" + SUFFIX)) {
+            for (Path file : files) {
+                Files.copy(file, target.resolve(file.getFileName()),
+                    StandardCopyOption.REPLACE_EXISTING);
+            }
+        }
+        // CURRENT last, so a target that has it also has every dictionary it names
+        if (Files.exists(dir.resolve(CURRENT))) {
+            Files.copy(dir.resolve(CURRENT), target.resolve(CURRENT),
+                StandardCopyOption.REPLACE_EXISTING);
+        }
+    }
+    
+    private static native byte[] nativeTrain(byte[][] samples, int dictionarySize) throws TidesDBException;
+    private static native long nativeCreate(byte[] dictionary, int level) throws TidesDBException;
+    private static native int nativeDictId(long handle);
+    private static native void nativeFree(long handle);
+    private static native byte[] nativeEncode(long handle, byte[] value) throws TidesDBException;
+    private static native byte[] nativeDecode(long handle, byte[] stored) throws TidesDBException;
+}
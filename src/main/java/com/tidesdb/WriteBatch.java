@@ -0,0 +1,236 @@
+/**
+ *
+ * Copyright (C) TidesDB
+ *
+ * Original Author: Alex Gaetano Padula
+ *
+ * Licensed under the Mozilla Public License, v. 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.mozilla.org/en-US/MPL/2.0/
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tidesdb;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A batch of puts and deletes serialized into one contiguous direct buffer.
+ * Applying the batch with {@link Transaction#write(WriteBatch)} crosses into native
+ * code once for the whole batch instead of once per operation.
+ *
+ * <p>A batch can span column families and can be cleared and reused. It is not
+ * thread-safe.</p>
+ */
+public class WriteBatch {
+
+    static final byte OP_PUT = 0;
+    static final byte OP_DELETE = 1;
+    static final byte OP_SINGLE_DELETE = 2;
+
+    private static final int DEFAULT_CAPACITY = 64 * 1024;
+
+    private ByteBuffer buffer;
+    private int count = 0;
+    private final List<ColumnFamily> columnFamilies = new ArrayList<>();
+    private long lastCfHandle = 0;
+
+    /**
+     * Creates an empty batch with a default initial capacity.
+     */
+    public WriteBatch() {
+        this(DEFAULT_CAPACITY);
+    }
+
+    /**
+     * Creates an empty batch.
+     *
+     * @param initialCapacity initial size of the backing buffer in bytes; it grows as needed
+     */
+    public WriteBatch(int initialCapacity) {
+        if (initialCapacity <= 0) {
+            throw new IllegalArgumentException("Initial capacity must be positive");
+        }
+        this.buffer = ByteBuffer.allocateDirect(initialCapacity);
+    }
+
+    /**
+     * Adds a put to the batch.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param value the value
+     * @param ttl Unix timestamp (seconds since epoch) for expiration, or -1 for no expiration
+     * @return this batch
+     */
+    public WriteBatch put(ColumnFamily cf, byte[] key, byte[] value, long ttl) {
+        checkKey(cf, key);
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        ensureCapacity(1 + 8 + 4 + key.length + 4 + value.length + 8);
+        buffer.put(OP_PUT).putLong(cf.getNativeHandle())
+            .putInt(key.length).put(key)
+            .putInt(value.length).put(value)
+            .putLong(ttl);
+        count++;
+        touch(cf);
+        return this;
+    }
+
+    /**
+     * Adds a put with no expiration to the batch.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param value the value
+     * @return this batch
+     */
+    public WriteBatch put(ColumnFamily cf, byte[] key, byte[] value) {
+        return put(cf, key, value, -1);
+    }
+
+    /**
+     * Adds a put to the batch, copying the remaining bytes of each buffer. Buffer
+     * positions and limits are not modified.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @param value the value
+     * @param ttl Unix timestamp (seconds since epoch) for expiration, or -1 for no expiration
+     * @return this batch
+     */
+    public WriteBatch put(ColumnFamily cf, ByteBuffer key, ByteBuffer value, long ttl) {
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null || !key.hasRemaining()) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+        if (value == null) {
+            throw new IllegalArgumentException("Value cannot be null");
+        }
+        ensureCapacity(1 + 8 + 4 + key.remaining() + 4 + value.remaining() + 8);
+        buffer.put(OP_PUT).putLong(cf.getNativeHandle())
+            .putInt(key.remaining()).put(key.duplicate())
+            .putInt(value.remaining()).put(value.duplicate())
+            .putLong(ttl);
+        count++;
+        touch(cf);
+        return this;
+    }
+
+    /**
+     * Adds a delete to the batch.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return this batch
+     */
+    public WriteBatch delete(ColumnFamily cf, byte[] key) {
+        return addKeyOp(OP_DELETE, cf, key);
+    }
+
+    /**
+     * Adds a single-delete to the batch. See {@link Transaction#singleDelete} for the
+     * caller contract.
+     *
+     * @param cf the column family
+     * @param key the key
+     * @return this batch
+     */
+    public WriteBatch singleDelete(ColumnFamily cf, byte[] key) {
+        return addKeyOp(OP_SINGLE_DELETE, cf, key);
+    }
+
+    /**
+     * Removes all operations so the batch can be reused. The backing buffer is kept.
+     */
+    public void clear() {
+        buffer.clear();
+        count = 0;
+        columnFamilies.clear();
+        lastCfHandle = 0;
+    }
+
+    /**
+     * Gets the number of operations in the batch.
+     *
+     * @return the operation count
+     */
+    public int count() {
+        return count;
+    }
+
+    /**
+     * Gets the serialized size of the batch.
+     *
+     * @return the size in bytes
+     */
+    public int sizeInBytes() {
+        return buffer.position();
+    }
+
+    ByteBuffer buffer() {
+        return buffer;
+    }
+
+    /**
+     * Column families written by the batch. Consecutive duplicates are collapsed; the list
+     * may still repeat a column family the batch returned to.
+     */
+    List<ColumnFamily> columnFamilies() {
+        return columnFamilies;
+    }
+
+    private void touch(ColumnFamily cf) {
+        if (cf.getNativeHandle() != lastCfHandle) {
+            lastCfHandle = cf.getNativeHandle();
+            columnFamilies.add(cf);
+        }
+    }
+
+    private WriteBatch addKeyOp(byte op, ColumnFamily cf, byte[] key) {
+        checkKey(cf, key);
+        ensureCapacity(1 + 8 + 4 + key.length);
+        buffer.put(op).putLong(cf.getNativeHandle()).putInt(key.length).put(key);
+        count++;
+        touch(cf);
+        return this;
+    }
+
+    private static void checkKey(ColumnFamily cf, byte[] key) {
+        if (cf == null) {
+            throw new IllegalArgumentException("Column family cannot be null");
+        }
+        if (key == null || key.length == 0) {
+            throw new IllegalArgumentException("Key cannot be null or empty");
+        }
+    }
+
+    private void ensureCapacity(int extra) {
+        if (buffer.remaining() >= extra) {
+            return;
+        }
+        long needed = (long) buffer.position() + extra;
+        long newCapacity = Math.max((long) buffer.capacity() * 2, needed);
+        if (newCapacity > Integer.MAX_VALUE) {
+            if (needed > Integer.MAX_VALUE) {
+                throw new IllegalStateException("Write batch exceeds 2 GB");
+            }
+            newCapacity = Integer.MAX_VALUE;
+        }
+        ByteBuffer grown = ByteBuffer.allocateDirect((int) newCapacity);
+        buffer.flip();
+        grown.put(buffer);
+        buffer = grown;
+    }
+}
@@ -21,11 +21,28 @@ package com.tidesdb;
 import org.junit.jupiter.api.*;
 import org.junit.jupiter.api.io.TempDir;
 
+import java.nio.ByteBuffer;
+import java.nio.LongBuffer;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
 import java.nio.file.Path;
+import java.nio.file.Paths;
 import java.time.Instant;
+import java.time.LocalTime;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
 import java.util.List;
+import java.util.Map;
+import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicLong;
 
 import static org.junit.jupiter.api.Assertions.*;
@@ -39,6 +56,27 @@ public class TidesDBTest {
     @TempDir
     Path tempDir;
     
+    /**
+     * Config builder for a database in its own directory under {@link #tempDir}, with the
+     * thread, cache and file settings the tests share.
+     */
+    private Config.Builder testConfig(String name) {
+        return configAt(tempDir.resolve(name).toString());
+    }
+    
+    /**
+     * Config builder with the shared test settings for a database at dbPath, e.g. one
+     * restored from a backup.
+     */
+    private static Config.Builder configAt(String dbPath) {
+        return Config.builder(dbPath)
+            .numFlushThreads(2)
+            .numCompactionThreads(2)
+            .logLevel(LogLevel.INFO)
+            .blockCacheSize(64 * 1024 * 1024)
+            .maxOpenSSTables(256);
+    }
+    
     @Test
     @Order(1)
     void testOpenClose() throws TidesDBException {
@@ -1767,4 +1805,1858 @@ public class TidesDBTest {
             }
         }
     }
+
+    @Test
+    @Order(48)
+    void testNativeExceptionCarriesErrorCode() throws TidesDBException {
+        Config config = testConfig("testdb_exception_code").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            // The exception class and constructor are resolved once at load time, so the
+            // throw path must keep producing well-formed exceptions on repeated failures
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 100; i++) {
+                    byte[] key = ("missing" + i).getBytes(StandardCharsets.UTF_8);
+                    TidesDBException e = assertThrows(TidesDBException.class, () -> txn.get(cf, key));
+                    assertEquals(TidesDBException.ERR_NOT_FOUND, e.getErrorCode());
+                    assertEquals("not found", e.getMessage());
+                }
+            }
+        }
+    }
+
+    @Test
+    @Order(49)
+    void testDirectByteBufferPutGetSeek() throws TidesDBException {
+        Config config = testConfig("testdb_direct").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            ByteBuffer key = ByteBuffer.allocateDirect(64);
+            ByteBuffer value = ByteBuffer.allocateDirect(4096);
+
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 10; i++) {
+                    key.clear();
+                    key.put(String.format("key%02d", i).getBytes(StandardCharsets.UTF_8)).flip();
+                    value.clear();
+                    value.put(("value" + i).getBytes(StandardCharsets.UTF_8)).flip();
+                    txn.put(cf, key, value);
+
+                    // positions and limits must be left untouched
+                    assertEquals(0, key.position());
+                    assertEquals(5, key.limit());
+                }
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                // Key bytes in the middle of a larger buffer, addressed via position/limit
+                ByteBuffer probe = ByteBuffer.allocateDirect(32);
+                probe.put("xxkey07yy".getBytes(StandardCharsets.UTF_8));
+                probe.position(2).limit(7);
+                assertArrayEquals("value7".getBytes(StandardCharsets.UTF_8), txn.get(cf, probe));
+
+                // Heap keys read back what direct puts wrote
+                assertArrayEquals("value3".getBytes(StandardCharsets.UTF_8),
+                    txn.get(cf, "key03".getBytes(StandardCharsets.UTF_8)));
+
+                try (TidesDBIterator iter = txn.newIterator(cf)) {
+                    probe.clear();
+                    probe.put("key05".getBytes(StandardCharsets.UTF_8)).flip();
+                    iter.seek(probe);
+                    assertTrue(iter.isValid());
+                    assertArrayEquals("key05".getBytes(StandardCharsets.UTF_8), iter.key());
+
+                    probe.clear();
+                    probe.put("key055".getBytes(StandardCharsets.UTF_8)).flip();
+                    iter.seekForPrev(probe);
+                    assertTrue(iter.isValid());
+                    assertArrayEquals("key05".getBytes(StandardCharsets.UTF_8), iter.key());
+                }
+
+                ByteBuffer heapKey = ByteBuffer.wrap("key01".getBytes(StandardCharsets.UTF_8));
+                assertThrows(IllegalArgumentException.class, () -> txn.get(cf, heapKey));
+                assertThrows(IllegalArgumentException.class,
+                    () -> txn.put(cf, ByteBuffer.allocateDirect(0), value));
+            }
+        }
+    }
+
+    @Test
+    @Order(50)
+    void testGetIntoCallerBuffer() throws TidesDBException {
+        Config config = testConfig("testdb_get_into").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            byte[] key = "key".getBytes(StandardCharsets.UTF_8);
+            byte[] value = "a-twenty-byte-value!".getBytes(StandardCharsets.UTF_8);
+
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, key, value);
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                // byte[] destination with offset
+                byte[] dst = new byte[32];
+                assertEquals(value.length, txn.get(cf, key, dst, 4));
+                assertArrayEquals(value, java.util.Arrays.copyOfRange(dst, 4, 4 + value.length));
+
+                // Too small: negated size, nothing written
+                byte[] small = new byte[8];
+                assertEquals(-value.length, txn.get(cf, key, small, 0));
+                assertArrayEquals(new byte[8], small);
+
+                // Direct buffer destination, position and limit unchanged
+                ByteBuffer direct = ByteBuffer.allocateDirect(64);
+                direct.position(10);
+                assertEquals(value.length, txn.get(cf, key, direct));
+                assertEquals(10, direct.position());
+                byte[] readBack = new byte[value.length];
+                direct.get(readBack);
+                assertArrayEquals(value, readBack);
+
+                ByteBuffer tooSmall = ByteBuffer.allocateDirect(4);
+                assertEquals(-value.length, txn.get(cf, key, tooSmall));
+
+                // Heap buffer destination
+                ByteBuffer heap = ByteBuffer.allocate(64);
+                assertEquals(value.length, txn.get(cf, key, heap));
+                byte[] heapBack = new byte[value.length];
+                heap.get(heapBack);
+                assertArrayEquals(value, heapBack);
+
+                assertThrows(TidesDBException.class,
+                    () -> txn.get(cf, "missing".getBytes(StandardCharsets.UTF_8), dst, 0));
+                assertThrows(IndexOutOfBoundsException.class, () -> txn.get(cf, key, dst, 33));
+            }
+        }
+    }
+
+    @Test
+    @Order(51)
+    void testMultiGet() throws TidesDBException {
+        Config config = testConfig("testdb_multi_get").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 20; i += 2) {
+                    txn.put(cf, String.format("key%02d", i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                // Deliberately unsorted, with misses
+                int[] ids = {18, 3, 0, 7, 10, 2};
+                byte[][] keys = new byte[ids.length][];
+                for (int i = 0; i < ids.length; i++) {
+                    keys[i] = String.format("key%02d", ids[i]).getBytes(StandardCharsets.UTF_8);
+                }
+
+                byte[][] values = txn.multiGet(cf, keys);
+                assertEquals(ids.length, values.length);
+                for (int i = 0; i < ids.length; i++) {
+                    if (ids[i] % 2 == 0) {
+                        assertArrayEquals(("value" + ids[i]).getBytes(StandardCharsets.UTF_8),
+                            values[i]);
+                    } else {
+                        assertNull(values[i]);
+                    }
+                }
+
+                // Packed variant
+                ByteBuffer in = ByteBuffer.allocateDirect(256);
+                for (byte[] key : keys) {
+                    in.putInt(key.length).put(key);
+                }
+                in.flip();
+                ByteBuffer out = ByteBuffer.allocateDirect(256);
+                assertEquals(ids.length, txn.multiGet(cf, in, ids.length, out));
+                for (int i = 0; i < ids.length; i++) {
+                    int len = out.getInt();
+                    if (ids[i] % 2 == 0) {
+                        byte[] v = new byte[len];
+                        out.get(v);
+                        assertArrayEquals(("value" + ids[i]).getBytes(StandardCharsets.UTF_8), v);
+                    } else {
+                        assertEquals(Transaction.MULTI_GET_NOT_FOUND, len);
+                    }
+                }
+
+                // Output that only fits the first result ("value18" = 4 + 7 bytes)
+                ByteBuffer tiny = ByteBuffer.allocateDirect(12);
+                assertEquals(1, txn.multiGet(cf, in, ids.length, tiny));
+
+                assertEquals(0, txn.multiGet(cf, new byte[0][]).length);
+                assertThrows(IllegalArgumentException.class,
+                    () -> txn.multiGet(cf, new byte[][] {"a".getBytes(StandardCharsets.UTF_8),
+                        null}));
+            }
+        }
+    }
+
+    @Test
+    @Order(52)
+    void testWriteBatch() throws TidesDBException {
+        Config config = testConfig("testdb_write_batch").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("cf_a", ColumnFamilyConfig.defaultConfig());
+            db.createColumnFamily("cf_b", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cfA = db.getColumnFamily("cf_a");
+            ColumnFamily cfB = db.getColumnFamily("cf_b");
+
+            // Small initial capacity forces the buffer to grow
+            WriteBatch batch = new WriteBatch(16);
+            for (int i = 0; i < 100; i++) {
+                batch.put(cfA, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                    ("value" + i).getBytes(StandardCharsets.UTF_8));
+            }
+            batch.put(cfB, ByteBuffer.wrap("bkey".getBytes(StandardCharsets.UTF_8)),
+                ByteBuffer.wrap("bvalue".getBytes(StandardCharsets.UTF_8)), -1);
+            batch.delete(cfA, "key5".getBytes(StandardCharsets.UTF_8));
+            assertEquals(102, batch.count());
+
+            try (Transaction txn = db.beginTransaction()) {
+                txn.writeAndCommit(batch);
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("value42".getBytes(StandardCharsets.UTF_8),
+                    txn.get(cfA, "key42".getBytes(StandardCharsets.UTF_8)));
+                assertArrayEquals("bvalue".getBytes(StandardCharsets.UTF_8),
+                    txn.get(cfB, "bkey".getBytes(StandardCharsets.UTF_8)));
+                assertThrows(TidesDBException.class,
+                    () -> txn.get(cfA, "key5".getBytes(StandardCharsets.UTF_8)));
+            }
+
+            // Reuse after clear, applied without committing in the same call
+            batch.clear();
+            assertEquals(0, batch.count());
+            batch.delete(cfB, "bkey".getBytes(StandardCharsets.UTF_8));
+            try (Transaction txn = db.beginTransaction()) {
+                txn.write(batch);
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                assertThrows(TidesDBException.class,
+                    () -> txn.get(cfB, "bkey".getBytes(StandardCharsets.UTF_8)));
+            }
+        }
+    }
+
+    @Test
+    @Order(53)
+    void testIteratorNextBatch() throws TidesDBException {
+        Config config = testConfig("testdb_next_batch").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 50; i++) {
+                    txn.put(cf, String.format("key%02d", i).getBytes(StandardCharsets.UTF_8),
+                        String.format("value%02d", i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                try (TidesDBIterator iter = txn.newIterator(cf)) {
+                    iter.seekToFirst();
+
+                    // Each entry is 4 + 5 + 4 + 7 = 20 bytes
+                    ByteBuffer tiny = ByteBuffer.allocateDirect(8);
+                    assertEquals(-20, iter.nextBatch(tiny, 10, 8));
+
+                    ByteBuffer out = ByteBuffer.allocateDirect(4096);
+                    int seen = 0;
+                    int n;
+                    while ((n = iter.nextBatch(out, 16, 4096)) > 0) {
+                        ByteBuffer view = out.duplicate();
+                        for (int i = 0; i < n; i++) {
+                            byte[] k = new byte[view.getInt()];
+                            view.get(k);
+                            byte[] v = new byte[view.getInt()];
+                            view.get(v);
+                            assertArrayEquals(
+                                String.format("key%02d", seen).getBytes(StandardCharsets.UTF_8), k);
+                            assertArrayEquals(
+                                String.format("value%02d", seen).getBytes(StandardCharsets.UTF_8), v);
+                            seen++;
+                        }
+                        assertEquals(0, out.position());
+                    }
+                    assertEquals(0, n);
+                    assertEquals(50, seen);
+                    assertFalse(iter.isValid());
+
+                    // maxBytes bounds the batch even when the buffer is larger
+                    iter.seekToFirst();
+                    assertEquals(3, iter.nextBatch(out, 100, 70));
+                    assertArrayEquals("key03".getBytes(StandardCharsets.UTF_8), iter.key());
+                }
+            }
+        }
+    }
+
+    @Test
+    @Order(54)
+    void testBoundedAndPrefixIterators() throws TidesDBException {
+        Config config = testConfig("testdb_bounded_iter").build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            try (Transaction txn = db.beginTransaction()) {
+                for (String series : new String[] {"a", "b", "c"}) {
+                    for (int i = 0; i < 10; i++) {
+                        txn.put(cf, ("ts:" + series + ":" + i).getBytes(StandardCharsets.UTF_8),
+                            ("v" + i).getBytes(StandardCharsets.UTF_8));
+                    }
+                }
+                txn.commit();
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                try (TidesDBIterator iter = txn.newPrefixIterator(cf,
+                    "ts:b:".getBytes(StandardCharsets.UTF_8))) {
+                    iter.seekToFirst();
+                    int count = 0;
+                    while (iter.isValid()) {
+                        String key = new String(iter.key(), StandardCharsets.UTF_8);
+                        assertTrue(key.startsWith("ts:b:"));
+                        count++;
+                        iter.next();
+                    }
+                    assertEquals(10, count);
+                    assertThrows(TidesDBException.class, iter::key);
+                }
+
+                byte[] lower = "ts:b:3".getBytes(StandardCharsets.UTF_8);
+                byte[] upper = "ts:b:7".getBytes(StandardCharsets.UTF_8);
+                try (TidesDBIterator iter = txn.newIterator(cf, lower, upper)) {
+                    // Seeks below the lower bound are clamped to it
+                    iter.seek("ts:a:0".getBytes(StandardCharsets.UTF_8));
+                    assertArrayEquals(lower, iter.key());
+
+                    // The upper bound is exclusive
+                    iter.seekToLast();
+                    assertArrayEquals("ts:b:6".getBytes(StandardCharsets.UTF_8), iter.key());
+                    iter.next();
+                    assertFalse(iter.isValid());
+
+                    iter.seekToFirst();
+                    ByteBuffer out = ByteBuffer.allocateDirect(4096);
+                    assertEquals(4, iter.nextBatch(out, 100, 4096));
+                    assertEquals(0, iter.nextBatch(out, 100, 4096));
+                }
+            }
+        }
+
+        assertArrayEquals(new byte[] {'a', 'c'}, Transaction.prefixSuccessor(new byte[] {'a', 'b'}));
+        assertArrayEquals(new byte[] {'b'}, Transaction.prefixSuccessor(new byte[] {'a', (byte) 0xFF}));
+        assertNull(Transaction.prefixSuccessor(new byte[] {(byte) 0xFF, (byte) 0xFF}));
+    }
+
+    @Test
+    @Order(55)
+    void testAsyncOperations() throws Exception {
+        Config config = testConfig("testdb_async")
+            .asyncThreads(2)
+            .build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, "key1".getBytes(StandardCharsets.UTF_8),
+                    "value1".getBytes(StandardCharsets.UTF_8));
+                txn.put(cf, "key2".getBytes(StandardCharsets.UTF_8),
+                    "value2".getBytes(StandardCharsets.UTF_8));
+                txn.commitAsync().get(10, TimeUnit.SECONDS);
+            }
+
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8),
+                    txn.getAsync(cf, "key1".getBytes(StandardCharsets.UTF_8)).get(10,
+                        TimeUnit.SECONDS));
+
+                ExecutionException missing = assertThrows(ExecutionException.class,
+                    () -> txn.getAsync(cf, "nope".getBytes(StandardCharsets.UTF_8)).get(10,
+                        TimeUnit.SECONDS));
+                assertTrue(missing.getCause() instanceof TidesDBException);
+                assertEquals(TidesDBException.ERR_NOT_FOUND,
+                    ((TidesDBException) missing.getCause()).getErrorCode());
+
+                byte[][] values = txn.multiGetAsync(cf, new byte[][] {
+                    "key2".getBytes(StandardCharsets.UTF_8),
+                    "nope".getBytes(StandardCharsets.UTF_8)
+                }).get(10, TimeUnit.SECONDS);
+                assertArrayEquals("value2".getBytes(StandardCharsets.UTF_8), values[0]);
+                assertNull(values[1]);
+            }
+
+            // Closing with an operation still in flight waits for it instead of throwing
+            Future<byte[]> inFlight;
+            try (Transaction txn = db.beginTransaction()) {
+                inFlight = txn.getAsync(cf, "key1".getBytes(StandardCharsets.UTF_8));
+            }
+            assertTrue(inFlight.isDone());
+            assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), inFlight.get());
+
+            String backupDir = tempDir.resolve("testdb_async_backup").toString();
+            db.backupAsync(backupDir).get(60, TimeUnit.SECONDS);
+            assertTrue(Files.isDirectory(Paths.get(backupDir)));
+        }
+    }
+
+    @Test
+    @Order(56)
+    void testGroupCommit() throws Exception {
+        Config config = testConfig("testdb_group_commit")
+            .groupCommitWindowUs(2000)
+            .groupCommitMaxBatch(8)
+            .build();
+
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.builder()
+                .syncMode(SyncMode.SYNC_NONE)
+                .build();
+            db.createColumnFamily("test_cf", cfConfig);
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+
+            int threads = 8;
+            int perThread = 25;
+            List<Thread> workers = new ArrayList<>();
+            List<Throwable> failures = Collections.synchronizedList(new ArrayList<>());
+            CountDownLatch start = new CountDownLatch(1);
+            long batchesBefore = db.groupCommitter().batchCount();
+            for (int t = 0; t < threads; t++) {
+                final int id = t;
+                Thread worker = new Thread(() -> {
+                    try {
+                        start.await();
+                        for (int i = 0; i < perThread; i++) {
+                            try (Transaction txn = db.beginTransaction()) {
+                                txn.put(cf, ("k" + id + "_" + i).getBytes(StandardCharsets.UTF_8),
+                                    ("v" + i).getBytes(StandardCharsets.UTF_8));
+                                txn.commit();
+                            }
+                        }
+                    } catch (Throwable e) {
+                        failures.add(e);
+                    }
+                });
+                workers.add(worker);
+                worker.start();
+            }
+            start.countDown();
+            for (Thread worker : workers) {
+                worker.join();
+            }
+            assertTrue(failures.isEmpty(), () -> "commit failures: " + failures);
+            
+            // Concurrent commits inside one window share a batch and so a single WAL sync
+            long batches = db.groupCommitter().batchCount() - batchesBefore;
+            assertTrue(batches > 0);
+            assertTrue(batches < threads * perThread,
+                () -> batches + " batches for " + (threads * perThread) + " commits");
+
+            try (Transaction txn = db.beginTransaction()) {
+                for (int t = 0; t < threads; t++) {
+                    assertArrayEquals(("v" + (perThread - 1)).getBytes(StandardCharsets.UTF_8),
+                        txn.get(cf, ("k" + t + "_" + (perThread - 1)).getBytes(StandardCharsets.UTF_8)));
+                }
+            }
+
+            // A read-only transaction has nothing to sync and must not wait for a batch
+            try (Transaction txn = db.beginTransaction()) {
+                txn.commit();
+            }
+        }
+    }
+    
+    @Test
+    @Order(57)
+    void testAsyncCommitHook() throws TidesDBException {
+        Config config = testConfig("testdb_async_hook").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            List<CommitOp[]> received = Collections.synchronizedList(new ArrayList<>());
+            List<Long> seqs = Collections.synchronizedList(new ArrayList<>());
+            
+            cf.setCommitHook((ops, commitSeq) -> {
+                received.add(ops);
+                seqs.add(commitSeq);
+                return 0;
+            }, 64 * 1024, CommitHookOverflowPolicy.BLOCK);
+            
+            for (int i = 0; i < 100; i++) {
+                try (Transaction txn = db.beginTransaction()) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                    if (i % 10 == 0) {
+                        txn.delete(cf, ("key" + i).getBytes(StandardCharsets.UTF_8));
+                    }
+                    txn.commit();
+                }
+            }
+            
+            // Clearing the hook delivers everything still queued
+            cf.clearCommitHook();
+            
+            assertEquals(100, received.size());
+            assertEquals(0, cf.getCommitHookDroppedCount());
+            for (int i = 1; i < seqs.size(); i++) {
+                assertTrue(seqs.get(i) > seqs.get(i - 1));
+            }
+            
+            assertArrayEquals("key1".getBytes(StandardCharsets.UTF_8), received.get(1)[0].getKey());
+            assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8),
+                received.get(1)[0].getValue());
+            assertFalse(received.get(1)[0].isDelete());
+            
+            CommitOp[] withDelete = received.get(10);
+            assertTrue(withDelete[withDelete.length - 1].isDelete());
+            assertNull(withDelete[withDelete.length - 1].getValue());
+            
+            // A commit larger than the queue cannot be delivered and is counted
+            cf.setCommitHook((ops, commitSeq) -> 0, 64 * 1024, CommitHookOverflowPolicy.DROP);
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, "big".getBytes(StandardCharsets.UTF_8), new byte[128 * 1024]);
+                txn.commit();
+            }
+            assertEquals(1, cf.getCommitHookDroppedCount());
+            cf.clearCommitHook();
+            
+            assertThrows(IllegalArgumentException.class,
+                () -> cf.setCommitHook((ops, commitSeq) -> 0, 0, CommitHookOverflowPolicy.BLOCK));
+            assertThrows(IllegalArgumentException.class,
+                () -> cf.setCommitHook((ops, commitSeq) -> 0, 64 * 1024, null));
+        }
+    }
+    
+    @Test
+    @Order(58)
+    void testBuiltinComparators() throws TidesDBException {
+        Config config = testConfig("testdb_comparators").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("ints", ColumnFamilyConfig.builder()
+                .comparatorName(Comparators.INT64_BE)
+                .build());
+            db.createColumnFamily("series", ColumnFamilyConfig.builder()
+                .comparatorName(Comparators.PREFIX_TS_DESC)
+                .build());
+            
+            ColumnFamily ints = db.getColumnFamily("ints");
+            ColumnFamily series = db.getColumnFamily("series");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (long v : new long[] {3, -5, 0, -1}) {
+                    txn.put(ints, Comparators.int64Key(v), "v".getBytes(StandardCharsets.UTF_8));
+                }
+                // other widths sort by length, around the 8-byte keys
+                txn.put(ints, new byte[] {(byte) 0xFF}, "short".getBytes(StandardCharsets.UTF_8));
+                txn.put(ints, new byte[9], "long".getBytes(StandardCharsets.UTF_8));
+                txn.put(series, Comparators.prefixTimestampKey("a".getBytes(StandardCharsets.UTF_8), 1),
+                    "a1".getBytes(StandardCharsets.UTF_8));
+                txn.put(series, Comparators.prefixTimestampKey("b".getBytes(StandardCharsets.UTF_8), 5),
+                    "b5".getBytes(StandardCharsets.UTF_8));
+                txn.put(series, Comparators.prefixTimestampKey("a".getBytes(StandardCharsets.UTF_8), 3),
+                    "a3".getBytes(StandardCharsets.UTF_8));
+                txn.put(series, Comparators.prefixTimestampKey("a".getBytes(StandardCharsets.UTF_8), 2),
+                    "a2".getBytes(StandardCharsets.UTF_8));
+                txn.commit();
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                List<byte[]> keys = new ArrayList<>();
+                try (TidesDBIterator iter = txn.newIterator(ints)) {
+                    for (iter.seekToFirst(); iter.isValid(); iter.next()) {
+                        keys.add(iter.key());
+                    }
+                }
+                assertEquals(6, keys.size());
+                assertArrayEquals(new byte[] {(byte) 0xFF}, keys.get(0));
+                assertArrayEquals(Comparators.int64Key(-5), keys.get(1));
+                assertArrayEquals(Comparators.int64Key(-1), keys.get(2));
+                assertArrayEquals(Comparators.int64Key(0), keys.get(3));
+                assertArrayEquals(Comparators.int64Key(3), keys.get(4));
+                assertArrayEquals(new byte[9], keys.get(5));
+                
+                // bounds follow the column family's order, not bytewise order
+                keys.clear();
+                try (TidesDBIterator iter = txn.newIterator(ints, Comparators.int64Key(-5),
+                        Comparators.int64Key(0))) {
+                    for (iter.seekToFirst(); iter.isValid(); iter.next()) {
+                        keys.add(iter.key());
+                    }
+                }
+                assertEquals(2, keys.size());
+                assertArrayEquals(Comparators.int64Key(-5), keys.get(0));
+                assertArrayEquals(Comparators.int64Key(-1), keys.get(1));
+                assertThrows(IllegalArgumentException.class,
+                    () -> txn.newPrefixIterator(ints, new byte[] {(byte) 0xFF}));
+                assertThrows(IllegalArgumentException.class,
+                    () -> ints.splitRange(Comparators.int64Key(-5), Comparators.int64Key(3), 2));
+                
+                List<String> values = new ArrayList<>();
+                try (TidesDBIterator iter = txn.newIterator(series)) {
+                    for (iter.seekToFirst(); iter.isValid(); iter.next()) {
+                        values.add(new String(iter.value(), StandardCharsets.UTF_8));
+                    }
+                }
+                assertEquals(List.of("a3", "a2", "a1", "b5"), values);
+            }
+        }
+        
+        // recovered column families keep their comparator
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamily ints = db.getColumnFamily("ints");
+            try (Transaction txn = db.beginTransaction();
+                 TidesDBIterator iter = txn.newIterator(ints)) {
+                iter.seek(Comparators.int64Key(-2));
+                assertArrayEquals(Comparators.int64Key(-1), iter.key());
+            }
+        }
+    }
+    
+    @Test
+    @Order(59)
+    void testBulkLoader() throws Exception {
+        Config config = testConfig("testdb_bulk_load").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            // Records 1000..1999 go to a file, 2000..2999 to a packed buffer
+            ByteBuffer fileRecords = ByteBuffer.allocate(64 * 1024);
+            ByteBuffer packed = ByteBuffer.allocateDirect(64 * 1024);
+            for (int i = 1000; i < 3000; i++) {
+                byte[] key = String.format("key%05d", i).getBytes(StandardCharsets.UTF_8);
+                byte[] value = ("value" + i).getBytes(StandardCharsets.UTF_8);
+                ByteBuffer target = i < 2000 ? fileRecords : packed;
+                target.putInt(key.length).put(key).putInt(value.length).put(value);
+            }
+            fileRecords.flip();
+            packed.flip();
+            Path file = tempDir.resolve("bulk_records.bin");
+            Files.write(file, Arrays.copyOf(fileRecords.array(), fileRecords.limit()));
+            
+            try (BulkLoader loader = db.newBulkLoader(cf, 4 * 1024)) {
+                for (int i = 0; i < 1000; i++) {
+                    loader.add(String.format("key%05d", i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                loader.addFile(file);
+                loader.addPacked(packed);
+                assertEquals(0, packed.position());
+                
+                assertThrows(IllegalArgumentException.class,
+                    () -> loader.add("key00001".getBytes(StandardCharsets.UTF_8),
+                        "x".getBytes(StandardCharsets.UTF_8)));
+                
+                assertEquals(3000, loader.finish());
+                assertThrows(IllegalStateException.class,
+                    () -> loader.add("zzz".getBytes(StandardCharsets.UTF_8),
+                        "x".getBytes(StandardCharsets.UTF_8)));
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 3000; i += 7) {
+                    assertArrayEquals(("value" + i).getBytes(StandardCharsets.UTF_8),
+                        txn.get(cf, String.format("key%05d", i).getBytes(StandardCharsets.UTF_8)));
+                }
+            }
+        }
+    }
+    
+    @Test
+    @Order(60)
+    void testSplitRangeAndParallelScan() throws Exception {
+        Config config = testConfig("testdb_parallel_scan").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 2000; i++) {
+                    txn.put(cf, String.format("key%05d", i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            cf.flushMemtable();
+            Thread.sleep(500);
+            
+            byte[] start = "key00000".getBytes(StandardCharsets.UTF_8);
+            byte[] end = "key99999".getBytes(StandardCharsets.UTF_8);
+            List<byte[]> bounds = cf.splitRange(start, end, 4);
+            assertTrue(bounds.size() >= 2 && bounds.size() <= 5);
+            assertArrayEquals(start, bounds.get(0));
+            assertArrayEquals(end, bounds.get(bounds.size() - 1));
+            for (int i = 1; i < bounds.size(); i++) {
+                assertTrue(Arrays.compareUnsigned(bounds.get(i - 1), bounds.get(i)) < 0);
+            }
+            
+            List<String> seen = Collections.synchronizedList(new ArrayList<>());
+            long scanned = db.parallelScan(cf, start, end, 4,
+                (key, value) -> seen.add(new String(key, StandardCharsets.UTF_8)));
+            assertEquals(2000, scanned);
+            assertEquals(2000, seen.size());
+            assertEquals(2000, seen.stream().distinct().count());
+            
+            assertThrows(IllegalStateException.class, () -> db.parallelScan(cf, start, end, 4,
+                (key, value) -> { throw new IllegalStateException("stop"); }));
+            assertThrows(IllegalArgumentException.class, () -> cf.splitRange(end, start, 2));
+        }
+    }
+    
+    @Test
+    @Order(61)
+    void testMetricsBuffers() throws TidesDBException {
+        Config config = testConfig("testdb_metrics").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            LongBuffer before = Metrics.allocate(Metrics.BINDING_SLOTS);
+            LongBuffer after = Metrics.allocate(Metrics.BINDING_SLOTS);
+            Metrics.fillBinding(before);
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 100; i++) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            
+            int notFoundCode;
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "key1".getBytes(StandardCharsets.UTF_8)));
+                TidesDBException e = assertThrows(TidesDBException.class,
+                    () -> txn.get(cf, "missing".getBytes(StandardCharsets.UTF_8)));
+                notFoundCode = e.getErrorCode();
+            }
+            
+            Metrics.fillBinding(after);
+            assertEquals(0, after.position());
+            assertTrue(after.get(Metrics.BINDING_WRITES) - before.get(Metrics.BINDING_WRITES) >= 100);
+            assertTrue(after.get(Metrics.BINDING_COMMITS) - before.get(Metrics.BINDING_COMMITS) >= 1);
+            assertTrue(after.get(Metrics.BINDING_READS) - before.get(Metrics.BINDING_READS) >= 2);
+            assertTrue(after.get(Metrics.BINDING_BYTES_OUT) - before.get(Metrics.BINDING_BYTES_OUT) >= 6);
+            int slot = Metrics.exceptionSlot(notFoundCode);
+            assertTrue(after.get(slot) - before.get(slot) >= 1);
+            
+            LongBuffer cfMetrics = Metrics.allocate(Metrics.CF_SLOTS);
+            cf.fillMetrics(cfMetrics);
+            assertTrue(cfMetrics.get(Metrics.CF_MEMTABLE_BYTES) > 0
+                || cfMetrics.get(Metrics.CF_TOTAL_KEYS) > 0);
+            
+            LongBuffer dbMetrics = Metrics.allocate(Metrics.DB_SLOTS);
+            db.fillMetrics(dbMetrics);
+            assertEquals(1, dbMetrics.get(Metrics.DB_COLUMN_FAMILIES));
+            
+            assertThrows(IllegalArgumentException.class,
+                () -> cf.fillMetrics(LongBuffer.allocate(Metrics.CF_SLOTS)));
+            assertThrows(IllegalArgumentException.class,
+                () -> db.fillMetrics(Metrics.allocate(Metrics.DB_SLOTS - 1)));
+        }
+    }
+    
+    @Test
+    @Order(62)
+    void testLatencyHistograms() throws TidesDBException {
+        Config config = testConfig("testdb_latency")
+            .latencyTracking(true)
+            .build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            Map<LatencyHistogram.Operation, LatencyHistogram> before = db.getLatencyHistograms();
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 100; i++) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 100; i++) {
+                    txn.get(cf, ("key" + i).getBytes(StandardCharsets.UTF_8));
+                }
+            }
+            
+            Map<LatencyHistogram.Operation, LatencyHistogram> after = db.getLatencyHistograms();
+            assertEquals(LatencyHistogram.Operation.values().length, after.size());
+            assertTrue(after.get(LatencyHistogram.Operation.PUT).getCount()
+                - before.get(LatencyHistogram.Operation.PUT).getCount() >= 100);
+            assertTrue(after.get(LatencyHistogram.Operation.GET).getCount()
+                - before.get(LatencyHistogram.Operation.GET).getCount() >= 100);
+            assertTrue(after.get(LatencyHistogram.Operation.COMMIT).getCount() >= 1);
+            
+            LatencyHistogram gets = after.get(LatencyHistogram.Operation.GET);
+            long p50 = gets.getValueAtPercentile(50);
+            long p99 = gets.getValueAtPercentile(99);
+            assertTrue(p50 > 0);
+            assertTrue(p99 >= p50);
+            assertTrue(gets.getMaxValue() >= p99);
+            
+            assertEquals(7, LatencyHistogram.bucketUpperBound(7));
+            assertEquals(8, LatencyHistogram.bucketUpperBound(8));
+            assertEquals(17, LatencyHistogram.bucketUpperBound(16));
+            
+            boolean tracking = TidesDB.isLatencyTracking();
+            assertTrue(tracking);
+            TidesDB.setLatencyTracking(false);
+            try {
+                try (Transaction txn = db.beginTransaction()) {
+                    txn.get(cf, "key0".getBytes(StandardCharsets.UTF_8));
+                }
+                assertEquals(gets.getCount(),
+                    db.getLatencyHistograms().get(LatencyHistogram.Operation.GET).getCount());
+            } finally {
+                // process-wide, so later tests must not inherit it
+                TidesDB.setLatencyTracking(tracking);
+            }
+        }
+    }
+    
+    @Test
+    @Order(63)
+    void testTransactionPool() throws TidesDBException {
+        Config config = testConfig("testdb_txn_pool").build();
+        
+        TransactionPool leftOpen;
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            try (TransactionPool pool = db.newTransactionPool(2)) {
+                for (int i = 0; i < 50; i++) {
+                    try (Transaction txn = pool.acquire()) {
+                        txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                            ("value" + i).getBytes(StandardCharsets.UTF_8));
+                        txn.commit();
+                    }
+                }
+                assertEquals(1, pool.getIdleCount());
+                
+                // Closed without committing: the write must not leak into the next owner
+                try (Transaction txn = pool.acquire()) {
+                    txn.put(cf, "uncommitted".getBytes(StandardCharsets.UTF_8),
+                        "value".getBytes(StandardCharsets.UTF_8));
+                }
+                try (Transaction txn = pool.acquire()) {
+                    assertThrows(TidesDBException.class, () -> txn.get(cf,
+                        "uncommitted".getBytes(StandardCharsets.UTF_8)));
+                }
+                
+                try (Transaction txn = pool.acquireReadOnly()) {
+                    assertTrue(txn.isReadOnly());
+                    assertArrayEquals("value7".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                        "key7".getBytes(StandardCharsets.UTF_8)));
+                    assertThrows(IllegalStateException.class,
+                        () -> txn.put(cf, "key".getBytes(StandardCharsets.UTF_8),
+                            "value".getBytes(StandardCharsets.UTF_8)));
+                    assertThrows(IllegalStateException.class, () -> txn.delete(cf,
+                        "key7".getBytes(StandardCharsets.UTF_8)));
+                }
+                
+                Transaction first = pool.acquire();
+                Transaction second = pool.acquire();
+                Transaction third = pool.acquire();
+                assertFalse(first.isReadOnly());
+                first.close();
+                second.close();
+                third.close();
+                assertEquals(2, pool.getIdleCount());
+                assertThrows(IllegalStateException.class, () -> first.get(cf,
+                    "key1".getBytes(StandardCharsets.UTF_8)));
+                
+                // A stale reference stays closed after its handle is handed out again
+                try (Transaction reused = pool.acquire()) {
+                    assertNotSame(second, reused);
+                    assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), reused.get(cf,
+                        "key1".getBytes(StandardCharsets.UTF_8)));
+                    assertThrows(IllegalStateException.class, () -> second.get(cf,
+                        "key1".getBytes(StandardCharsets.UTF_8)));
+                    second.close();
+                    assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), reused.get(cf,
+                        "key1".getBytes(StandardCharsets.UTF_8)));
+                }
+            }
+            
+            leftOpen = db.newTransactionPool(1);
+            leftOpen.acquire().close();
+            assertEquals(1, leftOpen.getIdleCount());
+        }
+        
+        // Closing the database drained the pool; closing it afterwards frees nothing
+        assertEquals(0, leftOpen.getIdleCount());
+        leftOpen.close();
+        assertThrows(IllegalStateException.class, leftOpen::acquire);
+    }
+    
+    @Test
+    @Order(64)
+    void testSnapshot() throws Exception {
+        Config config = testConfig("testdb_snapshot").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 10; i++) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        "old".getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            
+            try (Snapshot snapshot = db.getSnapshot()) {
+                try (Transaction txn = db.beginTransaction()) {
+                    for (int i = 0; i < 10; i++) {
+                        txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                            "new".getBytes(StandardCharsets.UTF_8));
+                    }
+                    txn.put(cf, "key10".getBytes(StandardCharsets.UTF_8),
+                        "new".getBytes(StandardCharsets.UTF_8));
+                    txn.commit();
+                }
+                
+                assertArrayEquals("old".getBytes(StandardCharsets.UTF_8), snapshot.get(cf,
+                    "key3".getBytes(StandardCharsets.UTF_8)));
+                assertThrows(TidesDBException.class, () -> snapshot.get(cf,
+                    "key10".getBytes(StandardCharsets.UTF_8)));
+                
+                byte[][] values = snapshot.multiGet(cf,
+                    new byte[][] {"key0".getBytes(StandardCharsets.UTF_8),
+                    "key10".getBytes(StandardCharsets.UTF_8)});
+                assertArrayEquals("old".getBytes(StandardCharsets.UTF_8), values[0]);
+                assertNull(values[1]);
+                
+                ExecutorService executor = Executors.newFixedThreadPool(4);
+                try {
+                    List<Future<Integer>> futures = new ArrayList<>();
+                    for (int t = 0; t < 4; t++) {
+                        futures.add(executor.submit(() -> {
+                            int old = 0;
+                            for (int i = 0; i < 10; i++) {
+                                if (Arrays.equals("old".getBytes(StandardCharsets.UTF_8),
+                                    snapshot.get(cf, ("key" + i).getBytes(StandardCharsets.UTF_8)))) {
+                                    old++;
+                                }
+                            }
+                            return old;
+                        }));
+                    }
+                    for (Future<Integer> future : futures) {
+                        assertEquals(10, future.get());
+                    }
+                } finally {
+                    executor.shutdown();
+                }
+                
+                int count = 0;
+                try (TidesDBIterator iter = snapshot.newIterator(cf)) {
+                    iter.seekToFirst();
+                    while (iter.isValid()) {
+                        assertArrayEquals("old".getBytes(StandardCharsets.UTF_8), iter.value());
+                        count++;
+                        iter.next();
+                    }
+                }
+                assertEquals(10, count);
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("new".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "key3".getBytes(StandardCharsets.UTF_8)));
+            }
+        }
+    }
+    
+    @Test
+    @Order(65)
+    void testNativeScopeAndLeakDetection() throws Exception {
+        Config config = testConfig("testdb_native_scope").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            assertSame(cf, db.getColumnFamily("test_cf"));
+            
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, "key1".getBytes(StandardCharsets.UTF_8),
+                    "value1".getBytes(StandardCharsets.UTF_8));
+                txn.commit();
+            }
+            
+            Transaction txn;
+            TidesDBIterator first;
+            TidesDBIterator second;
+            try (NativeScope scope = new NativeScope()) {
+                txn = scope.register(db.beginTransaction());
+                first = scope.register(txn.newIterator(cf));
+                second = scope.register(txn.newIterator(cf));
+                first.seekToFirst();
+                assertTrue(first.isValid());
+                second.close();
+            }
+            assertThrows(IllegalStateException.class, first::seekToFirst);
+            assertThrows(IllegalStateException.class, () -> txn.get(cf,
+                "key1".getBytes(StandardCharsets.UTF_8)));
+            
+            long leakedBefore = TidesDB.getLeakedHandleCount();
+            leakTransactions(db, cf, 16);
+            long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(10);
+            while (TidesDB.getLeakedHandleCount() < leakedBefore + 16 && System.nanoTime() < deadline) {
+                System.gc();
+                Thread.sleep(50);
+            }
+            assertTrue(TidesDB.getLeakedHandleCount() >= leakedBefore + 16);
+        }
+        
+        // handles still open when the database closes are freed with it
+        Transaction open;
+        TidesDBIterator openIter;
+        try (TidesDB db = TidesDB.open(config)) {
+            open = db.beginTransaction();
+            openIter = open.newIterator(db.getColumnFamily("test_cf"));
+        }
+        assertFalse(openIter.isValid());
+        assertThrows(IllegalStateException.class, openIter::seekToFirst);
+        assertThrows(IllegalStateException.class, open::commit);
+        openIter.close();
+        open.close();
+    }
+    
+    private static void leakTransactions(TidesDB db, ColumnFamily cf, int count) throws TidesDBException {
+        for (int i = 0; i < count; i++) {
+            Transaction txn = db.beginTransaction();
+            txn.newIterator(cf);
+        }
+    }
+    
+    @Test
+    @Order(66)
+    void testS3ConfigValidation() {
+        S3Config s3 = S3Config.builder("localhost:9000", "tidesdb")
+            .prefix("db1/")
+            .credentials("minio", "minio123")
+            .useSsl(false)
+            .usePathStyle(true)
+            .build();
+        assertEquals("localhost:9000", s3.getEndpoint());
+        assertEquals("tidesdb", s3.getBucket());
+        assertEquals("us-east-1", s3.getRegion());
+        assertFalse(s3.isUseSsl());
+        assertTrue(s3.isUsePathStyle());
+        assertFalse(s3.toString().contains("minio123"));
+        
+        assertThrows(IllegalArgumentException.class, () -> S3Config.builder("", "bucket").build());
+        assertThrows(IllegalArgumentException.class, () -> S3Config.builder("host", null).build());
+        assertThrows(IllegalArgumentException.class,
+            () -> S3Config.builder("host", "bucket").credentials("key", null).build());
+        
+        assertThrows(IllegalArgumentException.class, () ->
+            Config.builder(tempDir.resolve("testdb_s3").toString())
+                .objectStoreFsPath(tempDir.resolve("objstore").toString())
+                .objectStoreS3(s3)
+                .build());
+        
+        Config config = Config.builder(tempDir.resolve("testdb_s3").toString())
+            .objectStoreS3(s3)
+            .objectStoreConfig(ObjectStoreConfig.builder().localCacheMaxBytes(64 * 1024 * 1024).build())
+            .build();
+        assertSame(s3, config.getObjectStoreS3());
+    }
+    
+    @Test
+    @Order(67)
+    void testReplicaReader() throws TidesDBException {
+        Config config = testConfig("testdb_replica_reader").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, "key1".getBytes(StandardCharsets.UTF_8),
+                    "value1".getBytes(StandardCharsets.UTF_8));
+                txn.commit();
+            }
+            
+            // The database stands in for its own primary, so it is always caught up
+            AtomicLong primary = new AtomicLong(db.getDbStats().getGlobalSeq());
+            try (ReplicaReader reader = db.newReplicaReader(primary::get, 1)) {
+                assertEquals(0, reader.getLag());
+                assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), reader.get(cf,
+                    "key1".getBytes(StandardCharsets.UTF_8), 0,
+                    ReplicaReader.StalePolicy.FAIL, 0, TimeUnit.MILLISECONDS));
+                
+                primary.addAndGet(1000);
+                assertTrue(reader.getLag() >= 1000);
+                ReplicaLagException failed = assertThrows(ReplicaLagException.class, () ->
+                    reader.get(cf, "key1".getBytes(StandardCharsets.UTF_8), 10,
+                        ReplicaReader.StalePolicy.FAIL, 0, TimeUnit.MILLISECONDS));
+                assertTrue(failed.getLag() >= 1000);
+                assertThrows(ReplicaLagException.class, () ->
+                    reader.get(cf, "key1".getBytes(StandardCharsets.UTF_8), 10,
+                        ReplicaReader.StalePolicy.WAIT, 20, TimeUnit.MILLISECONDS));
+                
+                assertArrayEquals("value1".getBytes(StandardCharsets.UTF_8), reader.get(cf,
+                    "key1".getBytes(StandardCharsets.UTF_8), 2000,
+                    ReplicaReader.StalePolicy.FAIL, 0, TimeUnit.MILLISECONDS));
+            }
+        }
+    }
+    
+    @Test
+    @Order(68)
+    void testCacheStatsInterval() {
+        CacheStats baseline = new CacheStats(true, 10, 4096, 100, 50, 100.0 / 150, 8);
+        CacheStats later = new CacheStats(true, 12, 8192, 190, 60, 190.0 / 250, 8);
+        
+        CacheStats interval = later.since(baseline);
+        assertEquals(90, interval.getHits());
+        assertEquals(10, interval.getMisses());
+        assertEquals(0.9, interval.getHitRate(), 1e-9);
+        assertEquals(12, interval.getTotalEntries());
+        assertEquals(8192, interval.getTotalBytes());
+        
+        assertEquals(0.0, later.since(later).getHitRate());
+        assertThrows(IllegalArgumentException.class, () -> later.since(null));
+    }
+    
+    @Test
+    @Order(69)
+    void testEventListener() throws Exception {
+        Config config = testConfig("testdb_events").build();
+        
+        List<Event> events = Collections.synchronizedList(new ArrayList<>());
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            db.createColumnFamily("drop_me", cfConfig);
+            
+            assertThrows(IllegalArgumentException.class, () -> db.setEventListener(null, 10));
+            assertThrows(IllegalArgumentException.class, () -> db.setEventListener(events::add, 0));
+            
+            db.setEventListener(events::add, 1);
+            
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            byte[] value = new byte[1024];
+            // the monitor samples, so a very short flush can slip between two samples;
+            // keep flushing until both ends of one have been seen
+            long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(30);
+            int batch = 0;
+            while (batch < 4 || !hasEvent(events, EventType.FLUSH_BEGIN, "test_cf")
+                    || !hasEvent(events, EventType.FLUSH_END, "test_cf")) {
+                assertTrue(System.nanoTime() - deadline < 0,
+                    () -> "no flush begin and end for test_cf within 30s, got " + events);
+                putEventBatch(db, cf, batch++, value);
+                cf.flushMemtable();
+                for (int wait = 0; wait < 20 && !hasEvent(events, EventType.FLUSH_END, "test_cf");
+                        wait++) {
+                    Thread.sleep(10);
+                }
+            }
+            
+            // dropping while the monitor runs must not race its sampling
+            db.dropColumnFamily("drop_me");
+            Thread.sleep(50);
+            
+            db.clearEventListener();
+            int delivered = events.size();
+            putEventBatch(db, cf, batch++, value);
+            cf.flushMemtable();
+            Thread.sleep(50);
+            assertEquals(delivered, events.size(), "event delivered after clearEventListener");
+            
+            synchronized (events) {
+                for (Event event : events) {
+                    assertNotNull(event.getType());
+                    assertTrue(event.getValue() >= 0 || event.getType() == EventType.MEMORY_PRESSURE);
+                    if (event.getType() == EventType.FLUSH_END || event.getType() == EventType.COMPACTION_END) {
+                        assertNotNull(event.getColumnFamily());
+                        assertTrue(event.getDurationUs() >= 0);
+                    }
+                }
+            }
+            
+            // left running on purpose: close must stop it
+            db.setEventListener(events::add, 5);
+            putEventBatch(db, cf, batch, value);
+            cf.flushMemtable();
+        }
+        int delivered = events.size();
+        Thread.sleep(50);
+        assertEquals(delivered, events.size(), "event delivered after close");
+    }
+    
+    private static void putEventBatch(TidesDB db, ColumnFamily cf, int batch, byte[] value)
+            throws TidesDBException {
+        try (Transaction txn = db.beginTransaction()) {
+            for (int i = 0; i < 1000; i++) {
+                txn.put(cf, ("key" + batch + "_" + i).getBytes(StandardCharsets.UTF_8), value);
+            }
+            txn.commit();
+        }
+    }
+    
+    private static boolean hasEvent(List<Event> events, EventType type, String cf) {
+        synchronized (events) {
+            for (Event event : events) {
+                if (event.getType() == type && cf.equals(event.getColumnFamily())) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    @Test
+    @Order(70)
+    void testCompactionScheduler() throws Exception {
+        Config config = testConfig("testdb_compaction_scheduler")
+            .latencyTracking(true)
+            .build();
+        
+        CompactionTask abandoned;
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            for (int batch = 0; batch < 4; batch++) {
+                try (Transaction txn = db.beginTransaction()) {
+                    for (int i = 0; i < 500; i++) {
+                        txn.put(cf, String.format("key%05d", batch * 500 + i).getBytes(StandardCharsets.UTF_8),
+                            new byte[256]);
+                    }
+                    txn.commit();
+                }
+                cf.flushMemtable();
+            }
+            
+            assertThrows(IllegalArgumentException.class, () -> CompactionScheduler.builder(db).slicesPerTask(0).build());
+            assertThrows(IllegalArgumentException.class, () -> CompactionScheduler.builder(db).bytesPerSecond(-1).build());
+            
+            try (CompactionScheduler scheduler = CompactionScheduler.builder(db)
+                    .bytesPerSecond(64L * 1024 * 1024)
+                    .foregroundP99Target(50, TimeUnit.MILLISECONDS)
+                    .slicesPerTask(4)
+                    .build()) {
+                assertThrows(IllegalArgumentException.class, () -> scheduler.submit(null, 0));
+                
+                scheduler.pause();
+                assertTrue(scheduler.isPaused());
+                CompactionTask whole = scheduler.submit(cf, 0);
+                CompactionTask range = scheduler.submit(cf,
+                    "key00100".getBytes(StandardCharsets.UTF_8),
+                    "key01500".getBytes(StandardCharsets.UTF_8), 10);
+                CompactionTask dropped = scheduler.submit(cf, 5);
+                assertTrue(dropped.cancel());
+                assertEquals(CompactionTask.State.CANCELLED, dropped.getState());
+                Thread.sleep(200);
+                assertEquals(0, whole.getCompletedSlices());
+                assertEquals(0, range.getCompletedSlices());
+                
+                scheduler.resume();
+                range.toFuture().get(30, TimeUnit.SECONDS);
+                whole.toFuture().get(30, TimeUnit.SECONDS);
+                assertEquals(CompactionTask.State.DONE, range.getState());
+                assertEquals(CompactionTask.State.DONE, whole.getState());
+                assertEquals(1.0, whole.getProgress());
+                assertTrue(whole.getTotalSlices() >= 1);
+                assertTrue(whole.getTotalSlices() <= 4);
+            }
+            
+            // a window that excludes now keeps the task from starting; close cancels it
+            LocalTime later = LocalTime.now().plusHours(1);
+            CompactionTask waiting;
+            try (CompactionScheduler scheduler = CompactionScheduler.builder(db)
+                    .window(later, later.plusHours(1))
+                    .build()) {
+                waiting = scheduler.submit(cf, 0);
+                Thread.sleep(200);
+                assertEquals(0, waiting.getCompletedSlices());
+                assertThrows(IllegalArgumentException.class, () -> CompactionScheduler.builder(db).window(null, later));
+            }
+            assertEquals(CompactionTask.State.CANCELLED, waiting.getState());
+            assertTrue(waiting.toFuture().isCancelled());
+            
+            try (Transaction txn = db.beginTransaction();
+                 TidesDBIterator iter = txn.newIterator(cf)) {
+                int count = 0;
+                for (iter.seekToFirst(); iter.isValid(); iter.next()) {
+                    count++;
+                }
+                assertEquals(2000, count);
+            }
+            
+            CompactionScheduler leftOpen = CompactionScheduler.builder(db)
+                .window(later, later.plusHours(1))
+                .build();
+            abandoned = leftOpen.submit(cf, 0);
+        }
+        
+        // Closing the database stopped the scheduler that was left running
+        assertEquals(CompactionTask.State.CANCELLED, abandoned.getState());
+    }
+    
+    @Test
+    @Order(71)
+    void testIncrementalBackup() throws Exception {
+        Config config = testConfig("testdb_incremental_backup").build();
+        
+        String fullDir = tempDir.resolve("testdb_incremental_backup_full").toString();
+        String incrDir = tempDir.resolve("testdb_incremental_backup_incr").toString();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 1000; i++) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            cf.flushMemtable();
+            
+            assertThrows(IllegalArgumentException.class, () -> BackupOptions.builder().parallelism(0).build());
+            assertThrows(IllegalArgumentException.class, () -> db.backup(fullDir, null));
+            
+            AtomicLong lastBytes = new AtomicLong(-1);
+            List<Integer> files = Collections.synchronizedList(new ArrayList<>());
+            BackupResult full = db.backup(fullDir, BackupOptions.builder()
+                .parallelism(2)
+                .bytesPerSecond(64L * 1024 * 1024)
+                .progressListener((bytesDone, bytesTotal, filesDone, filesTotal) -> {
+                    assertTrue(bytesDone <= bytesTotal);
+                    assertTrue(bytesDone >= lastBytes.get());
+                    lastBytes.set(bytesDone);
+                    files.add(filesDone);
+                    assertTrue(filesDone <= filesTotal);
+                })
+                .build());
+            assertEquals(0, full.getFilesLinked());
+            assertTrue(full.getFilesCopied() > 0);
+            assertEquals(full.getFilesCopied(), files.size());
+            assertTrue(Files.exists(Paths.get(fullDir, "BACKUP_MANIFEST")));
+            
+            // the target must be empty
+            assertThrows(TidesDBException.class, () -> db.backup(fullDir, BackupOptions.defaultOptions()));
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 1000; i < 1100; i++) {
+                    txn.put(cf, ("key" + i).getBytes(StandardCharsets.UTF_8),
+                        ("value" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            cf.flushMemtable();
+            
+            BackupResult incr = db.backup(incrDir, BackupOptions.builder().since(fullDir).build());
+            assertTrue(incr.getFilesLinked() > 0, incr.toString());
+            assertTrue(incr.getFilesCopied() > 0, incr.toString());
+            
+            // a directory without a manifest is not a usable base
+            assertThrows(TidesDBException.class, () -> db.backup(
+                tempDir.resolve("testdb_incremental_backup_bad").toString(),
+                BackupOptions.builder().since(tempDir.toString()).build()));
+        }
+        
+        Config restoreConfig = configAt(incrDir).build();
+        
+        try (TidesDB restored = TidesDB.open(restoreConfig)) {
+            ColumnFamily cf = restored.getColumnFamily("test_cf");
+            try (Transaction txn = restored.beginTransaction()) {
+                for (int i = 0; i < 1100; i += 50) {
+                    assertArrayEquals(("value" + i).getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                        ("key" + i).getBytes(StandardCharsets.UTF_8)));
+                }
+            }
+        }
+    }
+    
+    @Test
+    @Order(72)
+    void testExpiryTracking() throws Exception {
+        Config config = testConfig("testdb_expiry_tracking").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamilyConfig cfConfig = ColumnFamilyConfig.defaultConfig();
+            db.createColumnFamily("test_cf", cfConfig);
+            ColumnFamily cf = db.getColumnFamily("test_cf");
+            
+            assertThrows(IllegalArgumentException.class, () -> cf.enableExpiryTracking(0, 10));
+            assertThrows(IllegalArgumentException.class, () -> cf.enableExpiryTracking(1.5, 10));
+            assertThrows(IllegalArgumentException.class, () -> cf.enableExpiryTracking(0.5, -1));
+            
+            AtomicLong hooked = new AtomicLong();
+            cf.setCommitHook((ops, seq) -> {
+                hooked.addAndGet(ops.length);
+                return 0;
+            });
+            cf.enableExpiryTracking(0.3, 10);
+            assertTrue(cf.isExpiryTracking());
+            
+            long expiresAt = System.currentTimeMillis() / 1000 + 2;
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < 100; i++) {
+                    txn.put(cf, ("session" + i).getBytes(StandardCharsets.UTF_8),
+                        ("data" + i).getBytes(StandardCharsets.UTF_8), expiresAt);
+                    txn.put(cf, ("user" + i).getBytes(StandardCharsets.UTF_8),
+                        ("data" + i).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.commit();
+            }
+            cf.flushMemtable();
+            assertEquals(200, hooked.get());
+            
+            Stats stats = cf.getStats();
+            assertEquals(100, stats.getExpiryTrackedKeys());
+            assertEquals(0, stats.getExpiredKeys());
+            
+            // clearing the user hook leaves tracking installed
+            cf.clearCommitHook();
+            assertTrue(cf.isExpiryTracking());
+            
+            long deadline = System.currentTimeMillis() + 15_000;
+            while (cf.getStats().getExpirySweeps() == 0 && System.currentTimeMillis() < deadline) {
+                Thread.sleep(100);
+            }
+            stats = cf.getStats();
+            assertTrue(stats.getExpirySweeps() >= 1, stats.toString());
+            assertEquals(0, stats.getExpiryTrackedKeys());
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertThrows(TidesDBException.class, () -> txn.get(cf,
+                    "session0".getBytes(StandardCharsets.UTF_8)));
+                assertArrayEquals("data0".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "user0".getBytes(StandardCharsets.UTF_8)));
+            }
+            
+            cf.disableExpiryTracking();
+            assertFalse(cf.isExpiryTracking());
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, "late".getBytes(StandardCharsets.UTF_8),
+                    "x".getBytes(StandardCharsets.UTF_8), expiresAt + 60);
+                txn.commit();
+            }
+            assertEquals(0, cf.getStats().getExpiryTrackedKeys());
+            
+            // left enabled on purpose: close must release the index
+            cf.enableExpiryTracking(0.5, 1);
+        }
+    }
+    
+    @Test
+    @Order(73)
+    void testFixedWidthKeys() throws TidesDBException {
+        Config config = testConfig("testdb_fixed_keys").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("longs", ColumnFamilyConfig.builder()
+                .comparatorName(Comparators.UINT64_BE)
+                .build());
+            db.createColumnFamily("uuids", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily longs = db.getColumnFamily("longs");
+            ColumnFamily uuids = db.getColumnFamily("uuids");
+            
+            UUID first = new UUID(1, 2);
+            UUID second = new UUID(1, 3);
+            try (Transaction txn = db.beginTransaction()) {
+                for (long k = 0; k < 100; k += 2) {
+                    txn.put(longs, k, ("v" + k).getBytes(StandardCharsets.UTF_8));
+                }
+                txn.put(uuids, second, "second".getBytes(StandardCharsets.UTF_8));
+                txn.put(uuids, first, "first".getBytes(StandardCharsets.UTF_8), -1);
+                txn.commit();
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("v10".getBytes(StandardCharsets.UTF_8), txn.get(longs, 10L));
+                // same encoding as the byte[] API
+                assertArrayEquals("v10".getBytes(StandardCharsets.UTF_8), txn.get(longs,
+                    Comparators.int64Key(10)));
+                assertThrows(TidesDBException.class, () -> txn.get(longs, 11L));
+                
+                byte[][] values = txn.multiGet(longs, new long[] {4, 5, 98});
+                assertArrayEquals("v4".getBytes(StandardCharsets.UTF_8), values[0]);
+                assertNull(values[1]);
+                assertArrayEquals("v98".getBytes(StandardCharsets.UTF_8), values[2]);
+                assertEquals(0, txn.multiGet(longs, new long[0]).length);
+                assertThrows(IllegalArgumentException.class, () -> txn.multiGet(longs, (long[]) null));
+                
+                assertArrayEquals("first".getBytes(StandardCharsets.UTF_8), txn.get(uuids, first));
+                assertThrows(IllegalArgumentException.class, () -> txn.get(uuids, (UUID) null));
+                
+                txn.delete(longs, 10L);
+                txn.delete(uuids, second);
+                txn.commit();
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertThrows(TidesDBException.class, () -> txn.get(longs, 10L));
+                assertThrows(TidesDBException.class, () -> txn.get(uuids, second));
+                
+                try (TidesDBIterator iter = txn.newIterator(longs)) {
+                    iter.seek(9L);
+                    assertTrue(iter.isValid());
+                    assertArrayEquals(Comparators.int64Key(12), iter.key());
+                    iter.seekForPrev(9L);
+                    assertTrue(iter.isValid());
+                    assertArrayEquals(Comparators.int64Key(8), iter.key());
+                }
+                try (TidesDBIterator iter = txn.newIterator(uuids)) {
+                    iter.seek(new UUID(1, 0));
+                    assertTrue(iter.isValid());
+                    assertArrayEquals("first".getBytes(StandardCharsets.UTF_8), iter.value());
+                    iter.seekForPrev(new UUID(2, 0));
+                    assertTrue(iter.isValid());
+                    assertArrayEquals("first".getBytes(StandardCharsets.UTF_8), iter.value());
+                }
+            }
+        }
+    }
+    
+    @Test
+    @Order(74)
+    void testValueCodec() throws TidesDBException {
+        Config config = testConfig("testdb_value_codec").build();
+        
+        List<byte[]> samples = new ArrayList<>();
+        for (int i = 0; i < 2000; i++) {
+            samples.add(("{\"id\":" + i + ",\"user\":\"user_" + (i % 97) + "\",\"status\":\""
+                + (i % 3 == 0 ? "active" : "suspended") + "\",\"region\":\"eu-west-" + (i % 4)
+                + "\",\"score\":" + (i * 37 % 1000) + "}").getBytes(StandardCharsets.UTF_8));
+        }
+        byte[] value = samples.get(1234);
+        int dictId;
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("docs", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("docs");
+            assertNull(cf.getValueCodec());
+            
+            ValueCodec codec = cf.trainValueCodec(samples, 16 * 1024, ValueCodec.DEFAULT_LEVEL);
+            assertSame(codec, cf.getValueCodec());
+            dictId = codec.getDictionaryId();
+            assertNotEquals(0, dictId);
+            
+            byte[] encoded = codec.encode(value);
+            assertTrue(encoded.length < value.length,
+                "encoded " + encoded.length + " of " + value.length);
+            assertArrayEquals(value, codec.decode(encoded));
+            assertArrayEquals(new byte[0], codec.decode(codec.encode(new byte[0])));
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (int i = 0; i < samples.size(); i++) {
+                    txn.put(cf, ("doc" + i).getBytes(StandardCharsets.UTF_8),
+                        codec.encode(samples.get(i)));
+                }
+                txn.commit();
+            }
+            assertTrue(cf.getStats().getValueCompressionRatio() > 1.0);
+            
+            assertThrows(TidesDBException.class, () -> codec.decode(new byte[] {7, 1, 2}));
+            assertThrows(IllegalArgumentException.class, () -> codec.encode(null));
+            assertThrows(IllegalArgumentException.class,
+                () -> cf.trainValueCodec(Collections.emptyList(), 1024, 3));
+        }
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            ColumnFamily cf = db.getColumnFamily("docs");
+            ValueCodec codec = cf.getValueCodec();
+            assertNotNull(codec);
+            assertEquals(dictId, codec.getDictionaryId());
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals(value, codec.decode(txn.get(cf,
+                    "doc1234".getBytes(StandardCharsets.UTF_8))));
+            }
+            
+            // retraining keeps the old dictionary readable
+            List<byte[]> other = new ArrayList<>();
+            for (int i = 0; i < 2000; i++) {
+                other.add(("<event seq=\"" + i + "\" kind=\"click\" page=\"/p/" + (i % 50)
+                    + "\" ms=\"" + (i * 13 % 900) + "\"/>").getBytes(StandardCharsets.UTF_8));
+            }
+            cf.trainValueCodec(other, 16 * 1024, 5);
+            assertNotEquals(dictId, codec.getDictionaryId());
+            assertEquals(2, codec.getDictionaryCount());
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals(value, codec.decode(txn.get(cf,
+                    "doc1234".getBytes(StandardCharsets.UTF_8))));
+            }
+            assertArrayEquals(other.get(7), codec.decode(codec.encode(other.get(7))));
+        }
+    }
+    
+    @Test
+    @Order(75)
+    void testDeleteRange() throws TidesDBException {
+        Config config = testConfig("testdb_delete_range").build();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("tenants", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("tenants");
+            
+            try (Transaction txn = db.beginTransaction()) {
+                for (String tenant : new String[] {"a", "b", "c"}) {
+                    for (int i = 0; i < 3000; i++) {
+                        txn.put(cf, String.format("%s/%05d", tenant, i).getBytes(StandardCharsets.UTF_8),
+                            "v".getBytes(StandardCharsets.UTF_8));
+                    }
+                }
+                txn.commit();
+            }
+            cf.flushMemtable();
+            
+            // more than one native batch, and a key straddling the end bound
+            try (Transaction txn = db.beginTransaction()) {
+                assertEquals(3000, txn.deleteRange(cf, "b/".getBytes(StandardCharsets.UTF_8),
+                    "b0".getBytes(StandardCharsets.UTF_8)));
+                txn.commit();
+            }
+            cf.compactRange("b/".getBytes(StandardCharsets.UTF_8),
+                "b0".getBytes(StandardCharsets.UTF_8));
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertThrows(TidesDBException.class, () -> txn.get(cf,
+                    "b/00000".getBytes(StandardCharsets.UTF_8)));
+                assertThrows(TidesDBException.class, () -> txn.get(cf,
+                    "b/02999".getBytes(StandardCharsets.UTF_8)));
+                assertArrayEquals("v".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "a/02999".getBytes(StandardCharsets.UTF_8)));
+                assertArrayEquals("v".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "c/00000".getBytes(StandardCharsets.UTF_8)));
+                
+                try (TidesDBIterator iter = txn.newIterator(cf)) {
+                    iter.seek("a/02999".getBytes(StandardCharsets.UTF_8));
+                    iter.next();
+                    assertArrayEquals("c/00000".getBytes(StandardCharsets.UTF_8), iter.key());
+                }
+                
+                // nothing in range, and an empty range
+                assertEquals(0, txn.deleteRange(cf, "b/".getBytes(StandardCharsets.UTF_8),
+                    "b0".getBytes(StandardCharsets.UTF_8)));
+                assertEquals(0, txn.deleteRange(cf, "c/".getBytes(StandardCharsets.UTF_8),
+                    "a/".getBytes(StandardCharsets.UTF_8)));
+                
+                // unbounded start, rolled back
+                assertEquals(3000, txn.deleteRange(cf, null, "b".getBytes(StandardCharsets.UTF_8)));
+                assertThrows(TidesDBException.class, () -> txn.get(cf,
+                    "a/00000".getBytes(StandardCharsets.UTF_8)));
+                txn.rollback();
+            }
+            
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("v".getBytes(StandardCharsets.UTF_8), txn.get(cf,
+                    "a/00000".getBytes(StandardCharsets.UTF_8)));
+                assertEquals(6000, txn.deleteRange(cf, null, new byte[0]));
+                assertThrows(IllegalArgumentException.class, () -> txn.deleteRange(null, null, null));
+                txn.commit();
+            }
+            
+            try (Transaction txn = db.beginTransaction();
+                 TidesDBIterator iter = txn.newIterator(cf)) {
+                iter.seekToFirst();
+                assertFalse(iter.isValid());
+            }
+            
+            // signed keys: bytewise, every non-negative key would sort below -1
+            db.createColumnFamily("ints", ColumnFamilyConfig.builder()
+                .comparatorName(Comparators.INT64_BE)
+                .build());
+            ColumnFamily ints = db.getColumnFamily("ints");
+            try (Transaction txn = db.beginTransaction()) {
+                for (long k = -5; k < 25000; k++) {
+                    if (k != -1) {
+                        txn.put(ints, Comparators.int64Key(k),
+                            "v".getBytes(StandardCharsets.UTF_8));
+                    }
+                }
+                txn.commit();
+            }
+            try (Transaction txn = db.beginTransaction()) {
+                assertEquals(4, txn.deleteRange(ints, Comparators.int64Key(-5),
+                    Comparators.int64Key(-1)));
+                txn.commit();
+            }
+            try (Transaction txn = db.beginTransaction()) {
+                assertThrows(TidesDBException.class, () -> txn.get(ints, -2L));
+                assertArrayEquals("v".getBytes(StandardCharsets.UTF_8), txn.get(ints, 0L));
+            }
+            
+            // chunked, non-atomic variant across several commits
+            assertEquals(24999, db.deleteRange(ints, Comparators.int64Key(1), null));
+            try (Transaction txn = db.beginTransaction()) {
+                assertArrayEquals("v".getBytes(StandardCharsets.UTF_8), txn.get(ints, 0L));
+                assertThrows(TidesDBException.class, () -> txn.get(ints, 1L));
+                assertThrows(TidesDBException.class, () -> txn.get(ints, 24999L));
+            }
+            assertEquals(0, db.deleteRange(ints, Comparators.int64Key(1), null));
+        }
+    }
+    
+    @Test
+    @Order(76)
+    void testValueCodecRestore() throws Exception {
+        Config config = testConfig("testdb_value_codec_restore").build();
+        
+        List<byte[]> samples = new ArrayList<>();
+        for (int i = 0; i < 2000; i++) {
+            samples.add(("{\"id\":" + i + ",\"user\":\"user_" + (i % 97) + "\",\"status\":\""
+                + (i % 3 == 0 ? "active" : "suspended") + "\"}").getBytes(StandardCharsets.UTF_8));
+        }
+        byte[] key = "doc7".getBytes(StandardCharsets.UTF_8);
+        String checkpointDir = tempDir.resolve("testdb_value_codec_checkpoint").toString();
+        String backupDir = tempDir.resolve("testdb_value_codec_backup").toString();
+        String asyncDir = tempDir.resolve("testdb_value_codec_backup_async").toString();
+        
+        try (TidesDB db = TidesDB.open(config)) {
+            db.createColumnFamily("docs", ColumnFamilyConfig.defaultConfig());
+            ColumnFamily cf = db.getColumnFamily("docs");
+            ValueCodec codec = cf.trainValueCodec(samples, 16 * 1024, ValueCodec.DEFAULT_LEVEL);
+            try (Transaction txn = db.beginTransaction()) {
+                txn.put(cf, key, codec.encode(samples.get(7)));
+                txn.commit();
+            }
+            cf.flushMemtable();
+            
+            db.cloneColumnFamily("docs", "docs_copy");
+            ValueCodec cloned = db.getColumnFamily("docs_copy").getValueCodec();
+            assertNotNull(cloned);
+            assertEquals(codec.getDictionaryId(), cloned.getDictionaryId());
+            
+            db.checkpoint(checkpointDir);
+            db.backup(backupDir, BackupOptions.defaultOptions());
+            db.backupAsync(asyncDir).get();
+        }
+        
+        for (String dir : new String[] {checkpointDir, backupDir, asyncDir}) {
+            Config restored = configAt(dir).build();
+            try (TidesDB db = TidesDB.open(restored)) {
+                ColumnFamily cf = db.getColumnFamily("docs");
+                ValueCodec codec = cf.getValueCodec();
+                assertNotNull(codec, dir);
+                try (Transaction txn = db.beginTransaction()) {
+                    assertArrayEquals(samples.get(7), codec.decode(txn.get(cf, key)), dir);
+                }
+            }
+        }
+    }
+    
+    @Test
+    @Order(77)
+    void testAsyncContinuationDuringClose() throws Exception {
+        Config config = testConfig("testdb_async_close")
+            .asyncThreads(1)
+            .build();
+        
+        TidesDB db = TidesDB.open(config);
+        db.createColumnFamily("test_cf", ColumnFamilyConfig.defaultConfig());
+        ColumnFamily cf = db.getColumnFamily("test_cf");
+        
+        byte[][] keys = new byte[2000][];
+        try (Transaction txn = db.beginTransaction()) {
+            for (int i = 0; i < keys.length; i++) {
+                keys[i] = ("key" + i).getBytes(StandardCharsets.UTF_8);
+                txn.put(cf, keys[i], ("value" + i).getBytes(StandardCharsets.UTF_8));
+            }
+            txn.commit();
+        }
+        
+        // A non-async stage runs on the pool's only worker and submits again while close()
+        // is joining that worker; the second submission must fail instead of blocking
+        Transaction txn = db.beginTransaction();
+        Thread caller = Thread.currentThread();
+        CountDownLatch onWorker = new CountDownLatch(1);
+        CountDownLatch closing = new CountDownLatch(1);
+        AtomicBoolean ranOnWorker = new AtomicBoolean();
+        CompletableFuture<byte[]> chained = txn.multiGetAsync(cf, keys).thenCompose(values -> {
+            ranOnWorker.set(Thread.currentThread() != caller);
+            onWorker.countDown();
+            try {
+                closing.await(10, TimeUnit.SECONDS);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+            return txn.getAsync(cf, keys[0]);
+        });
+        assertTrue(onWorker.await(10, TimeUnit.SECONDS));
+        assertTrue(ranOnWorker.get());
+        
+        Thread closer = new Thread(db::close);
+        closer.start();
+        Thread.sleep(100);
+        closing.countDown();
+        closer.join(10_000);
+        assertFalse(closer.isAlive(), "close() deadlocked on a continuation running on a worker");
+        
+        // Depending on timing the second get either ran or was refused, but it has finished
+        try {
+            chained.get(10, TimeUnit.SECONDS);
+        } catch (ExecutionException e) {
+            assertTrue(e.getCause() instanceof TidesDBException
+                || e.getCause() instanceof IllegalStateException);
+        }
+    }
 }